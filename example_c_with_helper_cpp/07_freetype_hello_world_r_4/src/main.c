@@ -37,6 +37,14 @@ typedef struct {
     VkImageView textureView; // Texture view
 } RenderObject;
 
+#define MAX_RETIRED_OBJECTS 16 // Destroyed objects waiting on in-flight frames
+
+// Render object destroyed while a submitted frame may still be drawing it
+typedef struct {
+    RenderObject object;    // Handles to free once retireFrame has completed
+    uint64_t retireFrame;   // Last frame submitted before the object was destroyed
+} RetiredObject;
+
 // Vulkan context holding all necessary resources
 struct VulkanContext {
     VkInstance instance;
@@ -70,6 +78,11 @@ struct VulkanContext {
     RenderObject text;
     uint32_t graphicsQueueFamilyIndex;
     VkSampler textureSampler;
+    uint64_t frameNumber;          // Frames submitted so far
+    uint64_t completedFrameNumber; // Frames whose inFlightFence has signaled
+    RetiredObject retired[MAX_RETIRED_OBJECTS];
+    uint32_t retiredCount;
+    bool textDescriptorStale;      // Binding 1 still points at a retired text texture
 } vkCtx = {0};
 
 // Uniform buffer object for shaders
@@ -123,6 +136,56 @@ void update_uniform_buffer(Camera* cam, float rotationAngle) {
     vmaUnmapMemory(allocator, vkCtx.uniformAllocation);
 }
 
+/**
+ * Frees the buffer, image and view of a render object, skipping null handles
+ * @param object Render object whose handles are released
+ */
+void free_render_object(RenderObject* object) {
+    if (object->textureView) vkDestroyImageView(vkCtx.device, object->textureView, NULL);
+    if (object->texture) vmaDestroyImage(allocator, object->texture, object->texAlloc);
+    if (object->buffer) vmaDestroyBuffer(allocator, object->buffer, object->allocation);
+}
+
+/**
+ * Frees retired objects whose last frame has completed on the GPU
+ * @param all Free every retired object regardless of frame (after vkDeviceWaitIdle)
+ */
+void collect_retired_objects(bool all) {
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < vkCtx.retiredCount; i++) {
+        if (all || vkCtx.retired[i].retireFrame <= vkCtx.completedFrameNumber) {
+            free_render_object(&vkCtx.retired[i].object);
+        } else {
+            vkCtx.retired[kept++] = vkCtx.retired[i];
+        }
+    }
+    vkCtx.retiredCount = kept;
+}
+
+/**
+ * Queues a render object's resources for destruction once the frames that may draw it
+ * have completed, instead of stalling the GPU with vkDeviceWaitIdle
+ * @param object Render object to retire; its handles are cleared
+ */
+void retire_render_object(RenderObject* object) {
+    if (vkCtx.retiredCount == MAX_RETIRED_OBJECTS) {
+        // Queue full: fall back to draining the GPU rather than growing it
+        vkDeviceWaitIdle(vkCtx.device);
+        collect_retired_objects(true);
+    }
+    vkCtx.retired[vkCtx.retiredCount].object = *object;
+    vkCtx.retired[vkCtx.retiredCount].retireFrame = vkCtx.frameNumber;
+    vkCtx.retiredCount++;
+
+    object->buffer = VK_NULL_HANDLE;
+    object->allocation = VK_NULL_HANDLE;
+    object->texture = VK_NULL_HANDLE;
+    object->texAlloc = VK_NULL_HANDLE;
+    object->textureView = VK_NULL_HANDLE;
+    object->vertexCount = 0;
+    object->exists = false;
+}
+
 /**
  * Creates a simple colored triangle
  */
@@ -170,13 +233,8 @@ void destroy_triangle() {
         return;
     }
 
-    vkDeviceWaitIdle(vkCtx.device);
-    vmaDestroyBuffer(allocator, vkCtx.triangle.buffer, vkCtx.triangle.allocation);
-    vkCtx.triangle.buffer = VK_NULL_HANDLE;
-    vkCtx.triangle.allocation = VK_NULL_HANDLE;
-    vkCtx.triangle.vertexCount = 0;
-    vkCtx.triangle.exists = false;
-    printf("Triangle destroyed with VMA\n");
+    retire_render_object(&vkCtx.triangle);
+    printf("Triangle retired\n");
 }
 
 /**
@@ -241,13 +299,8 @@ void destroy_cube() {
         return;
     }
 
-    vkDeviceWaitIdle(vkCtx.device);
-    vmaDestroyBuffer(allocator, vkCtx.cube.buffer, vkCtx.cube.allocation);
-    vkCtx.cube.buffer = VK_NULL_HANDLE;
-    vkCtx.cube.allocation = VK_NULL_HANDLE;
-    vkCtx.cube.vertexCount = 0;
-    vkCtx.cube.exists = false;
-    printf("Cube destroyed with VMA\n");
+    retire_render_object(&vkCtx.cube);
+    printf("Cube retired\n");
 }
 
 /**
@@ -455,6 +508,7 @@ void create_text() {
     descriptorWrite.pImageInfo = &textDescriptorImageInfo;
 
     vkUpdateDescriptorSets(vkCtx.device, 1, &descriptorWrite, 0, NULL);
+    vkCtx.textDescriptorStale = false;
 
     // Define plane vertices: Position (x,y,z), Color (r,g,b), UV (u,v), TexFlag
     float baseline_v = (float)baseline_y / atlas_height; // UV coordinate of the baseline
@@ -494,20 +548,9 @@ void create_text() {
 }
 
 /**
- * Destroys the text object and resets descriptor to dummy texture
+ * Points binding 1 back at the dummy texture
  */
-void destroy_text() {
-    if (!vkCtx.text.exists) {
-        printf("Text does not exist, skipping destruction\n");
-        return;
-    }
-
-    vkDeviceWaitIdle(vkCtx.device);
-    vkDestroyImageView(vkCtx.device, vkCtx.text.textureView, NULL);
-    vmaDestroyImage(allocator, vkCtx.text.texture, vkCtx.text.texAlloc);
-    vmaDestroyBuffer(allocator, vkCtx.text.buffer, vkCtx.text.allocation);
-
-    // Reset descriptor to dummy texture
+void reset_text_descriptor() {
     VkDescriptorImageInfo dummyDescriptorImageInfo = {};
     dummyDescriptorImageInfo.sampler = vkCtx.textureSampler;
     dummyDescriptorImageInfo.imageView = dummyTextureView;
@@ -522,15 +565,22 @@ void destroy_text() {
     descriptorWrite.pImageInfo = &dummyDescriptorImageInfo;
 
     vkUpdateDescriptorSets(vkCtx.device, 1, &descriptorWrite, 0, NULL);
+    vkCtx.textDescriptorStale = false;
+}
+
+/**
+ * Retires the text object; the descriptor is reset to the dummy texture after the
+ * in-flight frame completes, since that frame may still be sampling the old view
+ */
+void destroy_text() {
+    if (!vkCtx.text.exists) {
+        printf("Text does not exist, skipping destruction\n");
+        return;
+    }
 
-    vkCtx.text.buffer = VK_NULL_HANDLE;
-    vkCtx.text.allocation = VK_NULL_HANDLE;
-    vkCtx.text.texture = VK_NULL_HANDLE;
-    vkCtx.text.texAlloc = VK_NULL_HANDLE;
-    vkCtx.text.textureView = VK_NULL_HANDLE;
-    vkCtx.text.vertexCount = 0;
-    vkCtx.text.exists = false;
-    printf("Text destroyed with VMA\n");
+    retire_render_object(&vkCtx.text);
+    vkCtx.textDescriptorStale = true;
+    printf("Text retired\n");
 }
 
 /**
@@ -1278,6 +1328,9 @@ int main(int argc, char* argv[]) {
 
         vkWaitForFences(vkCtx.device, 1, &vkCtx.inFlightFence, VK_TRUE, UINT64_MAX);
         vkResetFences(vkCtx.device, 1, &vkCtx.inFlightFence);
+        vkCtx.completedFrameNumber = vkCtx.frameNumber;
+        if (vkCtx.textDescriptorStale) reset_text_descriptor();
+        collect_retired_objects(false);
 
         uint32_t imageIndex;
         VkResult result = vkAcquireNextImageKHR(vkCtx.device, vkCtx.swapchain, UINT64_MAX, vkCtx.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
@@ -1305,6 +1358,7 @@ int main(int argc, char* argv[]) {
             fprintf(stderr, "Failed to submit draw command buffer\n");
             exit(1);
         }
+        vkCtx.frameNumber++;
 
         VkPresentInfoKHR presentInfo = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
         presentInfo.waitSemaphoreCount = 1;
@@ -1324,6 +1378,7 @@ int main(int argc, char* argv[]) {
     if (vkCtx.triangle.exists) destroy_triangle();
     if (vkCtx.cube.exists) destroy_cube();
     if (vkCtx.text.exists) destroy_text();
+    collect_retired_objects(true);
     vkDestroySemaphore(vkCtx.device, vkCtx.renderFinishedSemaphore, NULL);
     vkDestroySemaphore(vkCtx.device, vkCtx.imageAvailableSemaphore, NULL);
     vkDestroyFence(vkCtx.device, vkCtx.inFlightFence, NULL);
@@ -1,17 +1,39 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
-layout(location = 2) in float fragTexFlag;
 
 layout(location = 0) out vec4 outColor;
 
-layout(binding = 1) uniform sampler2D textSampler;
+// Bindless texture table (vsdl_bindless.h). The index comes from a push constant,
+// so it is uniform across the draw and needs no nonuniformEXT.
+layout(binding = 1) uniform texture2D textures[];
+layout(binding = 2) uniform sampler textureSampler;
+
+layout(push_constant) uniform TexturePushConstants {
+    uint textureIndex;
+} pc;
+
+// Feature bits baked into each pipeline variant (VSDL_SHADER_* in vsdl_render.h).
+// The branches below fold away at pipeline creation, so no variant pays for
+// another's path.
+layout(constant_id = 0) const uint FEATURES = 0u;
+const uint FEATURE_TEXTURED = 1u;
+const uint FEATURE_SDF = 2u;
 
 void main() {
-    if (fragTexFlag > 0.5) {
-        float alpha = texture(textSampler, fragTexCoord).r;
-        outColor = vec4(1.0, 1.0, 1.0, alpha); // White text with alpha
-    } else {
+    if ((FEATURES & FEATURE_TEXTURED) == 0u) {
         outColor = vec4(fragColor, 1.0);
+        return;
+    }
+
+    float texel = texture(sampler2D(textures[pc.textureIndex], textureSampler), fragTexCoord).r;
+    if ((FEATURES & FEATURE_SDF) != 0u) {
+        // Signed distance field: 0.5 is the outline, antialiased over about one screen pixel
+        float smoothing = fwidth(texel);
+        float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, texel);
+        outColor = vec4(fragColor, alpha);
+    } else {
+        outColor = vec4(fragColor, texel); // Text tinted by vertex color
     }
 }
\ No newline at end of file
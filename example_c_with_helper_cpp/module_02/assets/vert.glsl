@@ -2,7 +2,6 @@
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
 layout(location = 2) in vec2 inTexCoord;
-layout(location = 3) in float inTexFlag;
 
 layout(binding = 0) uniform UniformBufferObject {
     mat4 model;
@@ -10,13 +9,17 @@ layout(binding = 0) uniform UniformBufferObject {
     mat4 proj;
 } ubo;
 
+// Per-draw translation (DrawPushConstants in vsdl_record.h). It starts at byte 16,
+// after the fragment stage's TexturePushConstants, so the two ranges never overlap.
+layout(push_constant) uniform DrawPushConstants {
+    layout(offset = 16) vec4 offset;
+} draw;
+
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
-layout(location = 2) out float fragTexFlag;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view * (ubo.model * vec4(inPosition, 1.0) + vec4(draw.offset.xyz, 0.0));
     fragColor = inColor;
     fragTexCoord = inTexCoord;
-    fragTexFlag = inTexFlag;
 }
\ No newline at end of file
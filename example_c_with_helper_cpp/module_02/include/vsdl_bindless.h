@@ -0,0 +1,28 @@
+#ifndef VSDL_BINDLESS_H
+#define VSDL_BINDLESS_H
+
+#include "vsdl_types.h"
+
+// Set 0 of frag.glsl: binding 1 is a runtime array of sampled images created
+// partially bound and update-after-bind, binding 2 the sampler shared by all of them
+#define VSDL_BINDLESS_TEXTURE_BINDING 1
+#define VSDL_BINDLESS_SAMPLER_BINDING 2
+#define VSDL_BINDLESS_MAX_TEXTURES 16384 // Upper bound; lowered to the device's update-after-bind limits
+
+// frag.glsl push_constant block: the table slot a draw samples
+typedef struct {
+    uint32_t textureIndex;
+} TexturePushConstants;
+
+// Sizes the table from the device limits; call before vsdl_load_shaders
+void vsdl_bindless_init(VulkanContext* vkCtx);
+void vsdl_bindless_destroy(VulkanContext* vkCtx);
+// Writes the view into a free slot of vkCtx->descriptorSet and returns the slot.
+// The set may be bound by frames still in flight; they never read a new slot.
+uint32_t vsdl_bindless_add_texture(VulkanContext* vkCtx, VkImageView view);
+// The slot is reused once the frames that may sample it have completed
+void vsdl_bindless_remove_texture(VulkanContext* vkCtx, uint32_t index);
+// Called by the deletion queue
+void vsdl_bindless_free_slot(VulkanContext* vkCtx, uint32_t index);
+
+#endif
\ No newline at end of file
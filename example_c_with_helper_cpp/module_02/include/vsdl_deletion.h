@@ -0,0 +1,19 @@
+#ifndef VSDL_DELETION_H
+#define VSDL_DELETION_H
+
+#include "vsdl_types.h"
+
+// Each retire call stamps the resource with vkCtx->frameNumber, the last frame
+// submitted that may still reference it. vsdl_deletion_collect frees it once
+// vkCtx->completedFrameNumber has caught up, so destroy paths never wait on the GPU.
+void vsdl_retire_buffer(VulkanContext* vkCtx, VkBuffer buffer, VmaAllocation allocation);
+void vsdl_retire_image(VulkanContext* vkCtx, VkImage image, VmaAllocation allocation);
+void vsdl_retire_image_view(VulkanContext* vkCtx, VkImageView view);
+// Returns a bindless texture slot to the free list
+void vsdl_retire_texture_slot(VulkanContext* vkCtx, uint32_t index);
+// Frees everything retired at or before vkCtx->completedFrameNumber
+void vsdl_deletion_collect(VulkanContext* vkCtx);
+// Frees everything regardless of frame; only after vkDeviceWaitIdle
+void vsdl_deletion_flush(VulkanContext* vkCtx);
+
+#endif
\ No newline at end of file
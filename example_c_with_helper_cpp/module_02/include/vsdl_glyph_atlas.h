@@ -0,0 +1,14 @@
+#ifndef VSDL_GLYPH_ATLAS_H
+#define VSDL_GLYPH_ATLAS_H
+
+#include "vsdl_types.h"
+
+#define VSDL_GLYPH_ATLAS_SIZE 1024
+
+void vsdl_glyph_atlas_create(VulkanContext* vkCtx, uint32_t width, uint32_t height);
+void vsdl_glyph_atlas_destroy(VulkanContext* vkCtx);
+// Records copies of the cache's dirty rectangles into the atlas image and
+// advances the LRU clock. Call once per frame, outside the render pass.
+void vsdl_glyph_atlas_record_upload(VulkanContext* vkCtx, VkCommandBuffer commandBuffer);
+
+#endif
\ No newline at end of file
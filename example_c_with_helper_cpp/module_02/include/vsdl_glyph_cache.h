@@ -0,0 +1,83 @@
+#ifndef VSDL_GLYPH_CACHE_H
+#define VSDL_GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#define VSDL_GLYPH_CACHE_MAX_GLYPHS 2048
+#define VSDL_GLYPH_CACHE_MAX_SHELVES 256
+#define VSDL_GLYPH_CACHE_MAX_DIRTY 64
+#define VSDL_GLYPH_PADDING 1 // Empty texels around each glyph so linear filtering never bleeds
+#define VSDL_GLYPH_SDF_SPREAD 6 // Distance in pixels covered by SDF glyphs on each side of the outline
+
+typedef struct {
+    uint32_t faceId;     // Caller-assigned id of the FT_Face
+    uint32_t pixelSize;
+    uint32_t glyphIndex; // FT glyph index, not a character code
+    uint32_t renderMode; // FT_Render_Mode: coverage and distance fields never share an entry
+} GlyphKey;
+
+typedef struct {
+    GlyphKey key;
+    uint16_t x, y;          // Top-left of the bitmap in the atlas
+    uint16_t width, height;
+    int16_t bearingX;       // FreeType bitmap_left
+    int16_t bearingY;       // FreeType bitmap_top
+    float advance;          // Horizontal advance in pixels
+    uint64_t lastUsed;      // Frame of the last lookup, for LRU eviction
+    int32_t next;           // Next entry in the hash chain or free list, -1 terminates
+    int32_t shelf;          // -1 for glyphs without a bitmap (spaces)
+    bool used;
+} GlyphEntry;
+
+// A horizontal strip of the atlas; glyphs are appended left to right
+typedef struct {
+    uint16_t y, height;
+    uint16_t cursorX;
+    uint64_t lastUsed; // Most recent lastUsed of any glyph on the shelf
+} GlyphShelf;
+
+typedef struct {
+    uint16_t x, y, width, height;
+} GlyphRect;
+
+// CPU side of the glyph atlas: an R8 pixel store packed with shelves and a
+// hash of (face, size, glyph index) -> entry. Full atlases evict the least
+// recently used shelf. Newly written rectangles are queued as dirty so the
+// GPU copy (vsdl_glyph_atlas.c) only uploads what changed.
+typedef struct {
+    uint8_t* pixels;
+    uint32_t width, height;
+    GlyphEntry entries[VSDL_GLYPH_CACHE_MAX_GLYPHS];
+    int32_t buckets[VSDL_GLYPH_CACHE_MAX_GLYPHS * 2]; // Heads of hash chains
+    int32_t freeList;
+    uint32_t glyphCount;
+    GlyphShelf shelves[VSDL_GLYPH_CACHE_MAX_SHELVES];
+    uint32_t shelfCount;
+    uint32_t nextShelfY;
+    GlyphRect dirty[VSDL_GLYPH_CACHE_MAX_DIRTY];
+    uint32_t dirtyCount;
+    uint64_t frame;
+    // Statistics
+    uint64_t hits, misses, evictions;
+} GlyphCache;
+
+void vsdl_glyph_cache_init(GlyphCache* cache, uint32_t width, uint32_t height);
+void vsdl_glyph_cache_destroy(GlyphCache* cache);
+// Advances the LRU clock; glyphs looked up in the current frame are never evicted
+void vsdl_glyph_cache_begin_frame(GlyphCache* cache);
+// Returns the cached glyph and marks it used, or NULL on a miss
+const GlyphEntry* vsdl_glyph_cache_find(GlyphCache* cache, GlyphKey key);
+// Packs an 8-bit coverage or distance bitmap (pitch in bytes) and records it as dirty.
+// Returns NULL if the glyph does not fit even after evicting unused shelves.
+const GlyphEntry* vsdl_glyph_cache_insert(GlyphCache* cache, GlyphKey key, const uint8_t* bitmap, uint32_t width,
+                                          uint32_t height, int32_t pitch, int32_t bearingX, int32_t bearingY, float advance);
+// Lookup that rasterizes and inserts the glyph with FreeType on a miss.
+// FT_RENDER_MODE_SDF bitmaps include the renderer's spread on every side.
+const GlyphEntry* vsdl_glyph_cache_get(GlyphCache* cache, FT_Face face, uint32_t faceId, uint32_t pixelSize,
+                                       uint32_t glyphIndex, FT_Render_Mode renderMode);
+void vsdl_glyph_cache_clear_dirty(GlyphCache* cache);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef VSDL_GLYPH_RASTER_H
+#define VSDL_GLYPH_RASTER_H
+
+#include "vsdl_glyph_cache.h"
+#include "vsdl_jobs.h"
+
+#define VSDL_GLYPH_RASTER_CHUNK 16 // Glyphs per job
+
+typedef struct {
+    uint32_t codepoint;
+    uint32_t glyphIndex;
+    uint16_t width, height;
+    int16_t bearingX, bearingY;
+    float advance;
+    uint8_t* pixels; // Tightly packed rows, NULL for empty glyphs
+    bool ok;         // False when the font has no glyph or rasterization failed
+} RasterizedGlyph;
+
+// FreeType faces are not thread-safe, so every worker gets its own
+// FT_Library and FT_Face for the same font file
+typedef struct {
+    JobSystem* jobs;
+    FT_Library libraries[VSDL_JOBS_MAX_WORKERS];
+    FT_Face faces[VSDL_JOBS_MAX_WORKERS];
+    uint32_t pixelSize;
+    FT_Render_Mode renderMode;
+} GlyphRasterPool;
+
+void vsdl_glyph_raster_init(GlyphRasterPool* pool, JobSystem* jobs, const char* fontPath, uint32_t pixelSize,
+                            FT_Render_Mode renderMode);
+void vsdl_glyph_raster_destroy(GlyphRasterPool* pool);
+// Rasterizes codepoints across the job system; out[i] holds codepoints[i]
+void vsdl_glyph_raster_run(GlyphRasterPool* pool, const uint32_t* codepoints, uint32_t count, RasterizedGlyph* out);
+// Hands the bitmaps to the (single-threaded) atlas packer, skipping glyphs
+// already cached. Returns the number of glyphs inserted.
+uint32_t vsdl_glyph_raster_insert(const GlyphRasterPool* pool, GlyphCache* cache, uint32_t faceId,
+                                  const RasterizedGlyph* glyphs, uint32_t count);
+void vsdl_glyph_raster_free(RasterizedGlyph* glyphs, uint32_t count);
+
+#endif
\ No newline at end of file
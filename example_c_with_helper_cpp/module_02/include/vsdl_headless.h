@@ -0,0 +1,25 @@
+#ifndef VSDL_HEADLESS_H
+#define VSDL_HEADLESS_H
+
+#include "vsdl_types.h"
+
+#define VSDL_HEADLESS_IMAGES 3                // Images in the offscreen ring (--headless-images)
+#define VSDL_HEADLESS_FRAMES 240              // Frames rendered when --frames is not given
+#define VSDL_GOLDEN_TOLERANCE 2               // Per-channel difference still counted as a match
+#define VSDL_GOLDEN_MAX_DIFF_FRACTION 0.001   // Pixels allowed past the tolerance
+
+// Creates imageCount offscreen color images and views in place of a swapchain,
+// plus a persistently mapped readback buffer when readback is set
+void vsdl_headless_init(VulkanContext* vkCtx, uint32_t imageCount, bool readback);
+// Destroys the images, their views and the readback buffer
+void vsdl_headless_destroy(VulkanContext* vkCtx);
+// Stands in for vkAcquireNextImageKHR: the next image of the ring
+uint32_t vsdl_headless_acquire(VulkanContext* vkCtx);
+// Copies image imageIndex (left in TRANSFER_SRC_OPTIMAL by the render pass)
+// into the readback buffer, then writes it to readbackPath as a PPM and/or
+// compares it with the PPM at goldenPath. Either path may be NULL.
+// Call once the device is idle; returns false on failure or mismatch.
+bool vsdl_headless_readback(VulkanContext* vkCtx, uint32_t imageIndex, const char* readbackPath,
+                            const char* goldenPath, uint32_t tolerance);
+
+#endif
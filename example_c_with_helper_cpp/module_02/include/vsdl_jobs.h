@@ -0,0 +1,56 @@
+#ifndef VSDL_JOBS_H
+#define VSDL_JOBS_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define VSDL_JOBS_MAX_WORKERS 32
+#define VSDL_JOBS_QUEUE_SIZE 4096 // Jobs per worker deque, power of two
+
+// workerIndex is stable per thread (0 is the thread that owns the system), so
+// jobs can index per-worker state such as FreeType faces without locking
+typedef void (*JobFunc)(void* data, uint32_t workerIndex);
+
+typedef struct {
+    JobFunc func;
+    void* data;
+    SDL_AtomicInt* counter; // Decremented when the job has run
+} Job;
+
+// Owner pushes and pops at the bottom (newest first); thieves take from the top
+typedef struct {
+    Job jobs[VSDL_JOBS_QUEUE_SIZE];
+    uint32_t top, bottom;
+    SDL_SpinLock lock;
+} JobQueue;
+
+typedef struct {
+    struct JobSystem* system;
+    uint32_t index;
+} JobWorker;
+
+// Small work-stealing job system: one deque per worker, idle workers steal
+// from the others and sleep on a condition variable when nothing is queued
+typedef struct JobSystem {
+    uint32_t workerCount; // Including the owning thread as worker 0
+    JobQueue* queues;
+    SDL_Thread* threads[VSDL_JOBS_MAX_WORKERS];
+    JobWorker workers[VSDL_JOBS_MAX_WORKERS];
+    SDL_AtomicInt pending;   // Queued jobs not yet taken
+    SDL_AtomicInt nextQueue; // Round-robin submit target
+    SDL_AtomicInt quit;
+    SDL_Mutex* sleepMutex;
+    SDL_Condition* wake;
+} JobSystem;
+
+// workerCount 0 uses every logical core
+void vsdl_jobs_init(JobSystem* jobs, uint32_t workerCount);
+void vsdl_jobs_shutdown(JobSystem* jobs);
+// Call from worker 0. counter (may be NULL) is incremented before the job is
+// queued; if every deque is full the job runs inline instead.
+void vsdl_jobs_submit(JobSystem* jobs, JobFunc func, void* data, SDL_AtomicInt* counter);
+// Runs queued jobs on the calling thread (worker 0) until counter reaches zero
+void vsdl_jobs_wait(JobSystem* jobs, SDL_AtomicInt* counter);
+
+#endif
\ No newline at end of file
@@ -4,9 +4,41 @@
 #include <stdbool.h>
 #include <stdarg.h>
 
+#define VSDL_LOG_LEVEL_TRACE 0
+#define VSDL_LOG_LEVEL_DEBUG 1
+#define VSDL_LOG_LEVEL_INFO  2
+#define VSDL_LOG_LEVEL_WARN  3
+#define VSDL_LOG_LEVEL_ERROR 4
+
+// Calls below this level compile to nothing; per-frame tracing is free in release builds
+#ifndef VSDL_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define VSDL_LOG_COMPILE_LEVEL VSDL_LOG_LEVEL_INFO
+#else
+#define VSDL_LOG_COMPILE_LEVEL VSDL_LOG_LEVEL_TRACE
+#endif
+#endif
+
+#if VSDL_LOG_COMPILE_LEVEL <= VSDL_LOG_LEVEL_TRACE
+#define VSDL_TRACE(...) vsdl_log_write(VSDL_LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define VSDL_TRACE(...) ((void)0)
+#endif
+#if VSDL_LOG_COMPILE_LEVEL <= VSDL_LOG_LEVEL_DEBUG
+#define VSDL_DEBUG(...) vsdl_log_write(VSDL_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define VSDL_DEBUG(...) ((void)0)
+#endif
+#define VSDL_INFO(...) vsdl_log_write(VSDL_LOG_LEVEL_INFO, __VA_ARGS__)
+#define VSDL_WARN(...) vsdl_log_write(VSDL_LOG_LEVEL_WARN, __VA_ARGS__)
+#define VSDL_ERROR(...) vsdl_log_write(VSDL_LOG_LEVEL_ERROR, __VA_ARGS__)
+
 void vsdl_init_log(const char* filename, bool enableFileOutput);
-void vsdl_log(const char* format, ...);
-void vsdl_cleanup_log(void);
+// Formats into a lock-free ring; a background thread writes stdout and the log file
+void vsdl_log_write(int level, const char* format, ...);
+void vsdl_log(const char* format, ...); // Same as VSDL_INFO
+void vsdl_log_set_level(int level);     // Runtime filter on top of VSDL_LOG_COMPILE_LEVEL
+void vsdl_cleanup_log(void);            // Drains pending messages; also runs at exit()
 void vsdl_toggle_log_file(bool enable);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef VSDL_PIPELINE_CACHE_H
+#define VSDL_PIPELINE_CACHE_H
+
+#include "vsdl_types.h"
+
+#define VSDL_PIPELINE_CACHE_FILE "pipeline_cache.bin"
+
+// Creates vkCtx->pipelineCache, seeded from path when its header matches this device
+void vsdl_pipeline_cache_load(VulkanContext* vkCtx, const char* path);
+// Writes the cache to path via a temporary file and an atomic rename, then
+// destroys it. The write is skipped unless a pipeline was created since
+// loading and the data grew.
+void vsdl_pipeline_cache_save_and_destroy(VulkanContext* vkCtx, const char* path);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef VSDL_RECORD_H
+#define VSDL_RECORD_H
+
+#include "vsdl_types.h"
+#include "vsdl_jobs.h"
+#include <cglm/cglm.h>
+
+#define VSDL_RECORD_MIN_DRAWS 256 // Fewer draws than this per chunk cost more in job overhead than they save
+
+// vert.glsl push_constant block. It starts after the fragment stage's
+// TexturePushConstants, so each stage owns a disjoint range of the layout.
+#define VSDL_DRAW_PUSH_CONSTANT_OFFSET 16
+typedef struct {
+    float offset[4]; // World-space translation added after the model matrix; w unused
+} DrawPushConstants;
+
+// Creates one command pool per job worker. With a single worker everything is
+// recorded inline into the primary command buffer instead.
+void vsdl_record_init(VulkanContext* vkCtx, JobSystem* jobs);
+void vsdl_record_destroy(VulkanContext* vkCtx);
+// Resets every worker pool and empties the draw list; call once inFlightFence has signaled
+void vsdl_record_begin_frame(VulkanContext* vkCtx);
+void vsdl_draw_list_add(VulkanContext* vkCtx, const RenderObject* object, vec3 offset);
+bool vsdl_record_uses_secondaries(const VulkanContext* vkCtx);
+// Records draws [first, first + count) of the draw list into a command buffer
+// inside the render pass
+void vsdl_record_draws(const VulkanContext* vkCtx, VkCommandBuffer commandBuffer, VkPipeline pipeline,
+                       uint32_t first, uint32_t count);
+// Splits the draw list across the job workers, each recording secondary command
+// buffers from its own pool, plus one for text on the calling thread. Fills
+// recorder.secondaries in draw list order and returns how many there are.
+uint32_t vsdl_record_secondaries(VulkanContext* vkCtx, uint32_t imageIndex);
+
+#endif
\ No newline at end of file
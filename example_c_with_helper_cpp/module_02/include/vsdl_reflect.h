@@ -0,0 +1,75 @@
+#ifndef VSDL_REFLECT_H
+#define VSDL_REFLECT_H
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define VSDL_REFLECT_CACHE_FILE "reflection_cache.bin"
+#define VSDL_REFLECT_CACHE_MAX 32 // Shaders kept in memory and on disk
+#define VSDL_REFLECT_MAX_INPUTS 16
+#define VSDL_REFLECT_MAX_BINDINGS 16
+#define VSDL_REFLECT_MAX_SPEC_CONSTANTS 8
+
+typedef struct {
+    uint32_t location;
+    VkFormat format; // 32-bit format matching the shader type; packed data goes through overrides
+} ReflectedInput;
+
+typedef struct {
+    uint32_t set;
+    uint32_t binding;
+    VkDescriptorType type;
+    uint32_t count; // Array size, 0 for a runtime-sized array
+} ReflectedBinding;
+
+typedef struct {
+    uint32_t id;   // constant_id
+    uint32_t size; // Bytes in VkSpecializationInfo data
+} ReflectedSpecConstant;
+
+// Everything pipeline creation needs from one SPIR-V module. Plain data so a
+// whole entry is written to the reflection cache as is.
+typedef struct {
+    uint64_t hash; // vsdl_hash_fnv1a of the SPIR-V
+    VkShaderStageFlagBits stage;
+    uint32_t inputCount; // Vertex stage only, sorted by location
+    ReflectedInput inputs[VSDL_REFLECT_MAX_INPUTS];
+    uint32_t bindingCount;
+    ReflectedBinding bindings[VSDL_REFLECT_MAX_BINDINGS];
+    uint32_t pushConstantOffset;
+    uint32_t pushConstantSize; // 0: no push constant block
+    uint32_t specConstantCount;
+    ReflectedSpecConstant specConstants[VSDL_REFLECT_MAX_SPEC_CONSTANTS];
+} ShaderReflection;
+
+#define VSDL_HASH_FNV1A_SEED 14695981039346656037ull
+uint64_t vsdl_hash_fnv1a(uint64_t hash, const void* data, size_t size);
+
+// Reads cached reflections; entries for SPIR-V that is no longer loaded are dropped on save
+void vsdl_reflect_cache_load(const char* path);
+// Writes the entries used this run, only when something was reflected anew
+void vsdl_reflect_cache_save(const char* path);
+
+// Returns the reflection of a SPIR-V module, from the cache when its hash is
+// known and through SPIRV-Cross otherwise. The pointer stays valid for the run.
+const ShaderReflection* vsdl_reflect_shader(const void* code, size_t size, VkShaderStageFlagBits stage);
+
+// Fills attributes in location order with tightly packed offsets. overrides[location]
+// replaces the reflected format (e.g. VK_FORMAT_R8G8B8A8_UNORM feeding a vec4)
+// unless it is VK_FORMAT_UNDEFINED; pass NULL for none. Returns the attribute count.
+uint32_t vsdl_reflect_vertex_layout(const ShaderReflection* vert, const VkFormat* overrides, uint32_t overrideCount,
+                                    VkVertexInputAttributeDescription* attributes, uint32_t* stride);
+// Creates the layout of one descriptor set, merging the stages that use each binding.
+// Runtime-sized arrays get runtimeArraySize descriptors, partially bound and
+// update-after-bind (the pool needs VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+// with runtimeArraySize 0 they are an error.
+VkDescriptorSetLayout vsdl_reflect_create_set_layout(VkDevice device, const ShaderReflection* const* shaders,
+                                                     uint32_t shaderCount, uint32_t set, uint32_t runtimeArraySize);
+// One range per stage with a push constant block; returns the range count
+uint32_t vsdl_reflect_push_constant_ranges(const ShaderReflection* const* shaders, uint32_t shaderCount,
+                                           VkPushConstantRange* ranges);
+const ReflectedSpecConstant* vsdl_reflect_find_spec_constant(const ShaderReflection* shader, uint32_t id);
+uint32_t vsdl_format_size(VkFormat format);
+
+#endif
\ No newline at end of file
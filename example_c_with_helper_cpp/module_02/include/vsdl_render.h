@@ -4,8 +4,26 @@
 #include <vulkan/vulkan.h>
 #include "vsdl_types.h" // Use vsdl_types.h for VulkanContext instead of vsdl_vulkan_init.h
 
+// Fragment shader feature bits, passed as specialization constant 0
+#define VSDL_SHADER_TEXTURED (1u << 0) // Alpha from the R8 atlas texel
+#define VSDL_SHADER_SDF      (1u << 1) // With TEXTURED: the texel is a signed distance
+
+#define VSDL_SHADER_FEATURE_MASK 0xFFu
+
+// Not a shader feature: the variant reads PackedVertex (vsdl_vertex_pack.h)
+// instead of 8 floats. Masked out of the specialization constant.
+#define VSDL_PIPELINE_PACKED_VERTICES (1u << 8)
+
+#define VSDL_SHADER_FEATURES_CONSTANT_ID 0
+
+// Loads vert.spv and frag.spv, reflects them and creates the shader modules
+// and vkCtx->descriptorSetLayout from the reflected bindings of set 0. The
+// texture array is sized by vsdl_bindless_init, which must run first.
+void vsdl_load_shaders(VulkanContext* vkCtx);
 void vsdl_create_pipeline(VulkanContext* vkCtx);
+// Returns the pipeline for a VSDL_SHADER_* / VSDL_PIPELINE_* combination, creating it on first use
+VkPipeline vsdl_get_pipeline_variant(VulkanContext* vkCtx, uint32_t features);
+void vsdl_destroy_pipelines(VulkanContext* vkCtx);
 void vsdl_record_command_buffer(VulkanContext* vkCtx, uint32_t imageIndex);
-void vsdl_reflect_vertex_inputs(const char* shaderCode, size_t codeSize, VkVertexInputAttributeDescription** attrDesc, uint32_t* attrCount, uint32_t* stride);
 
 #endif
\ No newline at end of file
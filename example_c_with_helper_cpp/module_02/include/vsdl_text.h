@@ -0,0 +1,24 @@
+#ifndef VSDL_TEXT_H
+#define VSDL_TEXT_H
+
+#include "vsdl_types.h"
+#include "vsdl_jobs.h"
+#include <cglm/cglm.h>
+
+#define VSDL_TEXT_MAX_GLYPHS (128 * 1024)
+#define VSDL_TEXT_RASTER_SIZE 48 // Pixel size glyphs are cached at; draw sizes scale it
+#define VSDL_TEXT_SDF_SIZE 32    // Pixel size of distance field glyphs, which stay sharp at any scale
+
+void vsdl_text_init(VulkanContext* vkCtx, const char* fontPath);
+void vsdl_text_cleanup(VulkanContext* vkCtx);
+void vsdl_text_prewarm(VulkanContext* vkCtx, JobSystem* jobs, const char* fontPath, const uint32_t* codepoints, uint32_t count);
+// Per frame, after the in-flight fence has been waited on:
+// vsdl_text_begin, any number of vsdl_text_draw, then vsdl_text_end.
+// vsdl_text_set_sdf may be called in between; each mode keeps its own quads.
+void vsdl_text_begin(VulkanContext* vkCtx);
+void vsdl_text_set_sdf(VulkanContext* vkCtx, bool enable);
+float vsdl_text_draw(VulkanContext* vkCtx, const char* str, vec2 pos, float size, vec3 color);
+void vsdl_text_end(VulkanContext* vkCtx);
+void vsdl_text_record(VulkanContext* vkCtx, VkCommandBuffer commandBuffer);
+
+#endif
\ No newline at end of file
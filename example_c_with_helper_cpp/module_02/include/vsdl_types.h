@@ -4,17 +4,147 @@
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 #include <stdbool.h>
+#include "vsdl_glyph_cache.h"
+#include "vsdl_reflect.h"
+#include "vsdl_jobs.h"
 
 typedef struct {
-    VkBuffer buffer;
+    VkBuffer buffer;       // PackedVertex data followed by uint32 indices
     VmaAllocation allocation;
-    uint32_t vertexCount;
+    uint32_t vertexCount;  // Unique vertices after deduplication
+    uint32_t indexCount;
+    VkDeviceSize indexOffset;
     bool exists;
     VkImage texture;
     VmaAllocation texAlloc;
     VkImageView textureView;
 } RenderObject;
 
+// GPU copy of a GlyphCache: an R8 image updated from a persistently mapped
+// staging mirror, one dirty rectangle per vkCmdCopyBufferToImage region
+typedef struct {
+    GlyphCache cache;
+    VkImage image;
+    VmaAllocation allocation;
+    VkImageView view;
+    VkBuffer stagingBuffer;
+    VmaAllocation stagingAllocation;
+    uint8_t* stagingMapped;
+    uint32_t textureIndex; // Slot in the bindless texture table
+    bool initialized; // Image has left VK_IMAGE_LAYOUT_UNDEFINED
+} GlyphAtlas;
+
+#define VSDL_TEXT_MAX_RANGES 16 // Coverage/SDF switches per frame
+
+// Run of consecutive glyph quads laid out in one rendering mode
+typedef struct {
+    uint32_t first; // First quad of the run; it ends where the next run starts
+    bool sdf;
+} TextRange;
+
+// Per-frame glyph quads written straight into a persistently mapped vertex
+// buffer by vsdl_text_draw and drawn with one vkCmdDraw per TextRange
+typedef struct {
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    float* mapped;
+    uint32_t capacity;   // Glyph quads
+    uint32_t glyphCount; // Quads written since vsdl_text_begin
+    bool overflowed;
+    bool sdf; // Lay out signed distance field glyphs instead of coverage bitmaps
+    TextRange ranges[VSDL_TEXT_MAX_RANGES];
+    uint32_t rangeCount;
+    FT_Face face;
+    FT_UInt asciiIndex[128];         // Char -> glyph index for the common range
+    int16_t asciiKerning[128][128];  // Kerning in font units, independent of raster size
+} TextBatch;
+
+#define VSDL_PIPELINE_VARIANT_MAX 8
+
+// One pipeline per fragment shader feature combination (VSDL_SHADER_* bits) and
+// vertex layout (VSDL_PIPELINE_PACKED_VERTICES),
+// created on first use and looked up by hash
+typedef struct {
+    uint64_t hash; // Shader code hash combined with the feature bits
+    uint32_t features;
+    VkPipeline pipeline;
+} PipelineVariant;
+
+// Slots of the bindless texture table (vsdl_bindless.h). Slots below nextSlot
+// that are not live sit on the free list once their last frame has completed.
+typedef struct {
+    uint32_t capacity;
+    uint32_t nextSlot;
+    uint32_t* freeSlots;
+    uint32_t freeCount;
+    uint32_t liveCount;
+} TextureTable;
+
+// One entry of the frame's draw list: a mesh and the translation pushed for it
+typedef struct {
+    const RenderObject* object;
+    float offset[4]; // DrawPushConstants.offset, w unused
+} DrawItem;
+
+#define VSDL_RECORD_MAX_CHUNKS 64 // Secondary command buffers per frame, text included
+
+// Command pool owned by one job worker. Only that worker allocates from or
+// records into it, so no locking; the whole pool is reset once per frame.
+typedef struct {
+    VkCommandPool pool;
+    VkCommandBuffer* buffers; // Secondary buffers allocated so far, reused every frame
+    uint32_t bufferCount;
+    uint32_t usedCount;       // Handed out since the last reset
+} RecordWorker;
+
+// Draw list of the frame and the secondary command buffers it is recorded
+// into, one chunk per job, executed by the primary in chunk order
+typedef struct {
+    JobSystem* jobs;
+    RecordWorker workers[VSDL_JOBS_MAX_WORKERS];
+    DrawItem* items;
+    uint32_t itemCount;
+    uint32_t itemCapacity;
+    VkCommandBuffer secondaries[VSDL_RECORD_MAX_CHUNKS];
+    uint32_t secondaryCount; // Recorded for the current frame
+} Recorder;
+
+typedef enum {
+    VSDL_DELETION_BUFFER,
+    VSDL_DELETION_IMAGE,
+    VSDL_DELETION_IMAGE_VIEW,
+    VSDL_DELETION_TEXTURE_SLOT
+} DeletionKind;
+
+// A destroyed resource waiting for the last frame that used it to complete
+typedef struct {
+    DeletionKind kind;
+    uint64_t retireFrame; // Value of VulkanContext.frameNumber when retired
+    union {
+        struct { VkBuffer buffer; VmaAllocation allocation; } buffer;
+        struct { VkImage image; VmaAllocation allocation; } image;
+        VkImageView imageView;
+        uint32_t textureSlot;
+    };
+} PendingDeletion;
+
+typedef struct {
+    PendingDeletion* items;
+    uint32_t count;
+    uint32_t capacity;
+} DeletionQueue;
+
+// Offscreen stand-in for the surface and swapchain (--headless). The images
+// double as VulkanContext.swapchainImages so the render loop indexes them the
+// same way; nothing is presented.
+typedef struct {
+    VmaAllocation* allocations; // One per swapchainImages entry
+    uint32_t nextImage;
+    VkBuffer readbackBuffer;    // Persistently mapped, one frame of pixels
+    VmaAllocation readbackAllocation;
+    uint8_t* readbackMapped;
+} HeadlessTarget;
+
 typedef struct {
     VkInstance instance;
     VkPhysicalDevice physicalDevice;
@@ -24,14 +154,32 @@ typedef struct {
     VkSwapchainKHR swapchain;
     VkRenderPass renderPass;
     VkPipelineLayout pipelineLayout;
-    VkPipeline graphicsPipeline;
+    VkShaderModule vertModule; // Kept for variants created after startup
+    VkShaderModule fragModule;
+    uint64_t shaderHash;       // Combined reflection hashes of vert.spv and frag.spv
+    const ShaderReflection* vertReflection; // Owned by the reflection cache
+    const ShaderReflection* fragReflection;
+    VkVertexInputAttributeDescription vertexAttributes[VSDL_REFLECT_MAX_INPUTS];
+    uint32_t vertexAttributeCount;
+    uint32_t vertexStride;
+    VkVertexInputAttributeDescription packedVertexAttributes[VSDL_REFLECT_MAX_INPUTS]; // PackedVertex meshes
+    uint32_t packedVertexAttributeCount;
+    uint32_t packedVertexStride;
+    PipelineVariant pipelineVariants[VSDL_PIPELINE_VARIANT_MAX];
+    uint32_t pipelineVariantCount;
+    VkPipelineCache pipelineCache;
+    bool pipelineCacheWarm; // Seeded from disk rather than empty
+    bool pipelineCacheUsed; // A pipeline was created against it since loading
+    size_t pipelineCacheLoadedBytes; // Size of the data it was seeded with
     VkCommandPool commandPool;
-    VkCommandBuffer commandBuffer;
+    VkCommandBuffer commandBuffer; // Primary; executes the recorder's secondaries when it has workers
+    Recorder recorder;
     VkBuffer uniformBuffer;
     VmaAllocation uniformAllocation;
     VkDescriptorSetLayout descriptorSetLayout;
     VkDescriptorPool descriptorPool;
-    VkDescriptorSet descriptorSet;
+    VkDescriptorSet descriptorSet; // Update-after-bind: holds the bindless texture table
+    TextureTable textures;
     VkSemaphore imageAvailableSemaphore;
     VkSemaphore renderFinishedSemaphore;
     VkFence inFlightFence;
@@ -47,8 +195,12 @@ typedef struct {
     RenderObject text;
     uint32_t graphicsQueueFamilyIndex;
     VkSampler textureSampler;
+    GlyphAtlas* glyphAtlas; // Created by vsdl_text_init
+    TextBatch* textBatch;
+    uint64_t frameNumber;          // Frames submitted so far
+    uint64_t completedFrameNumber; // Frames whose inFlightFence has signaled
+    DeletionQueue deletionQueue;
+    HeadlessTarget headlessTarget; // Images of --headless, empty with a window
 } VulkanContext;
 
-extern VkImageView dummyTextureView; // Declare here for shared access
-
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef VSDL_VERTEX_PACK_H
+#define VSDL_VERTEX_PACK_H
+
+#include <vulkan/vulkan.h>
+#include <stdint.h>
+
+// Unpacked mesh vertex as authored: position xyz, color rgb, uv
+#define VSDL_VERTEX_FLOATS 8
+
+// The same vertex in 16 bytes instead of 32. Positions are half floats rather than
+// snorm16 so meshes need no per-mesh scale in the shader; w is padding because
+// three-component 16-bit vertex formats are rarely supported.
+typedef struct {
+    uint16_t position[4]; // R16G16B16A16_SFLOAT, w = 1.0
+    uint8_t color[4];     // R8G8B8A8_UNORM, a = 255
+    uint16_t uv[2];       // R16G16_UNORM, clamped to [0, 1]
+} PackedVertex;
+
+// Per-location format overrides for vsdl_reflect_vertex_layout
+#define VSDL_PACKED_VERTEX_FORMAT_COUNT 3
+extern const VkFormat vsdl_packed_vertex_formats[VSDL_PACKED_VERTEX_FORMAT_COUNT];
+
+// Round to nearest even; out of range values become infinity
+uint16_t vsdl_float_to_half(float value);
+void vsdl_pack_vertex(const float* vertex, PackedVertex* packed);
+// Packs a non-indexed triangle list and merges vertices that are identical after
+// quantization. outVertices and outIndices need room for vertexCount entries.
+// Returns the number of unique vertices.
+uint32_t vsdl_pack_mesh(const float* vertices, uint32_t vertexCount, PackedVertex* outVertices, uint32_t* outIndices);
+
+#endif
\ No newline at end of file
@@ -10,6 +10,8 @@
 extern "C" {
 #endif
 
+// With a NULL window (--headless) no surface or swapchain is created and the
+// image outputs are left empty for vsdl_headless_init
 void init_vulkan(SDL_Window* window, VkInstance* instance, VkPhysicalDevice* physicalDevice, VkDevice* device, 
                  VkQueue* graphicsQueue, VkSurfaceKHR* surface, VkSwapchainKHR* swapchain, uint32_t* imageCount,
                  VkImage** swapchainImages, VkImageView** swapchainImageViews, uint32_t* graphicsQueueFamilyIndex);
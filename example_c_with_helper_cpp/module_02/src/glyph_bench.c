@@ -0,0 +1,121 @@
+// glyph_bench.c: GPU-free benchmark of parallel glyph rasterization.
+// Reports glyphs/sec for 1..N job workers and the cost of packing the result.
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vsdl_jobs.h"
+#include "vsdl_glyph_raster.h"
+#include "vsdl_log.h"
+
+static uint32_t add_range(uint32_t* codepoints, uint32_t count, uint32_t first, uint32_t last) {
+    for (uint32_t c = first; c <= last; c++) {
+        if (codepoints) codepoints[count] = c;
+        count++;
+    }
+    return count;
+}
+
+// Latin-1, Latin Extended-A/B, Greek and Cyrillic; optionally 4096 CJK ideographs
+static uint32_t build_glyph_set(uint32_t* codepoints, bool cjk) {
+    uint32_t count = 0;
+    count = add_range(codepoints, count, 0x20, 0x7E);
+    count = add_range(codepoints, count, 0xA0, 0x24F);
+    count = add_range(codepoints, count, 0x370, 0x3FF);
+    count = add_range(codepoints, count, 0x400, 0x4FF);
+    if (cjk) {
+        count = add_range(codepoints, count, 0x4E00, 0x4FFF);
+    }
+    return count;
+}
+
+static double seconds_since(Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char* argv[]) {
+    const char* fontPath = "FiraSans-Bold.ttf";
+    uint32_t pixelSize = 48;
+    uint32_t repeat = 8;
+    uint32_t maxThreads = (uint32_t)SDL_GetNumLogicalCPUCores();
+    bool sdf = false, cjk = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) fontPath = argv[++i];
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) pixelSize = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) maxThreads = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sdf") == 0) sdf = true;
+        else if (strcmp(argv[i], "--cjk") == 0) cjk = true;
+        else {
+            printf("Usage: %s [--font path] [--size px] [--repeat n] [--threads n] [--sdf] [--cjk]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (maxThreads < 1) maxThreads = 1;
+    if (maxThreads > VSDL_JOBS_MAX_WORKERS) maxThreads = VSDL_JOBS_MAX_WORKERS;
+    if (repeat < 1) repeat = 1;
+
+    vsdl_init_log("glyph_bench.log", false);
+    uint32_t count = build_glyph_set(NULL, cjk);
+    uint32_t* codepoints = malloc(count * sizeof(uint32_t));
+    RasterizedGlyph* glyphs = malloc(count * sizeof(RasterizedGlyph));
+    if (!codepoints || !glyphs) {
+        vsdl_log("Out of memory\n");
+        return 1;
+    }
+    build_glyph_set(codepoints, cjk);
+
+    vsdl_log("[bench] font=%s size=%u mode=%s codepoints=%u repeat=%u\n", fontPath, pixelSize,
+             sdf ? "sdf" : "coverage", count, repeat);
+    vsdl_log("[bench] threads   glyphs/sec   ms/run   speedup\n");
+
+    double baseline = 0.0;
+    uint32_t rendered = 0;
+    // 1, 2, 4, ... and finally maxThreads
+    for (uint32_t threads = 1;; threads *= 2) {
+        if (threads > maxThreads) threads = maxThreads;
+        JobSystem jobs;
+        GlyphRasterPool pool;
+        vsdl_jobs_init(&jobs, threads);
+        vsdl_glyph_raster_init(&pool, &jobs, fontPath, pixelSize, sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL);
+
+        // Warm-up run loads the glyph outlines into each face's caches
+        vsdl_glyph_raster_run(&pool, codepoints, count, glyphs);
+        vsdl_glyph_raster_free(glyphs, count);
+
+        double total = 0.0;
+        for (uint32_t r = 0; r < repeat; r++) {
+            Uint64 start = SDL_GetPerformanceCounter();
+            vsdl_glyph_raster_run(&pool, codepoints, count, glyphs);
+            total += seconds_since(start);
+            if (r + 1 < repeat) vsdl_glyph_raster_free(glyphs, count);
+        }
+
+        rendered = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (glyphs[i].ok) rendered++;
+        }
+        double perSecond = (double)rendered * repeat / total;
+        if (threads == 1) baseline = perSecond;
+        vsdl_log("[bench] %7u %12.0f %8.3f %8.2fx\n", threads, perSecond, total * 1000.0 / repeat, perSecond / baseline);
+
+        if (threads == maxThreads) {
+            // Packing stays on one thread: the atlas packer is not thread-safe
+            GlyphCache cache;
+            vsdl_glyph_cache_init(&cache, 2048, 2048);
+            Uint64 start = SDL_GetPerformanceCounter();
+            uint32_t inserted = vsdl_glyph_raster_insert(&pool, &cache, 0, glyphs, count);
+            vsdl_log("[bench] packed %u/%u glyphs into 2048x2048 in %.3f ms\n", inserted, rendered, seconds_since(start) * 1000.0);
+            vsdl_glyph_cache_destroy(&cache);
+        }
+        vsdl_glyph_raster_free(glyphs, count);
+        vsdl_glyph_raster_destroy(&pool);
+        vsdl_jobs_shutdown(&jobs);
+        if (threads == maxThreads) break;
+    }
+
+    free(glyphs);
+    free(codepoints);
+    vsdl_cleanup_log();
+    return 0;
+}
\ No newline at end of file
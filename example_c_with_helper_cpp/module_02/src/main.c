@@ -1,53 +1,119 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
 #include <vulkan/vulkan.h>
+#include <string.h>
 #include "vsdl_types.h"
 #include "vsdl_vulkan_init.h"
 #include "vsdl_camera.h"
 #include "vsdl_render.h"
 #include "vsdl_mesh.h"
+#include "vsdl_text.h"
 #include "vsdl_log.h"
+#include "vsdl_pipeline_cache.h"
+#include "vsdl_deletion.h"
+#include "vsdl_reflect.h"
+#include "vsdl_bindless.h"
+#include "vsdl_record.h"
+#include "vsdl_headless.h"
 
 #define WIDTH 800
 #define HEIGHT 600
 
 static VulkanContext vkCtx = {0};
-static VkImage dummyTexture;
-static VmaAllocation dummyAlloc;
-VkImageView dummyTextureView; // Definition remains here
 
-int main(int argc, char* argv[]) {
-    vsdl_init_log("debug.log", true);
-    SDL_Init(SDL_INIT_VIDEO);
+// Lays out 100k glyphs per frame and logs the CPU cost of the layout alone
+static void vsdl_bench_text(VulkanContext* vkCtx) {
+    static const char* line = "The quick brown fox jumps over the lazy dog. AVATAR Wave To 0123456789 !?";
+    static uint64_t totalTicks = 0;
+    static uint32_t frames = 0;
+    const uint32_t targetGlyphs = 100000;
+
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint32_t glyphsBefore = vkCtx->textBatch->glyphCount;
+    float y = 1.0f;
+    while (vkCtx->textBatch->glyphCount - glyphsBefore < targetGlyphs && !vkCtx->textBatch->overflowed) {
+        vsdl_text_draw(vkCtx, line, (vec2){-1.5f, y}, 0.02f, (vec3){0.8f, 0.8f, 0.8f});
+        y -= 0.025f;
+    }
+    totalTicks += SDL_GetPerformanceCounter() - start;
+
+    if (++frames == 120) {
+        double ms = (double)totalTicks * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+        vsdl_log("[bench] text layout: %u glyphs/frame, %.3f ms/frame CPU (avg of %u frames)\n",
+                 vkCtx->textBatch->glyphCount - glyphsBefore, ms, frames);
+        totalTicks = 0;
+        frames = 0;
+    }
+}
+
+// Logs the CPU time spent recording the frame's command buffers, averaged over 120 frames
+static void vsdl_bench_record(VulkanContext* vkCtx, uint64_t ticks) {
+    static uint64_t totalTicks = 0;
+    static uint32_t frames = 0;
+
+    totalTicks += ticks;
+    if (++frames == 120) {
+        double ms = (double)totalTicks * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+        vsdl_log("[bench] record: %u draws, %u threads, %u secondary buffers, %.3f ms/frame CPU (avg of %u frames)\n",
+                 vkCtx->recorder.itemCount, vkCtx->recorder.jobs->workerCount, vkCtx->recorder.secondaryCount, ms, frames);
+        totalTicks = 0;
+        frames = 0;
+    }
+}
 
-    SDL_Window* window = SDL_CreateWindow("Vulkan SDL3 Text Rendering", WIDTH, HEIGHT, SDL_WINDOW_VULKAN);
-    if (!window) {
-        vsdl_log("Window creation failed: %s\n", SDL_GetError());
-        return 1;
+int main(int argc, char* argv[]) {
+    bool benchText = false;
+    bool textSdf = false;
+    uint32_t benchRecord = 0;   // Extra cube/triangle draws per frame
+    uint32_t recordThreads = 0; // Job workers, 0 for every logical core; 1 records inline
+    bool headless = false;      // Offscreen images instead of a window and swapchain
+    uint32_t headlessImages = VSDL_HEADLESS_IMAGES;
+    uint32_t frameLimit = 0;    // Exit after this many frames, 0 to run until closed
+    const char* readbackPath = NULL;
+    const char* goldenPath = NULL;
+    uint32_t goldenTolerance = VSDL_GOLDEN_TOLERANCE;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-text") == 0) benchText = true;
+        if (strcmp(argv[i], "--text-sdf") == 0) textSdf = true;
+        if (strcmp(argv[i], "--bench-record") == 0 && i + 1 < argc) benchRecord = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        if (strcmp(argv[i], "--record-threads") == 0 && i + 1 < argc) recordThreads = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        if (strcmp(argv[i], "--headless") == 0) headless = true;
+        if (strcmp(argv[i], "--headless-images") == 0 && i + 1 < argc) headlessImages = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 1);
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frameLimit = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        if (strcmp(argv[i], "--readback") == 0 && i + 1 < argc) readbackPath = argv[++i];
+        if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) goldenPath = argv[++i];
+        if (strcmp(argv[i], "--golden-tolerance") == 0 && i + 1 < argc) goldenTolerance = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+    }
+    // Nothing can close a headless run, so it always stops on its own
+    if (headless && frameLimit == 0) frameLimit = VSDL_HEADLESS_FRAMES;
+    bool bench = benchText || benchRecord > 0;
+
+    vsdl_init_log("debug.log", !bench); // Per-frame file logging would skew the benchmark
+    if (bench) vsdl_log_set_level(VSDL_LOG_LEVEL_INFO);
+    // Headless runs need no display, so only the event subsystem is started
+    SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO);
+
+    SDL_Window* window = NULL;
+    if (!headless) {
+        window = SDL_CreateWindow("Vulkan SDL3 Text Rendering", WIDTH, HEIGHT, SDL_WINDOW_VULKAN);
+        if (!window) {
+            vsdl_log("Window creation failed: %s\n", SDL_GetError());
+            return 1;
+        }
     }
 
     init_vulkan(window, &vkCtx.instance, &vkCtx.physicalDevice, &vkCtx.device, &vkCtx.graphicsQueue, &vkCtx.surface,
                 &vkCtx.swapchain, &vkCtx.imageCount, &vkCtx.swapchainImages, &vkCtx.swapchainImageViews, &vkCtx.graphicsQueueFamilyIndex);
-
-    // Create descriptor set layout
-    VkDescriptorSetLayoutBinding layoutBindings[2] = {};
-    layoutBindings[0].binding = 0;
-    layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    layoutBindings[0].descriptorCount = 1;
-    layoutBindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-    layoutBindings[1].binding = 1;
-    layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    layoutBindings[1].descriptorCount = 1;
-    layoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    VkDescriptorSetLayoutCreateInfo layoutInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
-    layoutInfo.bindingCount = 2;
-    layoutInfo.pBindings = layoutBindings;
-    if (vkCreateDescriptorSetLayout(vkCtx.device, &layoutInfo, NULL, &vkCtx.descriptorSetLayout) != VK_SUCCESS) {
-        vsdl_log("Failed to create descriptor set layout\n");
-        exit(1);
+    if (headless) {
+        vsdl_headless_init(&vkCtx, headlessImages, readbackPath || goldenPath);
     }
 
+    // Descriptor set layout comes from the shaders; known SPIR-V skips SPIRV-Cross.
+    // The texture table size must be known before its runtime array is laid out.
+    vsdl_bindless_init(&vkCtx);
+    vsdl_reflect_cache_load(VSDL_REFLECT_CACHE_FILE);
+    vsdl_load_shaders(&vkCtx);
+
     // Create render pass
     VkAttachmentDescription colorAttachment = {};
     colorAttachment.format = VK_FORMAT_B8G8R8A8_UNORM;
@@ -57,7 +123,8 @@ int main(int argc, char* argv[]) {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // Headless images are never presented; they are left ready for readback
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentReference colorAttachmentRef = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
 
@@ -136,88 +203,18 @@ int main(int argc, char* argv[]) {
         exit(1);
     }
 
-    // Create dummy texture
-    VkImageCreateInfo dummyImageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
-    dummyImageInfo.imageType = VK_IMAGE_TYPE_2D;
-    dummyImageInfo.format = VK_FORMAT_R8_UNORM;
-    dummyImageInfo.extent.width = 1;
-    dummyImageInfo.extent.height = 1;
-    dummyImageInfo.extent.depth = 1;
-    dummyImageInfo.mipLevels = 1;
-    dummyImageInfo.arrayLayers = 1;
-    dummyImageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    dummyImageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    dummyImageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    dummyImageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    dummyImageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-    VmaAllocationCreateInfo dummyAllocInfo = {};
-    dummyAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    if (vmaCreateImage(allocator, &dummyImageInfo, &dummyAllocInfo, &dummyTexture, &dummyAlloc, NULL) != VK_SUCCESS) {
-        vsdl_log("Failed to create dummy texture\n");
-        exit(1);
-    }
-
-    VkImageViewCreateInfo dummyViewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
-    dummyViewInfo.image = dummyTexture;
-    dummyViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    dummyViewInfo.format = VK_FORMAT_R8_UNORM;
-    dummyViewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    dummyViewInfo.subresourceRange.baseMipLevel = 0;
-    dummyViewInfo.subresourceRange.levelCount = 1;
-    dummyViewInfo.subresourceRange.baseArrayLayer = 0;
-    dummyViewInfo.subresourceRange.layerCount = 1;
-
-    if (vkCreateImageView(vkCtx.device, &dummyViewInfo, NULL, &dummyTextureView) != VK_SUCCESS) {
-        vsdl_log("Failed to create dummy texture view\n");
-        exit(1);
-    }
-
-    // Transition dummy texture to shader-readable layout
-    VkCommandBuffer transitionCmd;
-    VkCommandBufferAllocateInfo transitionAllocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
-    transitionAllocInfo.commandPool = vkCtx.commandPool;
-    transitionAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    transitionAllocInfo.commandBufferCount = 1;
-    vkAllocateCommandBuffers(vkCtx.device, &transitionAllocInfo, &transitionCmd);
-
-    VkCommandBufferBeginInfo transitionBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    transitionBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(transitionCmd, &transitionBeginInfo);
-
-    VkImageMemoryBarrier dummyBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-    dummyBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    dummyBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    dummyBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dummyBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dummyBarrier.image = dummyTexture;
-    dummyBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    dummyBarrier.subresourceRange.baseMipLevel = 0;
-    dummyBarrier.subresourceRange.levelCount = 1;
-    dummyBarrier.subresourceRange.baseArrayLayer = 0;
-    dummyBarrier.subresourceRange.layerCount = 1;
-    dummyBarrier.srcAccessMask = 0;
-    dummyBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    vkCmdPipelineBarrier(transitionCmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &dummyBarrier);
-    vkEndCommandBuffer(transitionCmd);
-
-    VkSubmitInfo transitionSubmit = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
-    transitionSubmit.commandBufferCount = 1;
-    transitionSubmit.pCommandBuffers = &transitionCmd;
-    vkQueueSubmit(vkCtx.graphicsQueue, 1, &transitionSubmit, VK_NULL_HANDLE);
-    vkQueueWaitIdle(vkCtx.graphicsQueue);
-    vkFreeCommandBuffers(vkCtx.device, vkCtx.commandPool, 1, &transitionCmd);
-
-    // Create descriptor pool
-    VkDescriptorPoolSize poolSizes[2] = {};
+    // Create descriptor pool: one set holding the uniform buffer and the whole texture table
+    VkDescriptorPoolSize poolSizes[3] = {};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     poolSizes[0].descriptorCount = 1;
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    poolSizes[1].descriptorCount = vkCtx.textures.capacity;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_SAMPLER;
+    poolSizes[2].descriptorCount = 1;
 
     VkDescriptorPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
-    poolInfo.poolSizeCount = 2;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.poolSizeCount = 3;
     poolInfo.pPoolSizes = poolSizes;
     poolInfo.maxSets = 1;
     if (vkCreateDescriptorPool(vkCtx.device, &poolInfo, NULL, &vkCtx.descriptorPool) != VK_SUCCESS) {
@@ -258,16 +255,15 @@ int main(int argc, char* argv[]) {
         exit(1);
     }
 
-    // Update descriptor set with uniform buffer and dummy texture
+    // Update descriptor set with uniform buffer and sampler; texture slots are
+    // written by vsdl_bindless_add_texture and unused ones stay empty
     VkDescriptorBufferInfo bufferDescriptorInfo = {};
     bufferDescriptorInfo.buffer = vkCtx.uniformBuffer;
     bufferDescriptorInfo.offset = 0;
     bufferDescriptorInfo.range = sizeof(mat4) * 3;
 
-    VkDescriptorImageInfo dummyDescriptorImageInfo = {};
-    dummyDescriptorImageInfo.sampler = vkCtx.textureSampler;
-    dummyDescriptorImageInfo.imageView = dummyTextureView;
-    dummyDescriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    VkDescriptorImageInfo samplerDescriptorInfo = {};
+    samplerDescriptorInfo.sampler = vkCtx.textureSampler;
 
     VkWriteDescriptorSet descriptorWrites[2] = {};
     descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -280,16 +276,32 @@ int main(int argc, char* argv[]) {
 
     descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     descriptorWrites[1].dstSet = vkCtx.descriptorSet;
-    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].dstBinding = VSDL_BINDLESS_SAMPLER_BINDING;
     descriptorWrites[1].dstArrayElement = 0;
-    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
     descriptorWrites[1].descriptorCount = 1;
-    descriptorWrites[1].pImageInfo = &dummyDescriptorImageInfo;
+    descriptorWrites[1].pImageInfo = &samplerDescriptorInfo;
 
     vkUpdateDescriptorSets(vkCtx.device, 2, descriptorWrites, 0, NULL);
 
+    vsdl_pipeline_cache_load(&vkCtx, VSDL_PIPELINE_CACHE_FILE);
     vsdl_create_pipeline(&vkCtx);
     vsdl_create_triangle(&vkCtx, &vkCtx.triangle);
+    vsdl_text_init(&vkCtx, "FiraSans-Bold.ttf");
+    if (textSdf) vsdl_text_set_sdf(&vkCtx, true);
+
+    // Rasterize Latin-1 up front on every core instead of glyph by glyph on first use.
+    // The same workers record the draw list into secondary command buffers.
+    JobSystem jobs;
+    vsdl_jobs_init(&jobs, recordThreads);
+    vsdl_record_init(&vkCtx, &jobs);
+    uint32_t latin1[191];
+    uint32_t latin1Count = 0;
+    for (uint32_t c = 0x20; c <= 0xFF; c++) {
+        if (c < 0x7F || c >= 0xA0) latin1[latin1Count++] = c;
+    }
+    vsdl_text_prewarm(&vkCtx, &jobs, "FiraSans-Bold.ttf", latin1, latin1Count);
+    if (benchRecord > 0 && !vkCtx.cube.exists) vsdl_create_cube(&vkCtx, &vkCtx.cube);
 
     Camera cam = {{0.0f, 0.0f, 3.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}, -90.0f, 0.0f};
     bool mouseCaptured = false;
@@ -298,6 +310,7 @@ int main(int argc, char* argv[]) {
     float rotationAngle = 0.0f;
     Uint32 lastTime = SDL_GetTicks();
     SDL_Event event;
+    uint32_t lastImageIndex = 0;
 
     while (running) {
         Uint32 currentTime = SDL_GetTicks();
@@ -316,6 +329,7 @@ int main(int argc, char* argv[]) {
                     case SDLK_4: vkCtx.triangle.exists ? vsdl_destroy_triangle(&vkCtx, &vkCtx.triangle) : vsdl_create_triangle(&vkCtx, &vkCtx.triangle); break;
                     case SDLK_5: vkCtx.cube.exists ? vsdl_destroy_cube(&vkCtx, &vkCtx.cube) : vsdl_create_cube(&vkCtx, &vkCtx.cube); break;
                     case SDLK_6: vkCtx.text.exists ? vsdl_destroy_text(&vkCtx, &vkCtx.text) : vsdl_create_text(&vkCtx, &vkCtx.text); break;
+                    case SDLK_7: vsdl_text_set_sdf(&vkCtx, !vkCtx.textBatch->sdf); break;
                 }
             }
         }
@@ -329,33 +343,72 @@ int main(int argc, char* argv[]) {
 
         vkWaitForFences(vkCtx.device, 1, &vkCtx.inFlightFence, VK_TRUE, UINT64_MAX);
         vkResetFences(vkCtx.device, 1, &vkCtx.inFlightFence);
+        vkCtx.completedFrameNumber = vkCtx.frameNumber;
+        vsdl_deletion_collect(&vkCtx);
+        vsdl_record_begin_frame(&vkCtx);
+
+        if (vkCtx.triangle.exists) vsdl_draw_list_add(&vkCtx, &vkCtx.triangle, (vec3){0.0f, 0.0f, 0.0f});
+        if (vkCtx.cube.exists) vsdl_draw_list_add(&vkCtx, &vkCtx.cube, (vec3){0.0f, 0.0f, 0.0f});
+        if (benchRecord > 0) {
+            // A square grid of alternating cubes and triangles behind the scene
+            uint32_t side = (uint32_t)SDL_ceil(SDL_sqrt((double)benchRecord));
+            for (uint32_t i = 0; i < benchRecord; i++) {
+                const RenderObject* object = (i % 2 == 0 && vkCtx.cube.exists) ? &vkCtx.cube : &vkCtx.triangle;
+                if (!object->exists) continue;
+                vec3 offset = {((float)(i % side) - side * 0.5f) * 0.4f, ((float)(i / side) - side * 0.5f) * 0.4f, -0.5f * side};
+                vsdl_draw_list_add(&vkCtx, object, offset);
+            }
+        }
+
+        // The previous frame has finished reading the text vertex buffer
+        vsdl_text_begin(&vkCtx);
+        if (vkCtx.text.exists) {
+            vsdl_text_draw(&vkCtx, "Hello World", (vec2){-0.5f, -0.05f}, 0.2f, (vec3){1.0f, 1.0f, 1.0f});
+        }
+        if (benchText) {
+            vsdl_bench_text(&vkCtx);
+        }
+        vsdl_text_end(&vkCtx);
 
         uint32_t imageIndex;
-        VkResult result = vkAcquireNextImageKHR(vkCtx.device, vkCtx.swapchain, UINT64_MAX, vkCtx.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
-        if (result != VK_SUCCESS) {
-            vsdl_log("Failed to acquire next image: %d\n", result);
-            return 1;
+        if (headless) {
+            imageIndex = vsdl_headless_acquire(&vkCtx);
+        } else {
+            VkResult result = vkAcquireNextImageKHR(vkCtx.device, vkCtx.swapchain, UINT64_MAX, vkCtx.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+            if (result != VK_SUCCESS) {
+                vsdl_log("Failed to acquire next image: %d\n", result);
+                return 1;
+            }
         }
 
         vkResetCommandBuffer(vkCtx.commandBuffer, 0);
+        uint64_t recordStart = SDL_GetPerformanceCounter();
         vsdl_record_command_buffer(&vkCtx, imageIndex);
+        if (benchRecord > 0) {
+            vsdl_bench_record(&vkCtx, SDL_GetPerformanceCounter() - recordStart);
+        }
 
+        // Headless frames acquire and present nothing, so they skip both semaphores
         VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
         VkSemaphore waitSemaphores[] = {vkCtx.imageAvailableSemaphore};
         VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.waitSemaphoreCount = headless ? 0 : 1;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &vkCtx.commandBuffer;
         VkSemaphore signalSemaphores[] = {vkCtx.renderFinishedSemaphore};
-        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.signalSemaphoreCount = headless ? 0 : 1;
         submitInfo.pSignalSemaphores = signalSemaphores;
 
         if (vkQueueSubmit(vkCtx.graphicsQueue, 1, &submitInfo, vkCtx.inFlightFence) != VK_SUCCESS) {
             vsdl_log("Failed to submit draw command buffer\n");
             return 1;
         }
+        vkCtx.frameNumber++;
+        lastImageIndex = imageIndex;
+        if (frameLimit > 0 && vkCtx.frameNumber >= frameLimit) running = false;
+        if (headless) continue;
 
         VkPresentInfoKHR presentInfo = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
         presentInfo.waitSemaphoreCount = 1;
@@ -371,10 +424,25 @@ int main(int argc, char* argv[]) {
     }
 
     vkDeviceWaitIdle(vkCtx.device);
+    int exitCode = 0;
+    if (headless && vkCtx.frameNumber > 0 &&
+        !vsdl_headless_readback(&vkCtx, lastImageIndex, readbackPath, goldenPath, goldenTolerance)) {
+        exitCode = 1; // CI fails the run on a golden mismatch
+    }
+    if (vkCtx.triangle.exists) vsdl_destroy_triangle(&vkCtx, &vkCtx.triangle);
+    if (vkCtx.cube.exists) vsdl_destroy_cube(&vkCtx, &vkCtx.cube);
+    vsdl_text_cleanup(&vkCtx);
+    vsdl_deletion_flush(&vkCtx);
+    vsdl_record_destroy(&vkCtx);
+    vsdl_jobs_shutdown(&jobs);
+    vsdl_destroy_pipelines(&vkCtx);
+    vsdl_reflect_cache_save(VSDL_REFLECT_CACHE_FILE);
+    vsdl_pipeline_cache_save_and_destroy(&vkCtx, VSDL_PIPELINE_CACHE_FILE);
     for (uint32_t i = 0; i < vkCtx.imageCount; i++) {
         vkDestroyFramebuffer(vkCtx.device, vkCtx.swapchainFramebuffers[i], NULL);
     }
     free(vkCtx.swapchainFramebuffers);
+    if (headless) vsdl_headless_destroy(&vkCtx);
     vkDestroyRenderPass(vkCtx.device, vkCtx.renderPass, NULL);
     vkDestroyCommandPool(vkCtx.device, vkCtx.commandPool, NULL);
     vkDestroySemaphore(vkCtx.device, vkCtx.imageAvailableSemaphore, NULL);
@@ -383,11 +451,10 @@ int main(int argc, char* argv[]) {
     vkDestroyDescriptorPool(vkCtx.device, vkCtx.descriptorPool, NULL);
     vkDestroyDescriptorSetLayout(vkCtx.device, vkCtx.descriptorSetLayout, NULL);
     vkDestroySampler(vkCtx.device, vkCtx.textureSampler, NULL);
-    vkDestroyImageView(vkCtx.device, dummyTextureView, NULL);
-    vmaDestroyImage(allocator, dummyTexture, dummyAlloc);
+    vsdl_bindless_destroy(&vkCtx);
     vmaDestroyBuffer(allocator, vkCtx.uniformBuffer, vkCtx.uniformAllocation);
     vsdl_cleanup_log();
-    SDL_DestroyWindow(window);
+    if (window) SDL_DestroyWindow(window);
     SDL_Quit();
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "vsdl_bindless.h"
+#include "vsdl_deletion.h"
+#include "vsdl_log.h"
+#include <stdlib.h>
+
+void vsdl_bindless_init(VulkanContext* vkCtx) {
+  VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES};
+  VkPhysicalDeviceProperties2 properties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+  properties.pNext = &indexingProperties;
+  vkGetPhysicalDeviceProperties2(vkCtx->physicalDevice, &properties);
+
+  uint32_t capacity = VSDL_BINDLESS_MAX_TEXTURES;
+  if (capacity > indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages) {
+      capacity = indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages;
+  }
+  if (capacity > indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages) {
+      capacity = indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages;
+  }
+
+  TextureTable* table = &vkCtx->textures;
+  table->freeSlots = malloc(capacity * sizeof(uint32_t));
+  if (!table->freeSlots) {
+      vsdl_log("Failed to allocate texture table free list\n");
+      exit(1);
+  }
+  table->capacity = capacity;
+  table->freeCount = 0;
+  table->nextSlot = 0;
+  table->liveCount = 0;
+  vsdl_log("Bindless texture table: %u slots\n", capacity);
+}
+
+void vsdl_bindless_destroy(VulkanContext* vkCtx) {
+  free(vkCtx->textures.freeSlots);
+  vkCtx->textures.freeSlots = NULL;
+  vkCtx->textures.capacity = 0;
+}
+
+uint32_t vsdl_bindless_add_texture(VulkanContext* vkCtx, VkImageView view) {
+  TextureTable* table = &vkCtx->textures;
+  uint32_t index;
+  if (table->freeCount > 0) {
+      index = table->freeSlots[--table->freeCount];
+  } else if (table->nextSlot < table->capacity) {
+      index = table->nextSlot++;
+  } else {
+      vsdl_log("Bindless texture table full (%u slots)\n", table->capacity);
+      exit(1);
+  }
+
+  VkDescriptorImageInfo imageInfo = {};
+  imageInfo.imageView = view;
+  imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  VkWriteDescriptorSet descriptorWrite = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+  descriptorWrite.dstSet = vkCtx->descriptorSet;
+  descriptorWrite.dstBinding = VSDL_BINDLESS_TEXTURE_BINDING;
+  descriptorWrite.dstArrayElement = index;
+  descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+  descriptorWrite.descriptorCount = 1;
+  descriptorWrite.pImageInfo = &imageInfo;
+  vkUpdateDescriptorSets(vkCtx->device, 1, &descriptorWrite, 0, NULL);
+
+  table->liveCount++;
+  VSDL_DEBUG("Texture slot %u bound (%u live)\n", index, table->liveCount);
+  return index;
+}
+
+void vsdl_bindless_remove_texture(VulkanContext* vkCtx, uint32_t index) {
+  // The stale descriptor stays in place; partially bound slots need not be valid while unused
+  vkCtx->textures.liveCount--;
+  vsdl_retire_texture_slot(vkCtx, index);
+}
+
+void vsdl_bindless_free_slot(VulkanContext* vkCtx, uint32_t index) {
+  TextureTable* table = &vkCtx->textures;
+  if (!table->freeSlots) return; // Table already destroyed at shutdown
+  table->freeSlots[table->freeCount++] = index;
+}
\ No newline at end of file
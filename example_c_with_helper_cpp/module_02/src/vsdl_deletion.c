@@ -0,0 +1,93 @@
+#include "vsdl_deletion.h"
+#include "vsdl_log.h"
+#include "vsdl_bindless.h"
+#include "vsdl_vulkan_init.h" // For allocator
+#include <stdlib.h>
+
+/**
+ * Appends one entry stamped with the current frame, growing the queue as needed
+ */
+static PendingDeletion* vsdl_deletion_push(VulkanContext* vkCtx, DeletionKind kind) {
+  DeletionQueue* queue = &vkCtx->deletionQueue;
+  if (queue->count == queue->capacity) {
+      uint32_t capacity = queue->capacity ? queue->capacity * 2 : 16;
+      PendingDeletion* items = realloc(queue->items, capacity * sizeof(PendingDeletion));
+      if (!items) {
+          vsdl_log("Failed to grow deletion queue\n");
+          exit(1);
+      }
+      queue->items = items;
+      queue->capacity = capacity;
+  }
+  PendingDeletion* entry = &queue->items[queue->count++];
+  entry->kind = kind;
+  entry->retireFrame = vkCtx->frameNumber;
+  return entry;
+}
+
+/**
+ * Destroys the Vulkan object behind one queue entry
+ */
+static void vsdl_deletion_free(VulkanContext* vkCtx, const PendingDeletion* entry) {
+  switch (entry->kind) {
+      case VSDL_DELETION_BUFFER:
+          vmaDestroyBuffer(allocator, entry->buffer.buffer, entry->buffer.allocation);
+          break;
+      case VSDL_DELETION_IMAGE:
+          vmaDestroyImage(allocator, entry->image.image, entry->image.allocation);
+          break;
+      case VSDL_DELETION_IMAGE_VIEW:
+          vkDestroyImageView(vkCtx->device, entry->imageView, NULL);
+          break;
+      case VSDL_DELETION_TEXTURE_SLOT:
+          vsdl_bindless_free_slot(vkCtx, entry->textureSlot);
+          break;
+  }
+}
+
+void vsdl_retire_buffer(VulkanContext* vkCtx, VkBuffer buffer, VmaAllocation allocation) {
+  if (buffer == VK_NULL_HANDLE) return;
+  PendingDeletion* entry = vsdl_deletion_push(vkCtx, VSDL_DELETION_BUFFER);
+  entry->buffer.buffer = buffer;
+  entry->buffer.allocation = allocation;
+}
+
+void vsdl_retire_image(VulkanContext* vkCtx, VkImage image, VmaAllocation allocation) {
+  if (image == VK_NULL_HANDLE) return;
+  PendingDeletion* entry = vsdl_deletion_push(vkCtx, VSDL_DELETION_IMAGE);
+  entry->image.image = image;
+  entry->image.allocation = allocation;
+}
+
+void vsdl_retire_image_view(VulkanContext* vkCtx, VkImageView view) {
+  if (view == VK_NULL_HANDLE) return;
+  vsdl_deletion_push(vkCtx, VSDL_DELETION_IMAGE_VIEW)->imageView = view;
+}
+
+void vsdl_retire_texture_slot(VulkanContext* vkCtx, uint32_t index) {
+  vsdl_deletion_push(vkCtx, VSDL_DELETION_TEXTURE_SLOT)->textureSlot = index;
+}
+
+void vsdl_deletion_collect(VulkanContext* vkCtx) {
+  DeletionQueue* queue = &vkCtx->deletionQueue;
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < queue->count; i++) {
+      if (queue->items[i].retireFrame <= vkCtx->completedFrameNumber) {
+          vsdl_deletion_free(vkCtx, &queue->items[i]);
+      } else {
+          queue->items[kept++] = queue->items[i];
+      }
+  }
+  queue->count = kept;
+}
+
+void vsdl_deletion_flush(VulkanContext* vkCtx) {
+  DeletionQueue* queue = &vkCtx->deletionQueue;
+  for (uint32_t i = 0; i < queue->count; i++) {
+      vsdl_deletion_free(vkCtx, &queue->items[i]);
+  }
+  free(queue->items);
+  queue->items = NULL;
+  queue->count = 0;
+  queue->capacity = 0;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "vsdl_glyph_atlas.h"
+#include "vsdl_log.h"
+#include "vsdl_bindless.h"
+#include "vsdl_deletion.h"
+#include "vsdl_vulkan_init.h" // For allocator
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Creates the atlas image, its view and a persistently mapped staging mirror
+ */
+void vsdl_glyph_atlas_create(VulkanContext* vkCtx, uint32_t width, uint32_t height) {
+  GlyphAtlas* atlas = calloc(1, sizeof(GlyphAtlas));
+  if (!atlas) {
+      vsdl_log("Failed to allocate glyph atlas\n");
+      exit(1);
+  }
+  vsdl_glyph_cache_init(&atlas->cache, width, height);
+
+  VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.format = VK_FORMAT_R8_UNORM;
+  imageInfo.extent.width = width;
+  imageInfo.extent.height = height;
+  imageInfo.extent.depth = 1;
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+  VmaAllocationCreateInfo imageAllocInfo = {};
+  imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+  if (vmaCreateImage(allocator, &imageInfo, &imageAllocInfo, &atlas->image, &atlas->allocation, NULL) != VK_SUCCESS) {
+      vsdl_log("Failed to create glyph atlas image\n");
+      exit(1);
+  }
+
+  VkImageViewCreateInfo viewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+  viewInfo.image = atlas->image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = VK_FORMAT_R8_UNORM;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.baseMipLevel = 0;
+  viewInfo.subresourceRange.levelCount = 1;
+  viewInfo.subresourceRange.baseArrayLayer = 0;
+  viewInfo.subresourceRange.layerCount = 1;
+  if (vkCreateImageView(vkCtx->device, &viewInfo, NULL, &atlas->view) != VK_SUCCESS) {
+      vsdl_log("Failed to create glyph atlas view\n");
+      exit(1);
+  }
+
+  VkBufferCreateInfo stagingInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  stagingInfo.size = (VkDeviceSize)width * height;
+  stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  stagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VmaAllocationCreateInfo stagingAllocInfo = {};
+  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  VmaAllocationInfo stagingResult;
+  if (vmaCreateBuffer(allocator, &stagingInfo, &stagingAllocInfo, &atlas->stagingBuffer, &atlas->stagingAllocation, &stagingResult) != VK_SUCCESS) {
+      vsdl_log("Failed to create glyph atlas staging buffer\n");
+      exit(1);
+  }
+  atlas->stagingMapped = stagingResult.pMappedData;
+  atlas->textureIndex = vsdl_bindless_add_texture(vkCtx, atlas->view);
+
+  vkCtx->glyphAtlas = atlas;
+  vsdl_log("Glyph atlas created: %ux%u R8, texture slot %u\n", width, height, atlas->textureIndex);
+}
+
+void vsdl_glyph_atlas_destroy(VulkanContext* vkCtx) {
+  GlyphAtlas* atlas = vkCtx->glyphAtlas;
+  if (!atlas) {
+      return;
+  }
+  // The last frames may still sample the atlas or copy from its staging mirror
+  vsdl_bindless_remove_texture(vkCtx, atlas->textureIndex);
+  vsdl_retire_image_view(vkCtx, atlas->view);
+  vsdl_retire_image(vkCtx, atlas->image, atlas->allocation);
+  vsdl_retire_buffer(vkCtx, atlas->stagingBuffer, atlas->stagingAllocation);
+  vsdl_glyph_cache_destroy(&atlas->cache);
+  free(atlas);
+  vkCtx->glyphAtlas = NULL;
+  vsdl_log("Glyph atlas destroyed\n");
+}
+
+static void atlas_barrier(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                          VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage) {
+  VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = 0;
+  barrier.subresourceRange.levelCount = 1;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount = 1;
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstAccessMask = dstAccess;
+  vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, NULL, 0, NULL, 1, &barrier);
+}
+
+/**
+ * Copies newly rasterized glyphs to the GPU. The caller has waited for the
+ * previous frame's fence, so the staging mirror is no longer being read.
+ */
+void vsdl_glyph_atlas_record_upload(VulkanContext* vkCtx, VkCommandBuffer commandBuffer) {
+  GlyphAtlas* atlas = vkCtx->glyphAtlas;
+  GlyphCache* cache = &atlas->cache;
+
+  GlyphRect rects[VSDL_GLYPH_CACHE_MAX_DIRTY];
+  uint32_t rectCount = cache->dirtyCount;
+  if (!atlas->initialized) {
+      // First upload defines every texel, including the cleared background
+      rects[0] = (GlyphRect){0, 0, (uint16_t)cache->width, (uint16_t)cache->height};
+      rectCount = 1;
+  } else {
+      memcpy(rects, cache->dirty, rectCount * sizeof(GlyphRect));
+  }
+  vsdl_glyph_cache_clear_dirty(cache);
+  vsdl_glyph_cache_begin_frame(cache);
+  if (rectCount == 0) {
+      return;
+  }
+
+  VkBufferImageCopy regions[VSDL_GLYPH_CACHE_MAX_DIRTY];
+  for (uint32_t i = 0; i < rectCount; i++) {
+      // Start rows on a 4-byte boundary so bufferOffset stays aligned for any queue
+      uint32_t x = rects[i].x & ~3u;
+      uint32_t width = rects[i].x + rects[i].width - x;
+      uint32_t y = rects[i].y, height = rects[i].height;
+      VkDeviceSize offset = (VkDeviceSize)y * cache->width + x;
+      for (uint32_t row = 0; row < height; row++) {
+          size_t rowOffset = (size_t)(y + row) * cache->width + x;
+          memcpy(atlas->stagingMapped + rowOffset, cache->pixels + rowOffset, width);
+      }
+
+      VkBufferImageCopy* region = &regions[i];
+      memset(region, 0, sizeof(*region));
+      region->bufferOffset = offset;
+      region->bufferRowLength = cache->width;
+      region->bufferImageHeight = cache->height;
+      region->imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      region->imageSubresource.layerCount = 1;
+      region->imageOffset = (VkOffset3D){(int32_t)x, (int32_t)y, 0};
+      region->imageExtent = (VkExtent3D){width, height, 1};
+  }
+  vmaFlushAllocation(allocator, atlas->stagingAllocation, 0, VK_WHOLE_SIZE);
+
+  atlas_barrier(commandBuffer, atlas->image,
+                atlas->initialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+  vkCmdCopyBufferToImage(commandBuffer, atlas->stagingBuffer, atlas->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, rectCount, regions);
+  atlas_barrier(commandBuffer, atlas->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+  atlas->initialized = true;
+}
\ No newline at end of file
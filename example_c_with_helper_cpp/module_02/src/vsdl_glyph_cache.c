@@ -0,0 +1,299 @@
+#include "vsdl_glyph_cache.h"
+#include "vsdl_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BUCKET_COUNT (VSDL_GLYPH_CACHE_MAX_GLYPHS * 2)
+
+static uint32_t hash_key(GlyphKey key) {
+    // FNV-1a over the key fields
+    uint32_t h = 2166136261u;
+    h = (h ^ key.faceId) * 16777619u;
+    h = (h ^ key.pixelSize) * 16777619u;
+    h = (h ^ key.glyphIndex) * 16777619u;
+    h = (h ^ key.renderMode) * 16777619u;
+    return h & (BUCKET_COUNT - 1);
+}
+
+static bool key_equal(GlyphKey a, GlyphKey b) {
+    return a.faceId == b.faceId && a.pixelSize == b.pixelSize && a.glyphIndex == b.glyphIndex &&
+           a.renderMode == b.renderMode;
+}
+
+/**
+ * Initializes an empty cache with a width x height R8 pixel store
+ */
+void vsdl_glyph_cache_init(GlyphCache* cache, uint32_t width, uint32_t height) {
+    memset(cache, 0, sizeof(*cache));
+    cache->pixels = calloc(1, (size_t)width * height);
+    if (!cache->pixels) {
+        vsdl_log("Failed to allocate %ux%u glyph atlas\n", width, height);
+        exit(1);
+    }
+    cache->width = width;
+    cache->height = height;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        cache->buckets[i] = -1;
+    }
+    for (uint32_t i = 0; i < VSDL_GLYPH_CACHE_MAX_GLYPHS; i++) {
+        cache->entries[i].next = (i + 1 < VSDL_GLYPH_CACHE_MAX_GLYPHS) ? (int32_t)(i + 1) : -1;
+    }
+    cache->freeList = 0;
+    cache->frame = 1; // lastUsed == 0 means never used
+    vsdl_log("Glyph cache created: %ux%u atlas, %u glyphs max\n", width, height, VSDL_GLYPH_CACHE_MAX_GLYPHS);
+}
+
+void vsdl_glyph_cache_destroy(GlyphCache* cache) {
+    free(cache->pixels);
+    cache->pixels = NULL;
+}
+
+void vsdl_glyph_cache_begin_frame(GlyphCache* cache) {
+    cache->frame++;
+}
+
+static void touch(GlyphCache* cache, GlyphEntry* entry) {
+    entry->lastUsed = cache->frame;
+    if (entry->shelf >= 0) {
+        cache->shelves[entry->shelf].lastUsed = cache->frame;
+    }
+}
+
+const GlyphEntry* vsdl_glyph_cache_find(GlyphCache* cache, GlyphKey key) {
+    for (int32_t i = cache->buckets[hash_key(key)]; i >= 0; i = cache->entries[i].next) {
+        GlyphEntry* entry = &cache->entries[i];
+        if (key_equal(entry->key, key)) {
+            touch(cache, entry);
+            cache->hits++;
+            return entry;
+        }
+    }
+    cache->misses++;
+    return NULL;
+}
+
+static void mark_dirty(GlyphCache* cache, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if (cache->dirtyCount == VSDL_GLYPH_CACHE_MAX_DIRTY) {
+        // Too many small rects: collapse them into their bounding box
+        uint32_t x0 = cache->dirty[0].x, y0 = cache->dirty[0].y;
+        uint32_t x1 = x0 + cache->dirty[0].width, y1 = y0 + cache->dirty[0].height;
+        for (uint32_t i = 1; i < cache->dirtyCount; i++) {
+            const GlyphRect* r = &cache->dirty[i];
+            if (r->x < x0) x0 = r->x;
+            if (r->y < y0) y0 = r->y;
+            if (r->x + r->width > x1) x1 = r->x + r->width;
+            if (r->y + r->height > y1) y1 = r->y + r->height;
+        }
+        cache->dirty[0] = (GlyphRect){(uint16_t)x0, (uint16_t)y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0)};
+        cache->dirtyCount = 1;
+    }
+    cache->dirty[cache->dirtyCount++] = (GlyphRect){(uint16_t)x, (uint16_t)y, (uint16_t)width, (uint16_t)height};
+}
+
+void vsdl_glyph_cache_clear_dirty(GlyphCache* cache) {
+    cache->dirtyCount = 0;
+}
+
+static void remove_entry(GlyphCache* cache, int32_t index) {
+    GlyphEntry* entry = &cache->entries[index];
+    int32_t* link = &cache->buckets[hash_key(entry->key)];
+    while (*link != index) {
+        link = &cache->entries[*link].next;
+    }
+    *link = entry->next;
+    entry->used = false;
+    entry->next = cache->freeList;
+    cache->freeList = index;
+    cache->glyphCount--;
+}
+
+static void evict_shelf(GlyphCache* cache, int32_t shelf) {
+    for (int32_t i = 0; i < VSDL_GLYPH_CACHE_MAX_GLYPHS; i++) {
+        if (cache->entries[i].used && cache->entries[i].shelf == shelf) {
+            remove_entry(cache, i);
+            cache->evictions++;
+        }
+    }
+    cache->shelves[shelf].cursorX = 0;
+    cache->shelves[shelf].lastUsed = 0;
+}
+
+// Least recently used live shelf that was not used this frame
+static int32_t lru_shelf(const GlyphCache* cache) {
+    int32_t best = -1;
+    for (uint32_t s = 0; s < cache->shelfCount; s++) {
+        const GlyphShelf* shelf = &cache->shelves[s];
+        if (shelf->height == 0 || shelf->lastUsed >= cache->frame) continue;
+        if (best < 0 || shelf->lastUsed < cache->shelves[best].lastUsed) best = (int32_t)s;
+    }
+    return best;
+}
+
+// Frees at least minHeight rows by evicting the run of adjacent shelves (in y
+// order, plus any unallocated space below the last one) whose most recent use
+// is oldest. The run becomes one shelf; the others are left dead (height 0)
+// so entry shelf indices stay valid. Returns the merged shelf or -1.
+static int32_t evict_run(GlyphCache* cache, uint32_t minHeight) {
+    int32_t bestFirst = -1, bestLast = -1;
+    uint64_t bestAge = 0;
+    for (uint32_t first = 0; first < cache->shelfCount; first++) {
+        if (cache->shelves[first].height == 0) continue;
+        uint32_t total = 0;
+        uint64_t age = 0;
+        for (uint32_t last = first; last < cache->shelfCount; last++) {
+            const GlyphShelf* shelf = &cache->shelves[last];
+            if (shelf->height == 0) continue;
+            if (shelf->lastUsed >= cache->frame) break; // In use this frame
+            total += shelf->height;
+            if (shelf->lastUsed > age) age = shelf->lastUsed;
+            uint32_t tail = (last + 1 == cache->shelfCount) ? cache->height - cache->nextShelfY : 0;
+            if (total + tail >= minHeight) {
+                if (bestFirst < 0 || age < bestAge) {
+                    bestFirst = (int32_t)first;
+                    bestLast = (int32_t)last;
+                    bestAge = age;
+                }
+                break;
+            }
+        }
+    }
+    if (bestFirst < 0) {
+        return -1;
+    }
+
+    GlyphShelf* merged = &cache->shelves[bestFirst];
+    uint32_t total = 0;
+    for (int32_t s = bestFirst; s <= bestLast; s++) {
+        if (cache->shelves[s].height == 0) continue;
+        evict_shelf(cache, s);
+        total += cache->shelves[s].height;
+        if (s != bestFirst) cache->shelves[s].height = 0;
+    }
+    if (bestLast + 1 == (int32_t)cache->shelfCount) {
+        total += cache->height - cache->nextShelfY;
+        cache->nextShelfY = cache->height;
+    }
+    merged->height = (uint16_t)total;
+    return bestFirst;
+}
+
+// Finds room for a width x height cell; returns the shelf or -1
+static int32_t place(GlyphCache* cache, uint32_t width, uint32_t height, uint32_t* outX) {
+    // Tightest existing shelf, first without wasting more than half the glyph height
+    for (int pass = 0; pass < 2; pass++) {
+        int32_t best = -1;
+        for (uint32_t s = 0; s < cache->shelfCount; s++) {
+            const GlyphShelf* shelf = &cache->shelves[s];
+            if (shelf->height < height || cache->width - shelf->cursorX < width) continue;
+            if (pass == 0 && shelf->height > height + height / 2) continue;
+            if (best < 0 || shelf->height < cache->shelves[best].height) best = (int32_t)s;
+        }
+        if (best >= 0) {
+            *outX = cache->shelves[best].cursorX;
+            cache->shelves[best].cursorX += width;
+            return best;
+        }
+        // Before settling for a loose fit, open a new shelf if there is room
+        uint32_t shelfHeight = (height + 3) & ~3u; // Lets similar sizes share shelves
+        if (pass == 0 && cache->shelfCount < VSDL_GLYPH_CACHE_MAX_SHELVES && cache->nextShelfY + shelfHeight <= cache->height &&
+            width <= cache->width) {
+            GlyphShelf* shelf = &cache->shelves[cache->shelfCount];
+            shelf->y = (uint16_t)cache->nextShelfY;
+            shelf->height = (uint16_t)shelfHeight;
+            shelf->cursorX = (uint16_t)width;
+            shelf->lastUsed = 0;
+            cache->nextShelfY += shelfHeight;
+            *outX = 0;
+            return (int32_t)cache->shelfCount++;
+        }
+    }
+
+    // Atlas full: recycle the least recently used shelves
+    if (width > cache->width) {
+        return -1;
+    }
+    int32_t victim = evict_run(cache, height);
+    if (victim < 0) {
+        return -1;
+    }
+    *outX = 0;
+    cache->shelves[victim].cursorX = (uint16_t)width;
+    return victim;
+}
+
+const GlyphEntry* vsdl_glyph_cache_insert(GlyphCache* cache, GlyphKey key, const uint8_t* bitmap, uint32_t width,
+                                          uint32_t height, int32_t pitch, int32_t bearingX, int32_t bearingY, float advance) {
+    if (cache->freeList < 0) {
+        int32_t victim = lru_shelf(cache);
+        if (victim >= 0) evict_shelf(cache, victim);
+        if (cache->freeList < 0) {
+            vsdl_log("Glyph cache full (%u glyphs)\n", cache->glyphCount);
+            return NULL;
+        }
+    }
+
+    int32_t shelf = -1;
+    uint32_t cellX = 0;
+    if (width > 0 && height > 0) {
+        uint32_t cellWidth = width + 2 * VSDL_GLYPH_PADDING;
+        uint32_t cellHeight = height + 2 * VSDL_GLYPH_PADDING;
+        shelf = place(cache, cellWidth, cellHeight, &cellX);
+        if (shelf < 0) {
+            vsdl_log("Glyph atlas full, cannot fit %ux%u glyph\n", width, height);
+            return NULL;
+        }
+
+        // Clear the whole cell column so remnants of evicted glyphs cannot bleed in
+        const GlyphShelf* s = &cache->shelves[shelf];
+        for (uint32_t y = 0; y < s->height; y++) {
+            memset(cache->pixels + (size_t)(s->y + y) * cache->width + cellX, 0, cellWidth);
+        }
+        uint8_t* dst = cache->pixels + (size_t)(s->y + VSDL_GLYPH_PADDING) * cache->width + cellX + VSDL_GLYPH_PADDING;
+        for (uint32_t y = 0; y < height; y++) {
+            memcpy(dst + (size_t)y * cache->width, bitmap + (ptrdiff_t)y * pitch, width);
+        }
+        mark_dirty(cache, cellX, s->y, cellWidth, s->height);
+    }
+
+    int32_t index = cache->freeList;
+    GlyphEntry* entry = &cache->entries[index];
+    cache->freeList = entry->next;
+
+    entry->key = key;
+    entry->x = (uint16_t)(cellX + VSDL_GLYPH_PADDING);
+    entry->y = shelf >= 0 ? (uint16_t)(cache->shelves[shelf].y + VSDL_GLYPH_PADDING) : 0;
+    entry->width = (uint16_t)width;
+    entry->height = (uint16_t)height;
+    entry->bearingX = (int16_t)bearingX;
+    entry->bearingY = (int16_t)bearingY;
+    entry->advance = advance;
+    entry->shelf = shelf;
+    entry->used = true;
+
+    uint32_t bucket = hash_key(key);
+    entry->next = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+    cache->glyphCount++;
+    touch(cache, entry);
+    return entry;
+}
+
+const GlyphEntry* vsdl_glyph_cache_get(GlyphCache* cache, FT_Face face, uint32_t faceId, uint32_t pixelSize,
+                                       uint32_t glyphIndex, FT_Render_Mode renderMode) {
+    GlyphKey key = {faceId, pixelSize, glyphIndex, (uint32_t)renderMode};
+    const GlyphEntry* entry = vsdl_glyph_cache_find(cache, key);
+    if (entry) {
+        return entry;
+    }
+
+    if (face->size->metrics.y_ppem != pixelSize) {
+        FT_Set_Pixel_Sizes(face, 0, pixelSize);
+    }
+    if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT) != 0 || FT_Render_Glyph(face->glyph, renderMode) != 0) {
+        vsdl_log("Failed to rasterize glyph %u (render mode %d)\n", glyphIndex, (int)renderMode);
+        return NULL;
+    }
+    FT_GlyphSlot slot = face->glyph;
+    return vsdl_glyph_cache_insert(cache, key, slot->bitmap.buffer, slot->bitmap.width, slot->bitmap.rows,
+                                   slot->bitmap.pitch, slot->bitmap_left, slot->bitmap_top, slot->advance.x / 64.0f);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "vsdl_glyph_raster.h"
+#include "vsdl_log.h"
+#include FT_MODULE_H
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    GlyphRasterPool* pool;
+    const uint32_t* codepoints;
+    RasterizedGlyph* out;
+    uint32_t begin, end;
+} RasterChunk;
+
+/**
+ * Opens one library and face per worker at the requested size
+ */
+void vsdl_glyph_raster_init(GlyphRasterPool* pool, JobSystem* jobs, const char* fontPath, uint32_t pixelSize,
+                            FT_Render_Mode renderMode) {
+    memset(pool, 0, sizeof(*pool));
+    pool->jobs = jobs;
+    pool->pixelSize = pixelSize;
+    pool->renderMode = renderMode;
+
+    FT_Int spread = VSDL_GLYPH_SDF_SPREAD;
+    for (uint32_t i = 0; i < jobs->workerCount; i++) {
+        if (FT_Init_FreeType(&pool->libraries[i]) != 0) {
+            vsdl_log("Failed to initialize FreeType for worker %u\n", i);
+            exit(1);
+        }
+        FT_Property_Set(pool->libraries[i], "sdf", "spread", &spread);
+        FT_Property_Set(pool->libraries[i], "bsdf", "spread", &spread);
+        if (FT_New_Face(pool->libraries[i], fontPath, 0, &pool->faces[i]) != 0) {
+            vsdl_log("Failed to load font %s for worker %u\n", fontPath, i);
+            exit(1);
+        }
+        FT_Set_Pixel_Sizes(pool->faces[i], 0, pixelSize);
+    }
+}
+
+void vsdl_glyph_raster_destroy(GlyphRasterPool* pool) {
+    for (uint32_t i = 0; i < pool->jobs->workerCount; i++) {
+        FT_Done_Face(pool->faces[i]);
+        FT_Done_FreeType(pool->libraries[i]);
+    }
+    memset(pool, 0, sizeof(*pool));
+}
+
+static void raster_chunk(void* data, uint32_t workerIndex) {
+    RasterChunk* chunk = data;
+    FT_Face face = chunk->pool->faces[workerIndex];
+
+    for (uint32_t i = chunk->begin; i < chunk->end; i++) {
+        RasterizedGlyph* glyph = &chunk->out[i];
+        memset(glyph, 0, sizeof(*glyph));
+        glyph->codepoint = chunk->codepoints[i];
+        glyph->glyphIndex = FT_Get_Char_Index(face, glyph->codepoint);
+        if (glyph->glyphIndex == 0 ||
+            FT_Load_Glyph(face, glyph->glyphIndex, FT_LOAD_DEFAULT) != 0 ||
+            FT_Render_Glyph(face->glyph, chunk->pool->renderMode) != 0) {
+            continue;
+        }
+
+        FT_GlyphSlot slot = face->glyph;
+        glyph->width = (uint16_t)slot->bitmap.width;
+        glyph->height = (uint16_t)slot->bitmap.rows;
+        glyph->bearingX = (int16_t)slot->bitmap_left;
+        glyph->bearingY = (int16_t)slot->bitmap_top;
+        glyph->advance = slot->advance.x / 64.0f;
+        if (glyph->width > 0 && glyph->height > 0) {
+            glyph->pixels = malloc((size_t)glyph->width * glyph->height);
+            if (!glyph->pixels) continue;
+            // The slot bitmap is overwritten by the next glyph, so keep a tightly packed copy
+            for (uint32_t row = 0; row < glyph->height; row++) {
+                memcpy(glyph->pixels + (size_t)row * glyph->width,
+                       slot->bitmap.buffer + (ptrdiff_t)row * slot->bitmap.pitch, glyph->width);
+            }
+        }
+        glyph->ok = true;
+    }
+}
+
+void vsdl_glyph_raster_run(GlyphRasterPool* pool, const uint32_t* codepoints, uint32_t count, RasterizedGlyph* out) {
+    uint32_t chunkCount = (count + VSDL_GLYPH_RASTER_CHUNK - 1) / VSDL_GLYPH_RASTER_CHUNK;
+    RasterChunk* chunks = malloc(chunkCount * sizeof(RasterChunk));
+    if (!chunks) {
+        vsdl_log("Failed to allocate glyph raster jobs\n");
+        exit(1);
+    }
+
+    SDL_AtomicInt remaining;
+    SDL_SetAtomicInt(&remaining, 0);
+    for (uint32_t c = 0; c < chunkCount; c++) {
+        chunks[c].pool = pool;
+        chunks[c].codepoints = codepoints;
+        chunks[c].out = out;
+        chunks[c].begin = c * VSDL_GLYPH_RASTER_CHUNK;
+        chunks[c].end = SDL_min(count, chunks[c].begin + VSDL_GLYPH_RASTER_CHUNK);
+        vsdl_jobs_submit(pool->jobs, raster_chunk, &chunks[c], &remaining);
+    }
+    vsdl_jobs_wait(pool->jobs, &remaining);
+    free(chunks);
+}
+
+uint32_t vsdl_glyph_raster_insert(const GlyphRasterPool* pool, GlyphCache* cache, uint32_t faceId,
+                                  const RasterizedGlyph* glyphs, uint32_t count) {
+    uint32_t inserted = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const RasterizedGlyph* glyph = &glyphs[i];
+        if (!glyph->ok) continue;
+        GlyphKey key = {faceId, pool->pixelSize, glyph->glyphIndex, (uint32_t)pool->renderMode};
+        if (vsdl_glyph_cache_find(cache, key)) continue;
+        if (!vsdl_glyph_cache_insert(cache, key, glyph->pixels, glyph->width, glyph->height, glyph->width,
+                                     glyph->bearingX, glyph->bearingY, glyph->advance)) {
+            break; // Atlas full of glyphs used this frame
+        }
+        inserted++;
+    }
+    return inserted;
+}
+
+void vsdl_glyph_raster_free(RasterizedGlyph* glyphs, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        free(glyphs[i].pixels);
+        glyphs[i].pixels = NULL;
+    }
+}
\ No newline at end of file
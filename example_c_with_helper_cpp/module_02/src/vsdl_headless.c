@@ -0,0 +1,265 @@
+#include "vsdl_headless.h"
+#include "vsdl_log.h"
+#include "vsdl_vulkan_init.h" // For allocator
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WIDTH 800  // Same as the window and render pass extent
+#define HEIGHT 600
+#define HEADLESS_FORMAT VK_FORMAT_B8G8R8A8_UNORM // Same as the swapchain and render pass format
+
+void vsdl_headless_init(VulkanContext* vkCtx, uint32_t imageCount, bool readback) {
+  HeadlessTarget* target = &vkCtx->headlessTarget;
+  vkCtx->imageCount = imageCount;
+  vkCtx->swapchainImages = calloc(imageCount, sizeof(VkImage));
+  vkCtx->swapchainImageViews = calloc(imageCount, sizeof(VkImageView));
+  target->allocations = calloc(imageCount, sizeof(VmaAllocation));
+  if (!vkCtx->swapchainImages || !vkCtx->swapchainImageViews || !target->allocations) {
+      vsdl_log("Failed to allocate headless image arrays\n");
+      exit(1);
+  }
+
+  for (uint32_t i = 0; i < imageCount; i++) {
+      VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+      imageInfo.imageType = VK_IMAGE_TYPE_2D;
+      imageInfo.format = HEADLESS_FORMAT;
+      imageInfo.extent = (VkExtent3D){WIDTH, HEIGHT, 1};
+      imageInfo.mipLevels = 1;
+      imageInfo.arrayLayers = 1;
+      imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+      imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+      // Color attachment of the render pass, copy source for readback
+      imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+      imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+      imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+      VmaAllocationCreateInfo allocInfo = {0};
+      allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+      if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &vkCtx->swapchainImages[i], &target->allocations[i], NULL) != VK_SUCCESS) {
+          vsdl_log("Failed to create headless image %u\n", i);
+          exit(1);
+      }
+
+      VkImageViewCreateInfo viewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+      viewInfo.image = vkCtx->swapchainImages[i];
+      viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+      viewInfo.format = HEADLESS_FORMAT;
+      viewInfo.subresourceRange = (VkImageSubresourceRange){VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+      if (vkCreateImageView(vkCtx->device, &viewInfo, NULL, &vkCtx->swapchainImageViews[i]) != VK_SUCCESS) {
+          vsdl_log("Failed to create headless image view %u\n", i);
+          exit(1);
+      }
+  }
+
+  if (readback) {
+      VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+      bufferInfo.size = (VkDeviceSize)WIDTH * HEIGHT * 4;
+      bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+      bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+      VmaAllocationCreateInfo allocInfo = {0};
+      allocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+      allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+      VmaAllocationInfo info;
+      if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &target->readbackBuffer, &target->readbackAllocation, &info) != VK_SUCCESS) {
+          vsdl_log("Failed to create readback buffer\n");
+          exit(1);
+      }
+      target->readbackMapped = info.pMappedData;
+  }
+
+  vsdl_log("Headless target created: %u images %ux%u%s\n", imageCount, WIDTH, HEIGHT, readback ? " with readback" : "");
+}
+
+void vsdl_headless_destroy(VulkanContext* vkCtx) {
+  HeadlessTarget* target = &vkCtx->headlessTarget;
+  for (uint32_t i = 0; i < vkCtx->imageCount; i++) {
+      vkDestroyImageView(vkCtx->device, vkCtx->swapchainImageViews[i], NULL);
+      vmaDestroyImage(allocator, vkCtx->swapchainImages[i], target->allocations[i]);
+  }
+  free(vkCtx->swapchainImageViews);
+  free(vkCtx->swapchainImages);
+  free(target->allocations);
+  vkCtx->swapchainImageViews = NULL;
+  vkCtx->swapchainImages = NULL;
+  vkCtx->imageCount = 0;
+  if (target->readbackBuffer) {
+      vmaDestroyBuffer(allocator, target->readbackBuffer, target->readbackAllocation);
+  }
+  memset(target, 0, sizeof(*target));
+}
+
+uint32_t vsdl_headless_acquire(VulkanContext* vkCtx) {
+  HeadlessTarget* target = &vkCtx->headlessTarget;
+  uint32_t imageIndex = target->nextImage;
+  target->nextImage = (target->nextImage + 1) % vkCtx->imageCount;
+  return imageIndex;
+}
+
+/**
+ * Binary PPM (P6): trivial to write and read back, and viewable everywhere
+ */
+static bool write_ppm(const char* path, const uint8_t* rgb, uint32_t width, uint32_t height) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+      vsdl_log("Failed to open %s for writing\n", path);
+      return false;
+  }
+  fprintf(file, "P6\n%u %u\n255\n", width, height);
+  size_t size = (size_t)width * height * 3;
+  bool ok = fwrite(rgb, 1, size, file) == size;
+  return fclose(file) == 0 && ok;
+}
+
+/**
+ * Reads a P6 PPM with 8-bit channels; the caller frees *outRgb
+ */
+static bool read_ppm(const char* path, uint8_t** outRgb, uint32_t* width, uint32_t* height) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+      return false;
+  }
+  char magic[3] = {0};
+  uint32_t maxValue = 0;
+  bool ok = fscanf(file, "%2s %u %u %u", magic, width, height, &maxValue) == 4 && strcmp(magic, "P6") == 0 &&
+            maxValue == 255;
+  size_t size = (size_t)*width * *height * 3;
+  uint8_t* rgb = ok ? malloc(size) : NULL;
+  // Single whitespace byte before the pixel data
+  ok = rgb && fgetc(file) != EOF && fread(rgb, 1, size, file) == size;
+  fclose(file);
+  if (!ok) {
+      free(rgb);
+      return false;
+  }
+  *outRgb = rgb;
+  return true;
+}
+
+static bool compare_golden(const uint8_t* rgb, const char* goldenPath, uint32_t tolerance) {
+  uint8_t* golden = NULL;
+  uint32_t width = 0, height = 0;
+  if (!read_ppm(goldenPath, &golden, &width, &height)) {
+      vsdl_log("Failed to read golden image %s\n", goldenPath);
+      return false;
+  }
+  if (width != WIDTH || height != HEIGHT) {
+      vsdl_log("Golden image is %ux%u, frame is %ux%u\n", width, height, WIDTH, HEIGHT);
+      free(golden);
+      return false;
+  }
+
+  size_t pixelCount = (size_t)width * height;
+  size_t differing = 0;
+  int maxDelta = 0;
+  for (size_t i = 0; i < pixelCount; i++) {
+      int pixelDelta = 0;
+      for (size_t c = 0; c < 3; c++) {
+          pixelDelta = SDL_max(pixelDelta, SDL_abs((int)rgb[i * 3 + c] - (int)golden[i * 3 + c]));
+      }
+      maxDelta = SDL_max(maxDelta, pixelDelta);
+      if (pixelDelta > (int)tolerance) {
+          differing++;
+      }
+  }
+  free(golden);
+  bool match = differing <= (size_t)(pixelCount * VSDL_GOLDEN_MAX_DIFF_FRACTION);
+  vsdl_log("[bench] golden %s: %zu of %zu pixels differ by more than %u (max delta %d)\n",
+           match ? "match" : "MISMATCH", differing, pixelCount, tolerance, maxDelta);
+  return match;
+}
+
+bool vsdl_headless_readback(VulkanContext* vkCtx, uint32_t imageIndex, const char* readbackPath,
+                            const char* goldenPath, uint32_t tolerance) {
+  HeadlessTarget* target = &vkCtx->headlessTarget;
+  if (!target->readbackBuffer) {
+      return true;
+  }
+
+  VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+  allocInfo.commandPool = vkCtx->commandPool;
+  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.commandBufferCount = 1;
+  VkCommandBuffer commandBuffer;
+  if (vkAllocateCommandBuffers(vkCtx->device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+      vsdl_log("Failed to allocate readback command buffer\n");
+      return false;
+  }
+
+  VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+  // Make the render pass writes visible to the copy; waiting idle only orders
+  // execution, it makes nothing visible
+  VkImageMemoryBarrier imageBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+  imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  imageBarrier.image = vkCtx->swapchainImages[imageIndex];
+  imageBarrier.subresourceRange = (VkImageSubresourceRange){VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                       0, NULL, 0, NULL, 1, &imageBarrier);
+
+  VkBufferImageCopy region = {0};
+  region.imageSubresource = (VkImageSubresourceLayers){VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.imageExtent = (VkExtent3D){WIDTH, HEIGHT, 1};
+  vkCmdCopyImageToBuffer(commandBuffer, vkCtx->swapchainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         target->readbackBuffer, 1, &region);
+
+  VkBufferMemoryBarrier barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.buffer = target->readbackBuffer;
+  barrier.size = VK_WHOLE_SIZE;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                       0, NULL, 1, &barrier, 0, NULL);
+  vkEndCommandBuffer(commandBuffer);
+
+  // One copy at shutdown, outside the measured frames; waiting idle is fine here
+  VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &commandBuffer;
+  bool submitted = vkQueueSubmit(vkCtx->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS &&
+                   vkQueueWaitIdle(vkCtx->graphicsQueue) == VK_SUCCESS;
+  vkFreeCommandBuffers(vkCtx->device, vkCtx->commandPool, 1, &commandBuffer);
+  if (!submitted) {
+      vsdl_log("Failed to read back headless image\n");
+      return false;
+  }
+  vmaInvalidateAllocation(allocator, target->readbackAllocation, 0, VK_WHOLE_SIZE);
+
+  // BGRA -> RGB
+  size_t pixelCount = (size_t)WIDTH * HEIGHT;
+  uint8_t* rgb = malloc(pixelCount * 3);
+  if (!rgb) {
+      vsdl_log("Failed to allocate readback pixels\n");
+      return false;
+  }
+  for (size_t i = 0; i < pixelCount; i++) {
+      rgb[i * 3 + 0] = target->readbackMapped[i * 4 + 2];
+      rgb[i * 3 + 1] = target->readbackMapped[i * 4 + 1];
+      rgb[i * 3 + 2] = target->readbackMapped[i * 4 + 0];
+  }
+
+  bool ok = true;
+  if (readbackPath) {
+      if (write_ppm(readbackPath, rgb, WIDTH, HEIGHT)) {
+          vsdl_log("Headless frame written to %s\n", readbackPath);
+      } else {
+          ok = false;
+      }
+  }
+  if (goldenPath) {
+      ok = compare_golden(rgb, goldenPath, tolerance) && ok;
+  }
+  free(rgb);
+  return ok;
+}
@@ -0,0 +1,161 @@
+#include "vsdl_jobs.h"
+#include "vsdl_log.h"
+#include <stdlib.h>
+
+static bool queue_push(JobQueue* queue, Job job) {
+    bool pushed = false;
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->bottom - queue->top < VSDL_JOBS_QUEUE_SIZE) {
+        queue->jobs[queue->bottom & (VSDL_JOBS_QUEUE_SIZE - 1)] = job;
+        queue->bottom++;
+        pushed = true;
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+    return pushed;
+}
+
+static bool queue_pop(JobQueue* queue, Job* job) {
+    bool popped = false;
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->bottom != queue->top) {
+        queue->bottom--;
+        *job = queue->jobs[queue->bottom & (VSDL_JOBS_QUEUE_SIZE - 1)];
+        popped = true;
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+    return popped;
+}
+
+static bool queue_steal(JobQueue* queue, Job* job) {
+    bool stolen = false;
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->bottom != queue->top) {
+        *job = queue->jobs[queue->top & (VSDL_JOBS_QUEUE_SIZE - 1)];
+        queue->top++;
+        stolen = true;
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+    return stolen;
+}
+
+static void run_job(Job* job, uint32_t workerIndex) {
+    job->func(job->data, workerIndex);
+    if (job->counter) {
+        SDL_AddAtomicInt(job->counter, -1);
+    }
+}
+
+// Own deque first, then the others starting after our own slot
+static bool find_job(JobSystem* jobs, uint32_t workerIndex, Job* job) {
+    if (queue_pop(&jobs->queues[workerIndex], job)) {
+        SDL_AddAtomicInt(&jobs->pending, -1);
+        return true;
+    }
+    for (uint32_t i = 1; i < jobs->workerCount; i++) {
+        uint32_t victim = (workerIndex + i) % jobs->workerCount;
+        if (queue_steal(&jobs->queues[victim], job)) {
+            SDL_AddAtomicInt(&jobs->pending, -1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static int worker_main(void* data) {
+    JobWorker* worker = data;
+    JobSystem* jobs = worker->system;
+    Job job;
+    while (!SDL_GetAtomicInt(&jobs->quit)) {
+        if (find_job(jobs, worker->index, &job)) {
+            run_job(&job, worker->index);
+            continue;
+        }
+        // pending is raised before submit signals under this mutex, so no wakeup is lost
+        SDL_LockMutex(jobs->sleepMutex);
+        while (SDL_GetAtomicInt(&jobs->pending) == 0 && !SDL_GetAtomicInt(&jobs->quit)) {
+            SDL_WaitCondition(jobs->wake, jobs->sleepMutex);
+        }
+        SDL_UnlockMutex(jobs->sleepMutex);
+    }
+    return 0;
+}
+
+/**
+ * Starts workerCount - 1 threads; the calling thread acts as worker 0 inside vsdl_jobs_wait
+ */
+void vsdl_jobs_init(JobSystem* jobs, uint32_t workerCount) {
+    SDL_zerop(jobs);
+    if (workerCount == 0) {
+        workerCount = (uint32_t)SDL_GetNumLogicalCPUCores();
+    }
+    if (workerCount < 1) workerCount = 1;
+    if (workerCount > VSDL_JOBS_MAX_WORKERS) workerCount = VSDL_JOBS_MAX_WORKERS;
+    jobs->workerCount = workerCount;
+
+    jobs->queues = calloc(workerCount, sizeof(JobQueue));
+    jobs->sleepMutex = SDL_CreateMutex();
+    jobs->wake = SDL_CreateCondition();
+    if (!jobs->queues || !jobs->sleepMutex || !jobs->wake) {
+        vsdl_log("Failed to create job system: %s\n", SDL_GetError());
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < workerCount; i++) {
+        jobs->workers[i].system = jobs;
+        jobs->workers[i].index = i;
+    }
+    for (uint32_t i = 1; i < workerCount; i++) {
+        jobs->threads[i] = SDL_CreateThread(worker_main, "vsdl_job_worker", &jobs->workers[i]);
+        if (!jobs->threads[i]) {
+            vsdl_log("Failed to create job worker %u: %s\n", i, SDL_GetError());
+            exit(1);
+        }
+    }
+    vsdl_log("Job system started with %u workers\n", workerCount);
+}
+
+void vsdl_jobs_shutdown(JobSystem* jobs) {
+    SDL_LockMutex(jobs->sleepMutex);
+    SDL_SetAtomicInt(&jobs->quit, 1);
+    SDL_BroadcastCondition(jobs->wake);
+    SDL_UnlockMutex(jobs->sleepMutex);
+    for (uint32_t i = 1; i < jobs->workerCount; i++) {
+        SDL_WaitThread(jobs->threads[i], NULL);
+    }
+    SDL_DestroyCondition(jobs->wake);
+    SDL_DestroyMutex(jobs->sleepMutex);
+    free(jobs->queues);
+    SDL_zerop(jobs);
+}
+
+void vsdl_jobs_submit(JobSystem* jobs, JobFunc func, void* data, SDL_AtomicInt* counter) {
+    Job job = {func, data, counter};
+    if (counter) {
+        SDL_AddAtomicInt(counter, 1);
+    }
+
+    // Raised before the push so a thief can never take pending below zero
+    SDL_AddAtomicInt(&jobs->pending, 1);
+    uint32_t start = (uint32_t)SDL_AddAtomicInt(&jobs->nextQueue, 1);
+    for (uint32_t i = 0; i < jobs->workerCount; i++) {
+        if (queue_push(&jobs->queues[(start + i) % jobs->workerCount], job)) {
+            SDL_LockMutex(jobs->sleepMutex);
+            SDL_SignalCondition(jobs->wake);
+            SDL_UnlockMutex(jobs->sleepMutex);
+            return;
+        }
+    }
+    SDL_AddAtomicInt(&jobs->pending, -1);
+    run_job(&job, 0); // Every deque is full: run it here rather than drop it
+}
+
+void vsdl_jobs_wait(JobSystem* jobs, SDL_AtomicInt* counter) {
+    Job job;
+    while (SDL_GetAtomicInt(counter) > 0) {
+        if (find_job(jobs, 0, &job)) {
+            run_job(&job, 0);
+        } else {
+            SDL_CPUPauseInstruction(); // Remaining jobs are running on other workers
+        }
+    }
+}
\ No newline at end of file
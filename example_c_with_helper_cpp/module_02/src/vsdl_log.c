@@ -1,58 +1,286 @@
 #include "vsdl_log.h"
+#include <SDL3/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#define VSDL_LOG_RING_SIZE 4096  // Records, power of two
+#define VSDL_LOG_RECORD_TEXT 240 // Longer messages are truncated
+#define VSDL_LOG_BATCH_BYTES (64 * 1024)
+#define VSDL_LOG_IDLE_MS 10      // Writer wakes at least this often to drain routine messages
+
+// Slot of a bounded multi-producer ring: sequence == ticket means free for the
+// producer holding that ticket, ticket + 1 means filled and ready to write out
+typedef struct {
+    SDL_AtomicInt sequence;
+    int level;
+    int length;
+    char text[VSDL_LOG_RECORD_TEXT];
+} LogRecord;
+
+static LogRecord ring[VSDL_LOG_RING_SIZE];
+static SDL_AtomicInt head;    // Next ticket handed to a producer
+static uint32_t tail;         // Next ticket the writer thread reads
+static SDL_AtomicInt dropped; // Messages lost to a full ring
+static SDL_AtomicInt quit;
+static SDL_AtomicInt fileOutputEnabled;
+static SDL_AtomicInt closeRequested; // Writer closes logFile after its next drain
+static SDL_AtomicInt writerState;    // One of the WRITER_* values below
+static SDL_AtomicInt producers;      // log_va calls currently using the ring
+static SDL_AtomicInt minLevel;       // Zero, i.e. VSDL_LOG_LEVEL_TRACE, until set
+static SDL_Semaphore* wake = NULL;
+static SDL_Thread* writerThread = NULL;
 static FILE* logFile = NULL;
-static bool fileOutputEnabled = false;
+
+// Producers enqueue only while the writer is RUNNING. STOPPING covers the
+// shutdown window in which the writer still owns logFile; NONE means callers
+// write synchronously (before init, after cleanup, or without a thread).
+enum { WRITER_NONE, WRITER_RUNNING, WRITER_STOPPING };
+
+static const char* level_prefix(int level) {
+    switch (level) {
+        case VSDL_LOG_LEVEL_WARN: return "[warn] ";
+        case VSDL_LOG_LEVEL_ERROR: return "[error] ";
+        default: return "";
+    }
+}
+
+static void write_out(const char* text, size_t length) {
+    fwrite(text, 1, length, stdout);
+    if (SDL_GetAtomicInt(&fileOutputEnabled)) {
+        if (!logFile) {
+            logFile = fopen("debug.log", "a"); // Reopen in append mode if previously closed
+            if (!logFile) {
+                fprintf(stderr, "Failed to reopen log file\n");
+                SDL_SetAtomicInt(&fileOutputEnabled, 0);
+            }
+        }
+        if (logFile) {
+            fwrite(text, 1, length, logFile);
+        }
+    }
+}
+
+// Moves every ready record into one buffer and writes it with a single call per sink
+static void drain(void) {
+    static char batch[VSDL_LOG_BATCH_BYTES];
+    size_t used = 0;
+
+    for (;;) {
+        LogRecord* record = &ring[tail & (VSDL_LOG_RING_SIZE - 1)];
+        if ((uint32_t)SDL_GetAtomicInt(&record->sequence) != tail + 1) {
+            break; // Empty, or the producer holding this ticket is still formatting
+        }
+        const char* prefix = level_prefix(record->level);
+        size_t prefixLength = strlen(prefix);
+        if (used + prefixLength + (size_t)record->length > sizeof(batch)) {
+            write_out(batch, used);
+            used = 0;
+        }
+        memcpy(batch + used, prefix, prefixLength);
+        memcpy(batch + used + prefixLength, record->text, (size_t)record->length);
+        used += prefixLength + (size_t)record->length;
+
+        SDL_SetAtomicInt(&record->sequence, (int)(tail + VSDL_LOG_RING_SIZE)); // Free for the next lap
+        tail++;
+    }
+
+    int lost = SDL_SetAtomicInt(&dropped, 0);
+    if (lost > 0) {
+        char notice[64];
+        int noticeLength = snprintf(notice, sizeof(notice), "[log] ring full, dropped %d messages\n", lost);
+        if (used + (size_t)noticeLength > sizeof(batch)) {
+            write_out(batch, used);
+            used = 0;
+        }
+        memcpy(batch + used, notice, (size_t)noticeLength);
+        used += (size_t)noticeLength;
+    }
+    if (used > 0) {
+        write_out(batch, used);
+        fflush(stdout);
+        if (logFile) fflush(logFile);
+    }
+}
+
+static void close_if_requested(void) {
+    if (SDL_CompareAndSwapAtomicInt(&closeRequested, 1, 0)) {
+        SDL_SetAtomicInt(&fileOutputEnabled, 0);
+        if (logFile) {
+            fclose(logFile);
+            logFile = NULL;
+        }
+    }
+}
+
+static int writer_main(void* data) {
+    (void)data;
+    while (!SDL_GetAtomicInt(&quit)) {
+        SDL_WaitSemaphoreTimeout(wake, VSDL_LOG_IDLE_MS);
+        drain();
+        close_if_requested(); // Messages logged before the toggle still reach the file
+    }
+    drain();
+    close_if_requested();
+    return 0;
+}
 
 void vsdl_init_log(const char* filename, bool enableFileOutput) {
-    fileOutputEnabled = enableFileOutput;
-    if (fileOutputEnabled) {
+    SDL_SetAtomicInt(&fileOutputEnabled, enableFileOutput);
+    if (enableFileOutput) {
         logFile = fopen(filename, "w");
         if (!logFile) {
             fprintf(stderr, "Failed to open log file %s\n", filename);
-            fileOutputEnabled = false;
+            SDL_SetAtomicInt(&fileOutputEnabled, 0);
         } else {
             time_t now = time(NULL);
             fprintf(logFile, "Log started at %s", ctime(&now));
             fflush(logFile);
         }
     }
+
+    for (uint32_t i = 0; i < VSDL_LOG_RING_SIZE; i++) {
+        SDL_SetAtomicInt(&ring[i].sequence, (int)i);
+    }
+    SDL_SetAtomicInt(&head, 0);
+    tail = 0;
+    SDL_SetAtomicInt(&quit, 0);
+    SDL_SetAtomicInt(&closeRequested, 0);
+    wake = SDL_CreateSemaphore(0);
+    writerThread = wake ? SDL_CreateThread(writer_main, "vsdl_log", NULL) : NULL;
+    if (!writerThread) {
+        fprintf(stderr, "Failed to start log thread, logging synchronously: %s\n", SDL_GetError());
+    } else {
+        SDL_SetAtomicInt(&writerState, WRITER_RUNNING);
+    }
+
+    // Most fatal paths log and then call exit(1); drain the ring on the way out
+    static bool registered = false;
+    if (!registered) {
+        atexit(vsdl_cleanup_log);
+        registered = true;
+    }
 }
 
-void vsdl_log(const char* format, ...) {
-    va_list args;
-    va_start(args, format);
+static void log_va(int level, const char* format, va_list args) {
+    if (level < SDL_GetAtomicInt(&minLevel)) {
+        return;
+    }
+    // Registered before the state check so vsdl_cleanup_log can wait for us
+    SDL_AddAtomicInt(&producers, 1);
+    int state = SDL_GetAtomicInt(&writerState);
+    if (state != WRITER_RUNNING) {
+        SDL_AddAtomicInt(&producers, -1);
+        char text[VSDL_LOG_RECORD_TEXT + 16];
+        int prefixLength = snprintf(text, sizeof(text), "%s", level_prefix(level));
+        int length = vsnprintf(text + prefixLength, VSDL_LOG_RECORD_TEXT, format, args);
+        if (length < 0) return;
+        if (length >= VSDL_LOG_RECORD_TEXT) length = VSDL_LOG_RECORD_TEXT - 1;
+        if (state == WRITER_STOPPING) {
+            fwrite(text, 1, (size_t)(prefixLength + length), stdout); // logFile is still the writer's
+            return;
+        }
+        write_out(text, (size_t)(prefixLength + length));
+        if (logFile) fflush(logFile);
+        return;
+    }
 
-    // Print to stdout
-    vprintf(format, args);
+    // Claim a ticket; a slot still holding last lap's record means the ring is full
+    uint32_t ticket = (uint32_t)SDL_GetAtomicInt(&head);
+    LogRecord* record;
+    for (;;) {
+        record = &ring[ticket & (VSDL_LOG_RING_SIZE - 1)];
+        int diff = (int)((uint32_t)SDL_GetAtomicInt(&record->sequence) - ticket);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicInt(&head, (int)ticket, (int)(ticket + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            SDL_SignalSemaphore(wake);
+            if (level < VSDL_LOG_LEVEL_WARN) {
+                SDL_AddAtomicInt(&dropped, 1); // Never block the frame path on I/O
+                SDL_AddAtomicInt(&producers, -1);
+                return;
+            }
+            SDL_Delay(0); // Warnings and errors wait for the writer instead of vanishing
+        }
+        ticket = (uint32_t)SDL_GetAtomicInt(&head);
+    }
+
+    int length = vsnprintf(record->text, sizeof(record->text), format, args);
+    if (length < 0) length = 0;
+    if (length >= (int)sizeof(record->text)) length = (int)sizeof(record->text) - 1;
+    record->level = level;
+    record->length = length;
+    SDL_SetAtomicInt(&record->sequence, (int)(ticket + 1)); // Publish
 
-    // Print to file if enabled
-    if (fileOutputEnabled && logFile) {
-        vfprintf(logFile, format, args);
-        fflush(logFile);
+    // Routine messages wait for the writer's next tick; problems are written promptly
+    if (level >= VSDL_LOG_LEVEL_WARN || (ticket & (VSDL_LOG_RING_SIZE / 2 - 1)) == 0) {
+        SDL_SignalSemaphore(wake);
     }
+    SDL_AddAtomicInt(&producers, -1);
+}
 
+void vsdl_log_write(int level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_va(level, format, args);
+    va_end(args);
+}
+
+void vsdl_log(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_va(VSDL_LOG_LEVEL_INFO, format, args);
     va_end(args);
 }
 
+void vsdl_log_set_level(int level) {
+    SDL_SetAtomicInt(&minLevel, level);
+}
+
 void vsdl_cleanup_log(void) {
+    if (writerThread) {
+        // Stop new records, then let in-flight ones publish before the final drain
+        SDL_SetAtomicInt(&writerState, WRITER_STOPPING);
+        while (SDL_GetAtomicInt(&producers) > 0) {
+            SDL_Delay(0);
+        }
+        SDL_SetAtomicInt(&quit, 1);
+        SDL_SignalSemaphore(wake);
+        SDL_WaitThread(writerThread, NULL);
+        writerThread = NULL;
+        SDL_DestroySemaphore(wake);
+        wake = NULL;
+    }
+    SDL_SetAtomicInt(&closeRequested, 0);
     if (logFile) {
         time_t now = time(NULL);
         fprintf(logFile, "Log ended at %s", ctime(&now));
         fclose(logFile);
         logFile = NULL;
     }
+    SDL_SetAtomicInt(&fileOutputEnabled, 0); // Late messages go to stdout only
+    SDL_SetAtomicInt(&writerState, WRITER_NONE);
 }
 
 void vsdl_toggle_log_file(bool enable) {
-    fileOutputEnabled = enable;
-    if (enable && !logFile) {
-        logFile = fopen("debug.log", "a"); // Reopen in append mode if previously closed
-        if (!logFile) {
-            fprintf(stderr, "Failed to reopen log file\n");
-            fileOutputEnabled = false;
+    if (SDL_GetAtomicInt(&writerState) != WRITER_RUNNING) {
+        SDL_SetAtomicInt(&fileOutputEnabled, enable);
+        if (!enable && logFile) {
+            fclose(logFile);
+            logFile = NULL;
         }
+        return;
+    }
+    // The writer thread owns logFile: it reopens it on its next batch, or
+    // closes it once what was logged before the toggle has been written
+    if (enable) {
+        SDL_SetAtomicInt(&closeRequested, 0);
+        SDL_SetAtomicInt(&fileOutputEnabled, 1);
+    } else {
+        SDL_SetAtomicInt(&closeRequested, 1);
+        SDL_SignalSemaphore(wake);
     }
 }
\ No newline at end of file
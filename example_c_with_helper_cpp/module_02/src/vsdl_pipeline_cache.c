@@ -0,0 +1,100 @@
+#include "vsdl_pipeline_cache.h"
+#include "vsdl_log.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Checks the header Vulkan puts at the start of every cache blob against the current device
+ */
+static bool vsdl_pipeline_cache_valid(VulkanContext* vkCtx, const unsigned char* data, size_t size) {
+  VkPipelineCacheHeaderVersionOne header;
+  if (size < sizeof(header)) {
+      return false;
+  }
+  memcpy(&header, data, sizeof(header));
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(vkCtx->physicalDevice, &properties);
+  return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+         header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+         memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+void vsdl_pipeline_cache_load(VulkanContext* vkCtx, const char* path) {
+  unsigned char* data = NULL;
+  size_t size = 0;
+
+  FILE* file = fopen(path, "rb");
+  if (file) {
+      fseek(file, 0, SEEK_END);
+      long fileSize = ftell(file);
+      fseek(file, 0, SEEK_SET);
+      if (fileSize > 0 && (data = malloc((size_t)fileSize)) != NULL) {
+          size = fread(data, 1, (size_t)fileSize, file);
+      }
+      fclose(file);
+      if (data && !vsdl_pipeline_cache_valid(vkCtx, data, size)) {
+          vsdl_log("Pipeline cache %s is from another device or driver, ignoring\n", path);
+          size = 0;
+      }
+  }
+
+  VkPipelineCacheCreateInfo cacheInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+  cacheInfo.initialDataSize = size;
+  cacheInfo.pInitialData = size > 0 ? data : NULL;
+  if (vkCreatePipelineCache(vkCtx->device, &cacheInfo, NULL, &vkCtx->pipelineCache) != VK_SUCCESS) {
+      // The driver rejected the data after all: start empty
+      cacheInfo.initialDataSize = 0;
+      cacheInfo.pInitialData = NULL;
+      size = 0;
+      if (vkCreatePipelineCache(vkCtx->device, &cacheInfo, NULL, &vkCtx->pipelineCache) != VK_SUCCESS) {
+          vsdl_log("Failed to create pipeline cache\n");
+          exit(1);
+      }
+  }
+  free(data);
+  vkCtx->pipelineCacheWarm = size > 0;
+  vkCtx->pipelineCacheUsed = false;
+  vkCtx->pipelineCacheLoadedBytes = size;
+  vsdl_log("Pipeline cache created (%s, %zu bytes loaded)\n", size > 0 ? "warm" : "cold", size);
+}
+
+void vsdl_pipeline_cache_save_and_destroy(VulkanContext* vkCtx, const char* path) {
+  if (!vkCtx->pipelineCache) {
+      return;
+  }
+
+  size_t size = 0;
+  void* data = NULL;
+  bool queried = vkGetPipelineCacheData(vkCtx->device, vkCtx->pipelineCache, &size, NULL) == VK_SUCCESS && size > 0;
+  // Nothing new to keep: rewriting would only risk replacing a warm cache
+  // with an emptier one, e.g. when startup failed before the pipelines
+  if (queried && (!vkCtx->pipelineCacheUsed || size <= vkCtx->pipelineCacheLoadedBytes)) {
+      vsdl_log("Pipeline cache unchanged, not saving\n");
+      queried = false;
+  }
+  if (queried && (data = malloc(size)) != NULL &&
+      vkGetPipelineCacheData(vkCtx->device, vkCtx->pipelineCache, &size, data) == VK_SUCCESS) {
+      // Write beside the old file and rename over it so a crash never leaves a truncated cache
+      char tempPath[512];
+      snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+      FILE* file = fopen(tempPath, "wb");
+      bool written = file && fwrite(data, 1, size, file) == size;
+      if (file && fclose(file) != 0) {
+          written = false;
+      }
+      if (written && SDL_RenamePath(tempPath, path)) {
+          vsdl_log("Pipeline cache saved (%zu bytes) to %s\n", size, path);
+      } else {
+          vsdl_log("Failed to save pipeline cache to %s\n", path);
+          SDL_RemovePath(tempPath);
+      }
+  }
+  free(data);
+
+  vkDestroyPipelineCache(vkCtx->device, vkCtx->pipelineCache, NULL);
+  vkCtx->pipelineCache = VK_NULL_HANDLE;
+}
\ No newline at end of file
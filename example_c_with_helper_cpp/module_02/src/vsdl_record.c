@@ -0,0 +1,211 @@
+#include "vsdl_record.h"
+#include "vsdl_render.h"
+#include "vsdl_text.h"
+#include "vsdl_log.h"
+#include <stdlib.h>
+
+// A contiguous range of the draw list recorded by one job into one secondary buffer
+typedef struct {
+    VulkanContext* vkCtx;
+    const VkCommandBufferInheritanceInfo* inheritance;
+    VkPipeline pipeline;
+    uint32_t first;
+    uint32_t count;
+    VkCommandBuffer* out; // Slot in recorder.secondaries, fixed by position rather than by which worker ran it
+} RecordChunk;
+
+// Next free secondary buffer of the worker's pool, allocated the first time a frame needs it
+static VkCommandBuffer acquire_secondary(VulkanContext* vkCtx, uint32_t workerIndex) {
+  RecordWorker* worker = &vkCtx->recorder.workers[workerIndex];
+  if (worker->usedCount == worker->bufferCount) {
+      VkCommandBuffer* buffers = realloc(worker->buffers, (worker->bufferCount + 1) * sizeof(VkCommandBuffer));
+      if (!buffers) {
+          vsdl_log("Failed to grow command buffer list of worker %u\n", workerIndex);
+          exit(1);
+      }
+      worker->buffers = buffers;
+
+      VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+      allocInfo.commandPool = worker->pool;
+      allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+      allocInfo.commandBufferCount = 1;
+      if (vkAllocateCommandBuffers(vkCtx->device, &allocInfo, &worker->buffers[worker->bufferCount]) != VK_SUCCESS) {
+          vsdl_log("Failed to allocate secondary command buffer for worker %u\n", workerIndex);
+          exit(1);
+      }
+      worker->bufferCount++;
+  }
+  return worker->buffers[worker->usedCount++];
+}
+
+static void begin_secondary(VkCommandBuffer commandBuffer, const VkCommandBufferInheritanceInfo* inheritance) {
+  VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+  beginInfo.pInheritanceInfo = inheritance;
+  if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+      vsdl_log("Failed to begin secondary command buffer\n");
+      exit(1);
+  }
+}
+
+static void end_secondary(VkCommandBuffer commandBuffer) {
+  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+      vsdl_log("Failed to end secondary command buffer\n");
+      exit(1);
+  }
+}
+
+static void record_chunk_job(void* data, uint32_t workerIndex) {
+  RecordChunk* chunk = data;
+  VkCommandBuffer commandBuffer = acquire_secondary(chunk->vkCtx, workerIndex);
+  begin_secondary(commandBuffer, chunk->inheritance);
+  vsdl_record_draws(chunk->vkCtx, commandBuffer, chunk->pipeline, chunk->first, chunk->count);
+  end_secondary(commandBuffer);
+  *chunk->out = commandBuffer;
+}
+
+void vsdl_record_init(VulkanContext* vkCtx, JobSystem* jobs) {
+  Recorder* recorder = &vkCtx->recorder;
+  recorder->jobs = jobs;
+  if (!vsdl_record_uses_secondaries(vkCtx)) {
+      vsdl_log("Command recording: inline on the main thread\n");
+      return;
+  }
+
+  VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; // Reset as a whole, never per buffer
+  poolInfo.queueFamilyIndex = vkCtx->graphicsQueueFamilyIndex;
+  for (uint32_t i = 0; i < jobs->workerCount; i++) {
+      if (vkCreateCommandPool(vkCtx->device, &poolInfo, NULL, &recorder->workers[i].pool) != VK_SUCCESS) {
+          vsdl_log("Failed to create command pool for worker %u\n", i);
+          exit(1);
+      }
+  }
+  vsdl_log("Command recording: secondary command buffers on %u workers\n", jobs->workerCount);
+}
+
+void vsdl_record_destroy(VulkanContext* vkCtx) {
+  Recorder* recorder = &vkCtx->recorder;
+  for (uint32_t i = 0; i < VSDL_JOBS_MAX_WORKERS; i++) {
+      RecordWorker* worker = &recorder->workers[i];
+      if (worker->pool) {
+          vkDestroyCommandPool(vkCtx->device, worker->pool, NULL); // Frees its buffers
+      }
+      free(worker->buffers);
+  }
+  free(recorder->items);
+  SDL_zerop(recorder);
+}
+
+void vsdl_record_begin_frame(VulkanContext* vkCtx) {
+  Recorder* recorder = &vkCtx->recorder;
+  for (uint32_t i = 0; i < VSDL_JOBS_MAX_WORKERS; i++) {
+      RecordWorker* worker = &recorder->workers[i];
+      if (worker->pool && worker->usedCount > 0) {
+          vkResetCommandPool(vkCtx->device, worker->pool, 0);
+          worker->usedCount = 0;
+      }
+  }
+  recorder->itemCount = 0;
+  recorder->secondaryCount = 0;
+}
+
+void vsdl_draw_list_add(VulkanContext* vkCtx, const RenderObject* object, vec3 offset) {
+  Recorder* recorder = &vkCtx->recorder;
+  if (recorder->itemCount == recorder->itemCapacity) {
+      uint32_t capacity = recorder->itemCapacity ? recorder->itemCapacity * 2 : 256;
+      DrawItem* items = realloc(recorder->items, capacity * sizeof(DrawItem));
+      if (!items) {
+          vsdl_log("Failed to grow draw list to %u items\n", capacity);
+          exit(1);
+      }
+      recorder->items = items;
+      recorder->itemCapacity = capacity;
+  }
+  DrawItem* item = &recorder->items[recorder->itemCount++];
+  item->object = object;
+  item->offset[0] = offset[0];
+  item->offset[1] = offset[1];
+  item->offset[2] = offset[2];
+  item->offset[3] = 0.0f;
+}
+
+bool vsdl_record_uses_secondaries(const VulkanContext* vkCtx) {
+  return vkCtx->recorder.jobs && vkCtx->recorder.jobs->workerCount > 1;
+}
+
+void vsdl_record_draws(const VulkanContext* vkCtx, VkCommandBuffer commandBuffer, VkPipeline pipeline,
+                       uint32_t first, uint32_t count) {
+  if (count == 0) {
+      return;
+  }
+  // Secondary buffers inherit no bindings from the primary, so every range binds its own
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkCtx->pipelineLayout, 0, 1, &vkCtx->descriptorSet, 0, NULL);
+  // Push constants are undefined until pushed; meshes sample table slot 0
+  TexturePushConstants texturePush = {0};
+  vkCmdPushConstants(commandBuffer, vkCtx->pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(texturePush), &texturePush);
+
+  const DrawItem* items = vkCtx->recorder.items;
+  const RenderObject* bound = NULL;
+  VkDeviceSize offsets[] = {0};
+  for (uint32_t i = first; i < first + count; i++) {
+      const RenderObject* object = items[i].object;
+      if (object != bound) {
+          vkCmdBindVertexBuffers(commandBuffer, 0, 1, &object->buffer, offsets);
+          vkCmdBindIndexBuffer(commandBuffer, object->buffer, object->indexOffset, VK_INDEX_TYPE_UINT32);
+          bound = object;
+      }
+      vkCmdPushConstants(commandBuffer, vkCtx->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, VSDL_DRAW_PUSH_CONSTANT_OFFSET,
+                         sizeof(DrawPushConstants), items[i].offset);
+      vkCmdDrawIndexed(commandBuffer, object->indexCount, 1, 0, 0, 0);
+  }
+}
+
+uint32_t vsdl_record_secondaries(VulkanContext* vkCtx, uint32_t imageIndex) {
+  Recorder* recorder = &vkCtx->recorder;
+  VkCommandBufferInheritanceInfo inheritance = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+  inheritance.renderPass = vkCtx->renderPass;
+  inheritance.subpass = 0;
+  inheritance.framebuffer = vkCtx->swapchainFramebuffers[imageIndex];
+
+  // Looked up on this thread: a worker creating a missing variant would race on the variant table
+  VkPipeline pipeline = vsdl_get_pipeline_variant(vkCtx, VSDL_PIPELINE_PACKED_VERTICES);
+
+  // Twice as many chunks as workers so a slow worker does not hold up the frame,
+  // but never fewer than VSDL_RECORD_MIN_DRAWS draws each. The last slot is for text.
+  uint32_t chunkCount = (recorder->itemCount + VSDL_RECORD_MIN_DRAWS - 1) / VSDL_RECORD_MIN_DRAWS;
+  uint32_t maxChunks = SDL_min(recorder->jobs->workerCount * 2, VSDL_RECORD_MAX_CHUNKS - 1);
+  if (chunkCount > maxChunks) chunkCount = maxChunks;
+  uint32_t drawsPerChunk = chunkCount > 0 ? (recorder->itemCount + chunkCount - 1) / chunkCount : 0;
+
+  RecordChunk chunks[VSDL_RECORD_MAX_CHUNKS];
+  SDL_AtomicInt counter;
+  SDL_SetAtomicInt(&counter, 0);
+  uint32_t count = 0;
+  for (uint32_t first = 0; first < recorder->itemCount; first += drawsPerChunk) {
+      RecordChunk* chunk = &chunks[count];
+      chunk->vkCtx = vkCtx;
+      chunk->inheritance = &inheritance;
+      chunk->pipeline = pipeline;
+      chunk->first = first;
+      chunk->count = SDL_min(drawsPerChunk, recorder->itemCount - first);
+      chunk->out = &recorder->secondaries[count];
+      vsdl_jobs_submit(recorder->jobs, record_chunk_job, chunk, &counter);
+      count++;
+  }
+
+  // Text is a single draw; record it here while the workers take the meshes
+  if (vkCtx->textBatch && vkCtx->textBatch->glyphCount > 0) {
+      VkCommandBuffer textBuffer = acquire_secondary(vkCtx, 0);
+      begin_secondary(textBuffer, &inheritance);
+      vsdl_text_record(vkCtx, textBuffer);
+      end_secondary(textBuffer);
+      recorder->secondaries[count++] = textBuffer;
+  }
+
+  vsdl_jobs_wait(recorder->jobs, &counter);
+  VSDL_TRACE("Recorded %u draws into %u secondary command buffers\n", recorder->itemCount, count);
+  recorder->secondaryCount = count;
+  return count;
+}
\ No newline at end of file
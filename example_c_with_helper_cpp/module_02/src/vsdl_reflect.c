@@ -0,0 +1,403 @@
+#include "vsdl_reflect.h"
+#include "vsdl_log.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <spirv_cross_c.h>
+
+#define VSDL_REFLECT_CACHE_MAGIC 0x43525356u // "VSRC"
+#define VSDL_REFLECT_CACHE_VERSION 2u // File layout; 2 added logicVersion
+// Entries are keyed by the SPIR-V alone, so results from older reflection
+// code would be reused as-is. Bump this whenever the reflection rules change
+// what an entry holds for the same module (types, formats, sizes, fields).
+#define VSDL_REFLECT_LOGIC_VERSION 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t logicVersion;
+    uint32_t entrySize; // sizeof(ShaderReflection) of the writer; a mismatch invalidates the file
+    uint32_t entryCount;
+} ReflectCacheHeader;
+
+static ShaderReflection entries[VSDL_REFLECT_CACHE_MAX];
+static bool entryUsed[VSDL_REFLECT_CACHE_MAX]; // Looked up this run, so worth saving
+static uint32_t entryCount = 0;
+static bool cacheDirty = false;
+
+uint64_t vsdl_hash_fnv1a(uint64_t hash, const void* data, size_t size) {
+  const unsigned char* bytes = (const unsigned char*)data;
+  for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+void vsdl_reflect_cache_load(const char* path) {
+  entryCount = 0;
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+      vsdl_log("Reflection cache %s not found, shaders will be reflected with SPIRV-Cross\n", path);
+      return;
+  }
+  ReflectCacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != VSDL_REFLECT_CACHE_MAGIC ||
+      header.version != VSDL_REFLECT_CACHE_VERSION || header.logicVersion != VSDL_REFLECT_LOGIC_VERSION ||
+      header.entrySize != sizeof(ShaderReflection)) {
+      vsdl_log("Reflection cache %s is from another build, ignoring\n", path);
+      fclose(file);
+      return;
+  }
+  uint32_t count = header.entryCount < VSDL_REFLECT_CACHE_MAX ? header.entryCount : VSDL_REFLECT_CACHE_MAX;
+  entryCount = (uint32_t)fread(entries, sizeof(ShaderReflection), count, file);
+  fclose(file);
+  vsdl_log("Reflection cache loaded (%u shaders) from %s\n", entryCount, path);
+}
+
+void vsdl_reflect_cache_save(const char* path) {
+  uint32_t usedCount = 0;
+  for (uint32_t i = 0; i < entryCount; i++) {
+      if (entryUsed[i]) usedCount++;
+  }
+  if (!cacheDirty && usedCount == entryCount) {
+      return; // File already holds exactly these entries
+  }
+
+  ReflectCacheHeader header = {VSDL_REFLECT_CACHE_MAGIC, VSDL_REFLECT_CACHE_VERSION, VSDL_REFLECT_LOGIC_VERSION,
+                               sizeof(ShaderReflection), usedCount};
+  char tempPath[512];
+  snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+  FILE* file = fopen(tempPath, "wb");
+  bool written = file && fwrite(&header, sizeof(header), 1, file) == 1;
+  for (uint32_t i = 0; written && i < entryCount; i++) {
+      if (entryUsed[i]) {
+          written = fwrite(&entries[i], sizeof(ShaderReflection), 1, file) == 1;
+      }
+  }
+  if (file && fclose(file) != 0) {
+      written = false;
+  }
+  if (written && SDL_RenamePath(tempPath, path)) {
+      vsdl_log("Reflection cache saved (%u shaders) to %s\n", usedCount, path);
+      cacheDirty = false;
+  } else {
+      vsdl_log("Failed to save reflection cache to %s\n", path);
+      SDL_RemovePath(tempPath);
+  }
+}
+
+static VkFormat input_format(spvc_basetype baseType, unsigned vectorSize) {
+  static const VkFormat fp32[4] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+  static const VkFormat fp16[4] = {VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT};
+  static const VkFormat int32[4] = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+  static const VkFormat uint32[4] = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+  static const VkFormat int16[4] = {VK_FORMAT_R16_SINT, VK_FORMAT_R16G16_SINT, VK_FORMAT_R16G16B16_SINT, VK_FORMAT_R16G16B16A16_SINT};
+  static const VkFormat uint16[4] = {VK_FORMAT_R16_UINT, VK_FORMAT_R16G16_UINT, VK_FORMAT_R16G16B16_UINT, VK_FORMAT_R16G16B16A16_UINT};
+  static const VkFormat int8[4] = {VK_FORMAT_R8_SINT, VK_FORMAT_R8G8_SINT, VK_FORMAT_R8G8B8_SINT, VK_FORMAT_R8G8B8A8_SINT};
+  static const VkFormat uint8[4] = {VK_FORMAT_R8_UINT, VK_FORMAT_R8G8_UINT, VK_FORMAT_R8G8B8_UINT, VK_FORMAT_R8G8B8A8_UINT};
+  if (vectorSize < 1 || vectorSize > 4) {
+      return VK_FORMAT_UNDEFINED;
+  }
+  switch (baseType) {
+      case SPVC_BASETYPE_FP32: return fp32[vectorSize - 1];
+      case SPVC_BASETYPE_FP16: return fp16[vectorSize - 1];
+      case SPVC_BASETYPE_INT32: return int32[vectorSize - 1];
+      case SPVC_BASETYPE_UINT32: return uint32[vectorSize - 1];
+      case SPVC_BASETYPE_INT16: return int16[vectorSize - 1];
+      case SPVC_BASETYPE_UINT16: return uint16[vectorSize - 1];
+      case SPVC_BASETYPE_INT8: return int8[vectorSize - 1];
+      case SPVC_BASETYPE_UINT8: return uint8[vectorSize - 1];
+      default: return VK_FORMAT_UNDEFINED;
+  }
+}
+
+uint32_t vsdl_format_size(VkFormat format) {
+  switch (format) {
+      case VK_FORMAT_R8_UNORM: case VK_FORMAT_R8_SNORM: case VK_FORMAT_R8_UINT: case VK_FORMAT_R8_SINT:
+          return 1;
+      case VK_FORMAT_R8G8_UNORM: case VK_FORMAT_R8G8_SNORM: case VK_FORMAT_R8G8_UINT: case VK_FORMAT_R8G8_SINT:
+      case VK_FORMAT_R16_UNORM: case VK_FORMAT_R16_SNORM: case VK_FORMAT_R16_UINT: case VK_FORMAT_R16_SINT:
+      case VK_FORMAT_R16_SFLOAT:
+          return 2;
+      case VK_FORMAT_R8G8B8_UNORM: case VK_FORMAT_R8G8B8_SNORM: case VK_FORMAT_R8G8B8_UINT: case VK_FORMAT_R8G8B8_SINT:
+          return 3;
+      case VK_FORMAT_R8G8B8A8_UNORM: case VK_FORMAT_R8G8B8A8_SNORM: case VK_FORMAT_R8G8B8A8_UINT: case VK_FORMAT_R8G8B8A8_SINT:
+      case VK_FORMAT_B8G8R8A8_UNORM: case VK_FORMAT_A2B10G10R10_UNORM_PACK32: case VK_FORMAT_A2B10G10R10_SNORM_PACK32:
+      case VK_FORMAT_R16G16_UNORM: case VK_FORMAT_R16G16_SNORM: case VK_FORMAT_R16G16_UINT: case VK_FORMAT_R16G16_SINT:
+      case VK_FORMAT_R16G16_SFLOAT: case VK_FORMAT_R32_SFLOAT: case VK_FORMAT_R32_UINT: case VK_FORMAT_R32_SINT:
+          return 4;
+      case VK_FORMAT_R16G16B16_SFLOAT: case VK_FORMAT_R16G16B16_UINT: case VK_FORMAT_R16G16B16_SINT:
+          return 6;
+      case VK_FORMAT_R16G16B16A16_UNORM: case VK_FORMAT_R16G16B16A16_SNORM: case VK_FORMAT_R16G16B16A16_UINT:
+      case VK_FORMAT_R16G16B16A16_SINT: case VK_FORMAT_R16G16B16A16_SFLOAT:
+      case VK_FORMAT_R32G32_SFLOAT: case VK_FORMAT_R32G32_UINT: case VK_FORMAT_R32G32_SINT:
+          return 8;
+      case VK_FORMAT_R32G32B32_SFLOAT: case VK_FORMAT_R32G32B32_UINT: case VK_FORMAT_R32G32B32_SINT:
+          return 12;
+      case VK_FORMAT_R32G32B32A32_SFLOAT: case VK_FORMAT_R32G32B32A32_UINT: case VK_FORMAT_R32G32B32A32_SINT:
+          return 16;
+      default:
+          vsdl_log("No vertex size known for format %u\n", format);
+          exit(1);
+  }
+}
+
+static void reflect_bindings(spvc_compiler compiler, spvc_resources resources, spvc_resource_type resourceType,
+                             VkDescriptorType descriptorType, ShaderReflection* out) {
+  const spvc_reflected_resource* list = NULL;
+  size_t count = 0;
+  spvc_resources_get_resource_list_for_type(resources, resourceType, &list, &count);
+  for (size_t i = 0; i < count; i++) {
+      if (out->bindingCount == VSDL_REFLECT_MAX_BINDINGS) {
+          vsdl_log("Shader has more than %u descriptor bindings\n", VSDL_REFLECT_MAX_BINDINGS);
+          exit(1);
+      }
+      spvc_type type = spvc_compiler_get_type_handle(compiler, list[i].type_id);
+      VkDescriptorType bindingType = descriptorType;
+      // Texel buffers are reflected as images with a buffer dimension
+      if ((resourceType == SPVC_RESOURCE_TYPE_SEPARATE_IMAGE || resourceType == SPVC_RESOURCE_TYPE_STORAGE_IMAGE) &&
+          spvc_type_get_image_dimension(type) == SpvDimBuffer) {
+          bindingType = resourceType == SPVC_RESOURCE_TYPE_STORAGE_IMAGE ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                                                                          : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+      }
+      ReflectedBinding* binding = &out->bindings[out->bindingCount++];
+      binding->set = spvc_compiler_get_decoration(compiler, list[i].id, SpvDecorationDescriptorSet);
+      binding->binding = spvc_compiler_get_decoration(compiler, list[i].id, SpvDecorationBinding);
+      binding->type = bindingType;
+      binding->count = 1;
+      if (spvc_type_get_num_array_dimensions(type) > 0) {
+          binding->count = spvc_type_get_array_dimension(type, 0); // 0 for runtime-sized arrays
+      }
+  }
+}
+
+static void reflect_spirv(const void* code, size_t size, VkShaderStageFlagBits stage, ShaderReflection* out) {
+  spvc_context context = NULL;
+  spvc_parsed_ir parsedIr = NULL;
+  spvc_compiler compiler = NULL;
+  spvc_resources resources = NULL;
+
+  if (spvc_context_create(&context) != SPVC_SUCCESS) {
+      vsdl_log("Failed to create SPIRV-Cross context\n");
+      exit(1);
+  }
+  if (spvc_context_parse_spirv(context, (const SpvId*)code, size / sizeof(uint32_t), &parsedIr) != SPVC_SUCCESS ||
+      spvc_context_create_compiler(context, SPVC_BACKEND_NONE, parsedIr, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler) != SPVC_SUCCESS ||
+      spvc_compiler_create_shader_resources(compiler, &resources) != SPVC_SUCCESS) {
+      vsdl_log("Failed to reflect SPIR-V: %s\n", spvc_context_get_last_error_string(context));
+      spvc_context_destroy(context);
+      exit(1);
+  }
+
+  out->stage = stage;
+
+  if (stage == VK_SHADER_STAGE_VERTEX_BIT) {
+      const spvc_reflected_resource* inputs = NULL;
+      size_t inputCount = 0;
+      spvc_resources_get_resource_list_for_type(resources, SPVC_RESOURCE_TYPE_STAGE_INPUT, &inputs, &inputCount);
+      if (inputCount > VSDL_REFLECT_MAX_INPUTS) {
+          vsdl_log("Vertex shader has more than %u inputs\n", VSDL_REFLECT_MAX_INPUTS);
+          exit(1);
+      }
+      for (size_t i = 0; i < inputCount; i++) {
+          spvc_type type = spvc_compiler_get_type_handle(compiler, inputs[i].type_id);
+          ReflectedInput input;
+          input.location = spvc_compiler_get_decoration(compiler, inputs[i].id, SpvDecorationLocation);
+          input.format = input_format(spvc_type_get_basetype(type), spvc_type_get_vector_size(type));
+          if (input.format == VK_FORMAT_UNDEFINED || spvc_type_get_columns(type) > 1) {
+              vsdl_log("Unsupported vertex input type at location %u\n", input.location);
+              exit(1);
+          }
+          // SPIRV-Cross lists inputs in declaration order; offsets are assigned by location
+          uint32_t j = out->inputCount++;
+          while (j > 0 && out->inputs[j - 1].location > input.location) {
+              out->inputs[j] = out->inputs[j - 1];
+              j--;
+          }
+          out->inputs[j] = input;
+      }
+  }
+
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, out);
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, out);
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, out);
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_SEPARATE_IMAGE, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, out);
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_SEPARATE_SAMPLERS, VK_DESCRIPTOR_TYPE_SAMPLER, out);
+  reflect_bindings(compiler, resources, SPVC_RESOURCE_TYPE_STORAGE_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, out);
+
+  const spvc_reflected_resource* pushConstants = NULL;
+  size_t pushConstantCount = 0;
+  spvc_resources_get_resource_list_for_type(resources, SPVC_RESOURCE_TYPE_PUSH_CONSTANT, &pushConstants, &pushConstantCount);
+  if (pushConstantCount > 0) {
+      spvc_type type = spvc_compiler_get_type_handle(compiler, pushConstants[0].base_type_id);
+      size_t blockSize = 0;
+      unsigned firstOffset = 0;
+      spvc_compiler_get_declared_struct_size(compiler, type, &blockSize);
+      spvc_compiler_type_struct_member_offset(compiler, type, 0, &firstOffset);
+      // The range starts at the first member so stages can own disjoint parts of one block
+      out->pushConstantOffset = firstOffset;
+      out->pushConstantSize = (uint32_t)blockSize - firstOffset;
+  }
+
+  const spvc_specialization_constant* specConstants = NULL;
+  size_t specConstantCount = 0;
+  spvc_compiler_get_specialization_constants(compiler, &specConstants, &specConstantCount);
+  for (size_t i = 0; i < specConstantCount && out->specConstantCount < VSDL_REFLECT_MAX_SPEC_CONSTANTS; i++) {
+      spvc_constant constant = spvc_compiler_get_constant_handle(compiler, specConstants[i].id);
+      spvc_type type = spvc_compiler_get_type_handle(compiler, spvc_constant_get_type(constant));
+      spvc_basetype baseType = spvc_type_get_basetype(type);
+      ReflectedSpecConstant* spec = &out->specConstants[out->specConstantCount++];
+      spec->id = specConstants[i].constant_id;
+      spec->size = (baseType == SPVC_BASETYPE_FP64 || baseType == SPVC_BASETYPE_INT64 || baseType == SPVC_BASETYPE_UINT64) ? 8 : 4;
+  }
+
+  spvc_context_destroy(context);
+}
+
+const ShaderReflection* vsdl_reflect_shader(const void* code, size_t size, VkShaderStageFlagBits stage) {
+  Uint64 start = SDL_GetPerformanceCounter();
+  uint64_t hash = vsdl_hash_fnv1a(VSDL_HASH_FNV1A_SEED, code, size);
+  for (uint32_t i = 0; i < entryCount; i++) {
+      if (entries[i].hash == hash && entries[i].stage == stage) {
+          entryUsed[i] = true;
+          double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+          vsdl_log("[bench] reflection stage=0x%x source=cache time=%.3fms\n", stage, ms);
+          return &entries[i];
+      }
+  }
+
+  // A full table evicts an entry loaded from disk that this run has not asked for
+  uint32_t slot = entryCount;
+  if (slot == VSDL_REFLECT_CACHE_MAX) {
+      for (slot = 0; slot < entryCount && entryUsed[slot]; slot++) {
+      }
+      if (slot == entryCount) {
+          vsdl_log("Reflection cache full (%u shaders)\n", VSDL_REFLECT_CACHE_MAX);
+          exit(1);
+      }
+  } else {
+      entryCount++;
+  }
+
+  ShaderReflection* entry = &entries[slot];
+  memset(entry, 0, sizeof(*entry));
+  entry->hash = hash;
+  reflect_spirv(code, size, stage, entry);
+  entryUsed[slot] = true;
+  cacheDirty = true;
+  double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  vsdl_log("[bench] reflection stage=0x%x source=spirv-cross time=%.3fms\n", stage, ms);
+  return entry;
+}
+
+uint32_t vsdl_reflect_vertex_layout(const ShaderReflection* vert, const VkFormat* overrides, uint32_t overrideCount,
+                                    VkVertexInputAttributeDescription* attributes, uint32_t* stride) {
+  *stride = 0;
+  for (uint32_t i = 0; i < vert->inputCount; i++) {
+      uint32_t location = vert->inputs[i].location;
+      VkFormat format = vert->inputs[i].format;
+      if (overrides && location < overrideCount && overrides[location] != VK_FORMAT_UNDEFINED) {
+          format = overrides[location];
+      }
+      attributes[i].location = location;
+      attributes[i].binding = 0;
+      attributes[i].format = format;
+      attributes[i].offset = *stride;
+      *stride += vsdl_format_size(format);
+      vsdl_log("Vertex input %u: location=%u, format=%u, offset=%u\n", i, location, format, attributes[i].offset);
+  }
+  return vert->inputCount;
+}
+
+VkDescriptorSetLayout vsdl_reflect_create_set_layout(VkDevice device, const ShaderReflection* const* shaders,
+                                                     uint32_t shaderCount, uint32_t set, uint32_t runtimeArraySize) {
+  VkDescriptorSetLayoutBinding bindings[VSDL_REFLECT_MAX_BINDINGS];
+  VkDescriptorBindingFlags bindingFlags[VSDL_REFLECT_MAX_BINDINGS];
+  uint32_t bindingCount = 0;
+  bool updateAfterBind = false;
+  for (uint32_t s = 0; s < shaderCount; s++) {
+      for (uint32_t i = 0; i < shaders[s]->bindingCount; i++) {
+          const ReflectedBinding* reflected = &shaders[s]->bindings[i];
+          if (reflected->set != set) continue;
+          uint32_t count = reflected->count;
+          if (count == 0) {
+              if (runtimeArraySize == 0) {
+                  vsdl_log("Binding %u.%u is a runtime-sized array, which needs descriptor indexing\n", set, reflected->binding);
+                  exit(1);
+              }
+              count = runtimeArraySize;
+          }
+
+          uint32_t j = 0;
+          while (j < bindingCount && bindings[j].binding != reflected->binding) j++;
+          if (j < bindingCount) {
+              if (bindings[j].descriptorType != reflected->type || bindings[j].descriptorCount != count) {
+                  vsdl_log("Binding %u.%u is declared differently between stages\n", set, reflected->binding);
+                  exit(1);
+              }
+              bindings[j].stageFlags |= shaders[s]->stage;
+              continue;
+          }
+          if (bindingCount == VSDL_REFLECT_MAX_BINDINGS) {
+              vsdl_log("Descriptor set %u has more than %u bindings\n", set, VSDL_REFLECT_MAX_BINDINGS);
+              exit(1);
+          }
+          VkDescriptorSetLayoutBinding* binding = &bindings[bindingCount++];
+          memset(binding, 0, sizeof(*binding));
+          binding->binding = reflected->binding;
+          binding->descriptorType = reflected->type;
+          binding->descriptorCount = count;
+          binding->stageFlags = shaders[s]->stage;
+          bindingFlags[bindingCount - 1] = 0;
+          if (reflected->count == 0) {
+              // Slots may be empty or rewritten while frames that use other slots are in flight
+              bindingFlags[bindingCount - 1] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+              updateAfterBind = true;
+          }
+      }
+  }
+
+  VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO};
+  flagsInfo.bindingCount = bindingCount;
+  flagsInfo.pBindingFlags = bindingFlags;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+  layoutInfo.bindingCount = bindingCount;
+  layoutInfo.pBindings = bindings;
+  if (updateAfterBind) {
+      layoutInfo.pNext = &flagsInfo;
+      layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+  }
+  VkDescriptorSetLayout layout;
+  if (vkCreateDescriptorSetLayout(device, &layoutInfo, NULL, &layout) != VK_SUCCESS) {
+      vsdl_log("Failed to create descriptor set layout\n");
+      exit(1);
+  }
+  vsdl_log("Descriptor set layout %u created from reflection (%u bindings)\n", set, bindingCount);
+  return layout;
+}
+
+uint32_t vsdl_reflect_push_constant_ranges(const ShaderReflection* const* shaders, uint32_t shaderCount,
+                                           VkPushConstantRange* ranges) {
+  uint32_t rangeCount = 0;
+  for (uint32_t s = 0; s < shaderCount; s++) {
+      if (shaders[s]->pushConstantSize > 0) {
+          ranges[rangeCount].stageFlags = shaders[s]->stage;
+          ranges[rangeCount].offset = shaders[s]->pushConstantOffset;
+          ranges[rangeCount].size = shaders[s]->pushConstantSize;
+          rangeCount++;
+      }
+  }
+  return rangeCount;
+}
+
+const ReflectedSpecConstant* vsdl_reflect_find_spec_constant(const ShaderReflection* shader, uint32_t id) {
+  for (uint32_t i = 0; i < shader->specConstantCount; i++) {
+      if (shader->specConstants[i].id == id) {
+          return &shader->specConstants[i];
+      }
+  }
+  return NULL;
+}
\ No newline at end of file
@@ -1,75 +1,127 @@
 #include "vsdl_render.h"
 #include "vsdl_log.h"
+#include "vsdl_glyph_atlas.h"
+#include "vsdl_text.h"
+#include "vsdl_vertex_pack.h"
+#include "vsdl_bindless.h"
+#include "vsdl_record.h"
+#include <SDL3/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <spirv_cross_c.h>
 
 #define WIDTH 800  // Define here or pass via vkCtx if it becomes dynamic
 #define HEIGHT 600 // Define here or pass via vkCtx if it becomes dynamic
 
-void vsdl_create_pipeline(VulkanContext* vkCtx) { // Match declaration
-  vsdl_log("Attempting to load shaders...\n");
-
-  FILE* vertFile = fopen("vert.spv", "rb");
-  if (!vertFile) {
-      vsdl_log("Failed to open vert.spv - ensure it’s in the Debug directory\n");
+static char* load_shader(const char* path, long* outSize) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+      vsdl_log("Failed to open %s - ensure it’s in the Debug directory\n", path);
       exit(1);
   }
-  fseek(vertFile, 0, SEEK_END);
-  long vertSize = ftell(vertFile);
-  fseek(vertFile, 0, SEEK_SET);
-  char* vertShaderCode = malloc(vertSize);
-  fread(vertShaderCode, 1, vertSize, vertFile);
-  fclose(vertFile);
-  vsdl_log("Vertex shader loaded successfully\n");
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char* code = malloc(size);
+  fread(code, 1, size, file);
+  fclose(file);
+  *outSize = size;
+  return code;
+}
 
-  FILE* fragFile = fopen("frag.spv", "rb");
-  if (!fragFile) {
-      vsdl_log("Failed to open frag.spv - ensure it’s in the Debug directory\n");
+static VkShaderModule create_shader_module(VulkanContext* vkCtx, const char* code, long size) {
+  VkShaderModuleCreateInfo shaderInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+  shaderInfo.codeSize = size;
+  shaderInfo.pCode = (const uint32_t*)code;
+  VkShaderModule module;
+  if (vkCreateShaderModule(vkCtx->device, &shaderInfo, NULL, &module) != VK_SUCCESS) {
+      vsdl_log("Failed to create shader module\n");
       exit(1);
   }
-  fseek(fragFile, 0, SEEK_END);
-  long fragSize = ftell(fragFile);
-  fseek(fragFile, 0, SEEK_SET);
-  char* fragShaderCode = malloc(fragSize);
-  fread(fragShaderCode, 1, fragSize, fragFile);
-  fclose(fragFile);
+  return module;
+}
+
+void vsdl_load_shaders(VulkanContext* vkCtx) {
+  vsdl_log("Attempting to load shaders...\n");
+
+  long vertSize = 0, fragSize = 0;
+  char* vertShaderCode = load_shader("vert.spv", &vertSize);
+  vsdl_log("Vertex shader loaded successfully\n");
+  char* fragShaderCode = load_shader("frag.spv", &fragSize);
   vsdl_log("Fragment shader loaded successfully\n");
 
-  VkVertexInputAttributeDescription* attrDesc = NULL;
-  uint32_t attrCount = 0;
-  uint32_t stride = 0;
-  vsdl_reflect_vertex_inputs(vertShaderCode, vertSize, &attrDesc, &attrCount, &stride);
-
-  VkShaderModuleCreateInfo vertShaderInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-  vertShaderInfo.codeSize = vertSize;
-  vertShaderInfo.pCode = (uint32_t*)vertShaderCode;
-  VkShaderModule vertModule;
-  if (vkCreateShaderModule(vkCtx->device, &vertShaderInfo, NULL, &vertModule) != VK_SUCCESS) {
-      vsdl_log("Failed to create vertex shader module\n");
+  vkCtx->vertReflection = vsdl_reflect_shader(vertShaderCode, vertSize, VK_SHADER_STAGE_VERTEX_BIT);
+  vkCtx->fragReflection = vsdl_reflect_shader(fragShaderCode, fragSize, VK_SHADER_STAGE_FRAGMENT_BIT);
+  vkCtx->vertexAttributeCount = vsdl_reflect_vertex_layout(vkCtx->vertReflection, NULL, 0, vkCtx->vertexAttributes, &vkCtx->vertexStride);
+  vkCtx->packedVertexAttributeCount = vsdl_reflect_vertex_layout(vkCtx->vertReflection, vsdl_packed_vertex_formats,
+                                                                 VSDL_PACKED_VERTEX_FORMAT_COUNT, vkCtx->packedVertexAttributes,
+                                                                 &vkCtx->packedVertexStride);
+  if (vkCtx->packedVertexStride != sizeof(PackedVertex)) {
+      vsdl_log("vert.spv inputs do not match PackedVertex (stride %u, expected %u)\n", vkCtx->packedVertexStride,
+               (uint32_t)sizeof(PackedVertex));
       exit(1);
   }
+  vkCtx->vertModule = create_shader_module(vkCtx, vertShaderCode, vertSize);
+  vkCtx->fragModule = create_shader_module(vkCtx, fragShaderCode, fragSize);
+  uint64_t hashes[2] = {vkCtx->vertReflection->hash, vkCtx->fragReflection->hash};
+  vkCtx->shaderHash = vsdl_hash_fnv1a(VSDL_HASH_FNV1A_SEED, hashes, sizeof(hashes));
+  free(vertShaderCode);
+  free(fragShaderCode);
 
-  VkShaderModuleCreateInfo fragShaderInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-  fragShaderInfo.codeSize = fragSize;
-  fragShaderInfo.pCode = (uint32_t*)fragShaderCode;
-  VkShaderModule fragModule;
-  if (vkCreateShaderModule(vkCtx->device, &fragShaderInfo, NULL, &fragModule) != VK_SUCCESS) {
-      vsdl_log("Failed to create fragment shader module\n");
+  const ShaderReflection* stages[2] = {vkCtx->vertReflection, vkCtx->fragReflection};
+  vkCtx->descriptorSetLayout = vsdl_reflect_create_set_layout(vkCtx->device, stages, 2, 0, vkCtx->textures.capacity);
+}
+
+/**
+ * Creates the pipeline layout from the reflected shaders, then the variants
+ * drawn every frame: packed vertex color meshes, coverage text and SDF text
+ */
+void vsdl_create_pipeline(VulkanContext* vkCtx) { // Match declaration
+  const ShaderReflection* stages[2] = {vkCtx->vertReflection, vkCtx->fragReflection};
+  VkPushConstantRange pushConstantRanges[2];
+  uint32_t pushConstantRangeCount = vsdl_reflect_push_constant_ranges(stages, 2, pushConstantRanges);
+
+  VkPipelineLayoutCreateInfo pipelineLayoutInfo = {VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+  pipelineLayoutInfo.setLayoutCount = 1;
+  pipelineLayoutInfo.pSetLayouts = &vkCtx->descriptorSetLayout;
+  pipelineLayoutInfo.pushConstantRangeCount = pushConstantRangeCount;
+  pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges;
+
+  if (vkCreatePipelineLayout(vkCtx->device, &pipelineLayoutInfo, NULL, &vkCtx->pipelineLayout) != VK_SUCCESS) {
+      vsdl_log("Failed to create pipeline layout\n");
       exit(1);
   }
 
+  // Created up front so switching text to SDF at runtime does not hitch
+  Uint64 createStart = SDL_GetPerformanceCounter();
+  vsdl_get_pipeline_variant(vkCtx, VSDL_PIPELINE_PACKED_VERTICES);
+  vsdl_get_pipeline_variant(vkCtx, VSDL_SHADER_TEXTURED);
+  vsdl_get_pipeline_variant(vkCtx, VSDL_SHADER_TEXTURED | VSDL_SHADER_SDF);
+  double createMs = (double)(SDL_GetPerformanceCounter() - createStart) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  vsdl_log("[bench] pipeline cache=%s create=%.3fms (%u variants)\n", vkCtx->pipelineCacheWarm ? "warm" : "cold", createMs,
+           vkCtx->pipelineVariantCount);
+  vsdl_log("Graphics pipelines created successfully\n");
+}
+
+static VkPipeline create_pipeline_variant(VulkanContext* vkCtx, uint32_t features) {
+  // Shaders without the FEATURES constant get no specialization and ignore the bits
+  const ReflectedSpecConstant* featuresConstant =
+      vsdl_reflect_find_spec_constant(vkCtx->fragReflection, VSDL_SHADER_FEATURES_CONSTANT_ID);
+  VkSpecializationMapEntry specEntry = {VSDL_SHADER_FEATURES_CONSTANT_ID, 0, sizeof(uint32_t)};
+  uint32_t shaderFeatures = features & VSDL_SHADER_FEATURE_MASK;
+  VkSpecializationInfo specInfo = {1, &specEntry, sizeof(shaderFeatures), &shaderFeatures};
+
   VkPipelineShaderStageCreateInfo shaderStages[] = {
-      {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, NULL, 0, VK_SHADER_STAGE_VERTEX_BIT, vertModule, "main", 0},
-      {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, NULL, 0, VK_SHADER_STAGE_FRAGMENT_BIT, fragModule, "main", 0}
+      {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, NULL, 0, VK_SHADER_STAGE_VERTEX_BIT, vkCtx->vertModule, "main", NULL},
+      {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, NULL, 0, VK_SHADER_STAGE_FRAGMENT_BIT, vkCtx->fragModule, "main", featuresConstant ? &specInfo : NULL}
   };
 
-  VkVertexInputBindingDescription bindingDesc = {0, stride, VK_VERTEX_INPUT_RATE_VERTEX};
+  bool packed = (features & VSDL_PIPELINE_PACKED_VERTICES) != 0;
+  VkVertexInputBindingDescription bindingDesc = {0, packed ? vkCtx->packedVertexStride : vkCtx->vertexStride, VK_VERTEX_INPUT_RATE_VERTEX};
   VkPipelineVertexInputStateCreateInfo vertexInputInfo = {VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
   vertexInputInfo.vertexBindingDescriptionCount = 1;
   vertexInputInfo.pVertexBindingDescriptions = &bindingDesc;
-  vertexInputInfo.vertexAttributeDescriptionCount = attrCount;
-  vertexInputInfo.pVertexAttributeDescriptions = attrDesc;
+  vertexInputInfo.vertexAttributeDescriptionCount = packed ? vkCtx->packedVertexAttributeCount : vkCtx->vertexAttributeCount;
+  vertexInputInfo.pVertexAttributeDescriptions = packed ? vkCtx->packedVertexAttributes : vkCtx->vertexAttributes;
 
   VkPipelineInputAssemblyStateCreateInfo inputAssembly = {VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
   inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
@@ -110,15 +162,6 @@ void vsdl_create_pipeline(VulkanContext* vkCtx) { // Match declaration
   colorBlending.attachmentCount = 1;
   colorBlending.pAttachments = &colorBlendAttachment;
 
-  VkPipelineLayoutCreateInfo pipelineLayoutInfo = {VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
-  pipelineLayoutInfo.setLayoutCount = 1;
-  pipelineLayoutInfo.pSetLayouts = &vkCtx->descriptorSetLayout;
-
-  if (vkCreatePipelineLayout(vkCtx->device, &pipelineLayoutInfo, NULL, &vkCtx->pipelineLayout) != VK_SUCCESS) {
-      vsdl_log("Failed to create pipeline layout\n");
-      exit(1);
-  }
-
   VkGraphicsPipelineCreateInfo pipelineInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
   pipelineInfo.stageCount = 2;
   pipelineInfo.pStages = shaderStages;
@@ -133,17 +176,42 @@ void vsdl_create_pipeline(VulkanContext* vkCtx) { // Match declaration
   pipelineInfo.renderPass = vkCtx->renderPass;
   pipelineInfo.subpass = 0;
 
-  if (vkCreateGraphicsPipelines(vkCtx->device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &vkCtx->graphicsPipeline) != VK_SUCCESS) {
-      vsdl_log("Failed to create graphics pipeline\n");
+  VkPipeline pipeline;
+  if (vkCreateGraphicsPipelines(vkCtx->device, vkCtx->pipelineCache, 1, &pipelineInfo, NULL, &pipeline) != VK_SUCCESS) {
+      vsdl_log("Failed to create graphics pipeline variant 0x%x\n", features);
       exit(1);
   }
+  vkCtx->pipelineCacheUsed = true;
+  return pipeline;
+}
 
-  vkDestroyShaderModule(vkCtx->device, fragModule, NULL);
-  vkDestroyShaderModule(vkCtx->device, vertModule, NULL);
-  free(vertShaderCode);
-  free(fragShaderCode);
-  free(attrDesc);
-  vsdl_log("Graphics pipeline created successfully\n");
+VkPipeline vsdl_get_pipeline_variant(VulkanContext* vkCtx, uint32_t features) {
+  uint64_t hash = vsdl_hash_fnv1a(vkCtx->shaderHash, &features, sizeof(features));
+  for (uint32_t i = 0; i < vkCtx->pipelineVariantCount; i++) {
+      if (vkCtx->pipelineVariants[i].hash == hash) {
+          return vkCtx->pipelineVariants[i].pipeline;
+      }
+  }
+  if (vkCtx->pipelineVariantCount == VSDL_PIPELINE_VARIANT_MAX) {
+      vsdl_log("Pipeline variant table full (%u), cannot add 0x%x\n", VSDL_PIPELINE_VARIANT_MAX, features);
+      exit(1);
+  }
+  PipelineVariant* variant = &vkCtx->pipelineVariants[vkCtx->pipelineVariantCount++];
+  variant->hash = hash;
+  variant->features = features;
+  variant->pipeline = create_pipeline_variant(vkCtx, features);
+  vsdl_log("Pipeline variant 0x%x created (hash %016llx)\n", features, (unsigned long long)hash);
+  return variant->pipeline;
+}
+
+void vsdl_destroy_pipelines(VulkanContext* vkCtx) {
+  for (uint32_t i = 0; i < vkCtx->pipelineVariantCount; i++) {
+      vkDestroyPipeline(vkCtx->device, vkCtx->pipelineVariants[i].pipeline, NULL);
+  }
+  vkCtx->pipelineVariantCount = 0;
+  vkDestroyPipelineLayout(vkCtx->device, vkCtx->pipelineLayout, NULL);
+  vkDestroyShaderModule(vkCtx->device, vkCtx->fragModule, NULL);
+  vkDestroyShaderModule(vkCtx->device, vkCtx->vertModule, NULL);
 }
 
 
@@ -155,6 +223,11 @@ void vsdl_record_command_buffer(VulkanContext* vkCtx, uint32_t imageIndex) { //
       exit(1);
   }
 
+  // Glyphs rasterized since the last frame must land before the render pass samples them
+  if (vkCtx->glyphAtlas) {
+      vsdl_glyph_atlas_record_upload(vkCtx, vkCtx->commandBuffer);
+  }
+
   VkRenderPassBeginInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
   renderPassInfo.renderPass = vkCtx->renderPass;
   renderPassInfo.framebuffer = vkCtx->swapchainFramebuffers[imageIndex];
@@ -164,25 +237,20 @@ void vsdl_record_command_buffer(VulkanContext* vkCtx, uint32_t imageIndex) { //
   renderPassInfo.clearValueCount = 2;
   renderPassInfo.pClearValues = clearValues;
 
-  vkCmdBeginRenderPass(vkCtx->commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-  vkCmdBindPipeline(vkCtx->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkCtx->graphicsPipeline);
-  vkCmdBindDescriptorSets(vkCtx->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkCtx->pipelineLayout, 0, 1, &vkCtx->descriptorSet, 0, NULL);
-
-  VkDeviceSize offsets[] = {0};
-  if (vkCtx->triangle.exists) {
-      vsdl_log("Rendering triangle with %u vertices\n", vkCtx->triangle.vertexCount);
-      vkCmdBindVertexBuffers(vkCtx->commandBuffer, 0, 1, &vkCtx->triangle.buffer, offsets);
-      vkCmdDraw(vkCtx->commandBuffer, vkCtx->triangle.vertexCount, 1, 0, 0);
-  }
-  if (vkCtx->cube.exists) {
-      vsdl_log("Rendering cube with %u vertices\n", vkCtx->cube.vertexCount);
-      vkCmdBindVertexBuffers(vkCtx->commandBuffer, 0, 1, &vkCtx->cube.buffer, offsets);
-      vkCmdDraw(vkCtx->commandBuffer, vkCtx->cube.vertexCount, 1, 0, 0);
-  }
-  if (vkCtx->text.exists) {
-      vsdl_log("Rendering text with %u vertices\n", vkCtx->text.vertexCount);
-      vkCmdBindVertexBuffers(vkCtx->commandBuffer, 0, 1, &vkCtx->text.buffer, offsets);
-      vkCmdDraw(vkCtx->commandBuffer, vkCtx->text.vertexCount, 1, 0, 0);
+  // With job workers the pass holds only vkCmdExecuteCommands: the draw list is
+  // recorded into secondary buffers in parallel and executed in draw list order
+  if (vsdl_record_uses_secondaries(vkCtx)) {
+      vkCmdBeginRenderPass(vkCtx->commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+      uint32_t secondaryCount = vsdl_record_secondaries(vkCtx, imageIndex);
+      if (secondaryCount > 0) {
+          vkCmdExecuteCommands(vkCtx->commandBuffer, secondaryCount, vkCtx->recorder.secondaries);
+      }
+  } else {
+      vkCmdBeginRenderPass(vkCtx->commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+      VSDL_TRACE("Rendering %u draws inline\n", vkCtx->recorder.itemCount);
+      vsdl_record_draws(vkCtx, vkCtx->commandBuffer, vsdl_get_pipeline_variant(vkCtx, VSDL_PIPELINE_PACKED_VERTICES), 0,
+                        vkCtx->recorder.itemCount);
+      vsdl_text_record(vkCtx, vkCtx->commandBuffer); // All strings of the frame in one draw
   }
 
   vkCmdEndRenderPass(vkCtx->commandBuffer);
@@ -190,76 +258,4 @@ void vsdl_record_command_buffer(VulkanContext* vkCtx, uint32_t imageIndex) { //
       vsdl_log("Failed to end command buffer\n");
       exit(1);
   }
-}
-
-void vsdl_reflect_vertex_inputs(const char* shaderCode, size_t codeSize, VkVertexInputAttributeDescription** attrDesc, uint32_t* attrCount, uint32_t* stride) {
-    spvc_context context = NULL;
-    spvc_parsed_ir parsed_ir = NULL;
-    spvc_compiler compiler = NULL;
-    spvc_resources resources = NULL;
-    const spvc_reflected_resource* stage_inputs = NULL;
-    size_t input_count = 0;
-
-    if (spvc_context_create(&context) != SPVC_SUCCESS) {
-        vsdl_log("Failed to create SPIRV-Cross context\n");
-        exit(1);
-    }
-
-    if (spvc_context_parse_spirv(context, (const uint32_t*)shaderCode, codeSize / sizeof(uint32_t), &parsed_ir) != SPVC_SUCCESS) {
-        vsdl_log("Failed to parse SPIR-V\n");
-        spvc_context_destroy(context);
-        exit(1);
-    }
-
-    if (spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, parsed_ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler) != SPVC_SUCCESS) {
-        vsdl_log("Failed to create SPIRV-Cross compiler\n");
-        spvc_context_destroy(context);
-        exit(1);
-    }
-
-    if (spvc_compiler_create_shader_resources(compiler, &resources) != SPVC_SUCCESS) {
-        vsdl_log("Failed to create shader resources\n");
-        spvc_context_destroy(context);
-        exit(1);
-    }
-
-    if (spvc_resources_get_resource_list_for_type(resources, SPVC_RESOURCE_TYPE_STAGE_INPUT, &stage_inputs, &input_count) != SPVC_SUCCESS) {
-        vsdl_log("Failed to get stage inputs\n");
-        spvc_context_destroy(context);
-        exit(1);
-    }
-
-    *attrCount = (uint32_t)input_count;
-    *attrDesc = malloc(*attrCount * sizeof(VkVertexInputAttributeDescription));
-    *stride = 0;
-
-    for (uint32_t i = 0; i < *attrCount; i++) {
-        uint32_t location = spvc_compiler_get_decoration(compiler, stage_inputs[i].id, SpvDecorationLocation);
-        spvc_type_id type_id = stage_inputs[i].type_id;
-        spvc_type type = spvc_compiler_get_type_handle(compiler, type_id);
-
-        (*attrDesc)[i].location = location;
-        (*attrDesc)[i].binding = 0;
-        (*attrDesc)[i].offset = *stride;
-
-        spvc_basetype base_type = spvc_type_get_basetype(type);
-        if (base_type == SPVC_BASETYPE_FP32) {
-            unsigned vector_size = spvc_type_get_vector_size(type);
-            switch (vector_size) {
-                case 1: (*attrDesc)[i].format = VK_FORMAT_R32_SFLOAT; break;    // TexFlag
-                case 2: (*attrDesc)[i].format = VK_FORMAT_R32G32_SFLOAT; break; // TexCoord
-                case 3: (*attrDesc)[i].format = VK_FORMAT_R32G32B32_SFLOAT; break; // Position or Color
-                default: vsdl_log("Unsupported vector size: %u\n", vector_size); exit(1);
-            }
-            *stride += vector_size * sizeof(float);
-        } else {
-            vsdl_log("Unsupported base type: %u\n", base_type);
-            exit(1);
-        }
-
-        vsdl_log("Vertex input %u: location=%u, format=%u, offset=%u\n", 
-                 i, (*attrDesc)[i].location, (*attrDesc)[i].format, (*attrDesc)[i].offset);
-    }
-
-    spvc_context_destroy(context);
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "vsdl_text.h"
+#include "vsdl_glyph_atlas.h"
+#include "vsdl_glyph_raster.h"
+#include "vsdl_render.h"
+#include "vsdl_bindless.h"
+#include "vsdl_deletion.h"
+#include "vsdl_record.h"
+#include "vsdl_mesh.h" // For ft_library
+#include "vsdl_log.h"
+#include "vsdl_vulkan_init.h" // For allocator
+#include FT_MODULE_H
+#include <stdlib.h>
+#include <string.h>
+
+#define VSDL_TEXT_FLOATS_PER_GLYPH (6 * 8)
+
+/**
+ * Loads the font, creates the glyph atlas and the mapped vertex buffer
+ */
+void vsdl_text_init(VulkanContext* vkCtx, const char* fontPath) {
+  TextBatch* batch = calloc(1, sizeof(TextBatch));
+  if (!batch) {
+      vsdl_log("Failed to allocate text batch\n");
+      exit(1);
+  }
+
+  if (!ft_library) {
+      if (FT_Init_FreeType(&ft_library) != 0) {
+          vsdl_log("Failed to initialize FreeType\n");
+          exit(1);
+      }
+  }
+  // Narrower than FreeType's default of 8 so small SDF glyphs pack tighter
+  FT_Int spread = VSDL_GLYPH_SDF_SPREAD;
+  FT_Property_Set(ft_library, "sdf", "spread", &spread);
+  FT_Property_Set(ft_library, "bsdf", "spread", &spread);
+
+  if (FT_New_Face(ft_library, fontPath, 0, &batch->face) != 0) {
+      vsdl_log("Failed to load font %s - ensure it’s in the executable directory\n", fontPath);
+      exit(1);
+  }
+  FT_Set_Pixel_Sizes(batch->face, 0, VSDL_TEXT_RASTER_SIZE);
+
+  // Layout touches these for nearly every glyph; resolve them once
+  for (int c = 0; c < 128; c++) {
+      batch->asciiIndex[c] = FT_Get_Char_Index(batch->face, (FT_ULong)c);
+  }
+  if (FT_HAS_KERNING(batch->face)) {
+      for (int a = 32; a < 127; a++) {
+          for (int b = 32; b < 127; b++) {
+              FT_Vector kerning;
+              if (FT_Get_Kerning(batch->face, batch->asciiIndex[a], batch->asciiIndex[b], FT_KERNING_UNSCALED, &kerning) == 0) {
+                  batch->asciiKerning[a][b] = (int16_t)kerning.x;
+              }
+          }
+      }
+  }
+
+  VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  bufferInfo.size = sizeof(float) * VSDL_TEXT_FLOATS_PER_GLYPH * (VkDeviceSize)VSDL_TEXT_MAX_GLYPHS;
+  bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VmaAllocationCreateInfo allocInfo = {};
+  allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  VmaAllocationInfo allocResult;
+  if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &batch->buffer, &batch->allocation, &allocResult) != VK_SUCCESS) {
+      vsdl_log("Failed to create text vertex buffer\n");
+      exit(1);
+  }
+  batch->mapped = allocResult.pMappedData;
+  batch->capacity = VSDL_TEXT_MAX_GLYPHS;
+  vkCtx->textBatch = batch;
+
+  vsdl_glyph_atlas_create(vkCtx, VSDL_GLYPH_ATLAS_SIZE, VSDL_GLYPH_ATLAS_SIZE);
+
+  vsdl_log("Text batch created: %u glyphs, font %s%s\n", batch->capacity, fontPath,
+           FT_HAS_KERNING(batch->face) ? " (kerning)" : "");
+}
+
+/**
+ * Releases the text batch, glyph atlas, font face and FreeType library. The GPU
+ * resources go to the deletion queue and are freed once the frames that used them
+ * complete, or by vsdl_deletion_flush, so the device need not be idle.
+ */
+void vsdl_text_cleanup(VulkanContext* vkCtx) {
+  TextBatch* batch = vkCtx->textBatch;
+  if (!batch) {
+      return;
+  }
+  vsdl_retire_buffer(vkCtx, batch->buffer, batch->allocation); // Read by the last frame's text draw
+  vsdl_glyph_atlas_destroy(vkCtx);
+  FT_Done_Face(batch->face);
+  free(batch);
+  vkCtx->textBatch = NULL;
+  if (ft_library) {
+      FT_Done_FreeType(ft_library);
+      ft_library = NULL;
+  }
+  vsdl_log("Text batch destroyed\n");
+}
+
+/**
+ * Rasterizes a glyph set across the job system and packs it into the atlas in the
+ * current text mode, so later frames only look glyphs up
+ */
+void vsdl_text_prewarm(VulkanContext* vkCtx, JobSystem* jobs, const char* fontPath, const uint32_t* codepoints, uint32_t count) {
+  TextBatch* batch = vkCtx->textBatch;
+  RasterizedGlyph* glyphs = malloc(count * sizeof(RasterizedGlyph));
+  if (!glyphs) {
+      vsdl_log("Failed to allocate glyph prewarm results\n");
+      return;
+  }
+
+  Uint64 start = SDL_GetPerformanceCounter();
+  GlyphRasterPool pool;
+  vsdl_glyph_raster_init(&pool, jobs, fontPath, batch->sdf ? VSDL_TEXT_SDF_SIZE : VSDL_TEXT_RASTER_SIZE,
+                         batch->sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL);
+  vsdl_glyph_raster_run(&pool, codepoints, count, glyphs);
+  uint32_t inserted = vsdl_glyph_raster_insert(&pool, &vkCtx->glyphAtlas->cache, 0, glyphs, count);
+  vsdl_glyph_raster_free(glyphs, count);
+  vsdl_glyph_raster_destroy(&pool);
+  free(glyphs);
+
+  double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  vsdl_log("Prewarmed %u glyphs on %u workers in %.2f ms\n", inserted, jobs->workerCount, ms);
+}
+
+void vsdl_text_begin(VulkanContext* vkCtx) {
+  TextBatch* batch = vkCtx->textBatch;
+  batch->glyphCount = 0;
+  batch->overflowed = false;
+  batch->ranges[0] = (TextRange){0, batch->sdf};
+  batch->rangeCount = 1;
+}
+
+/**
+ * Switches later vsdl_text_draw calls between coverage bitmaps and signed
+ * distance fields. Both kinds share the atlas under different cache keys.
+ * Quads already queued this frame keep their mode: each switch starts a new
+ * range that vsdl_text_record draws with its own pipeline variant.
+ */
+void vsdl_text_set_sdf(VulkanContext* vkCtx, bool enable) {
+  TextBatch* batch = vkCtx->textBatch;
+  if (batch->sdf == enable) {
+      return;
+  }
+  TextRange* last = &batch->ranges[batch->rangeCount - 1];
+  if (last->first == batch->glyphCount) {
+      last->sdf = enable; // Nothing drawn in the open range yet
+  } else if (batch->rangeCount < VSDL_TEXT_MAX_RANGES) {
+      batch->ranges[batch->rangeCount++] = (TextRange){batch->glyphCount, enable};
+  } else {
+      vsdl_log("Too many text mode switches this frame (%u), keeping %s\n", VSDL_TEXT_MAX_RANGES,
+               batch->sdf ? "signed distance field" : "coverage bitmap");
+      return;
+  }
+  batch->sdf = enable;
+  vsdl_log("Text rendering: %s\n", enable ? "signed distance field" : "coverage bitmap");
+}
+
+// Decodes one UTF-8 code point; malformed bytes come back as U+FFFD
+static uint32_t next_codepoint(const unsigned char** s) {
+  const unsigned char* p = *s;
+  uint32_t c = *p++;
+  int extra = 0;
+  if (c >= 0xF0) { c &= 0x07; extra = 3; }
+  else if (c >= 0xE0) { c &= 0x0F; extra = 2; }
+  else if (c >= 0xC0) { c &= 0x1F; extra = 1; }
+  else if (c >= 0x80) { *s = p; return 0xFFFD; }
+  for (; extra > 0; extra--) {
+      if ((*p & 0xC0) != 0x80) { *s = p; return 0xFFFD; }
+      c = (c << 6) | (*p++ & 0x3F);
+  }
+  *s = p;
+  return c;
+}
+
+/**
+ * Lays out a string as glyph quads in world units. pos is the baseline origin of
+ * the first line, size the em height; '\n' starts a new line below.
+ * @return Advance of the last line in world units
+ */
+float vsdl_text_draw(VulkanContext* vkCtx, const char* str, vec2 pos, float size, vec3 color) {
+  TextBatch* batch = vkCtx->textBatch;
+  GlyphCache* cache = &vkCtx->glyphAtlas->cache;
+  FT_Face face = batch->face;
+
+  // SDF glyphs are rasterized once and scaled to every size; vsdl_text_record
+  // draws them with the SDF pipeline variant
+  const uint32_t rasterSize = batch->sdf ? VSDL_TEXT_SDF_SIZE : VSDL_TEXT_RASTER_SIZE;
+  const FT_Render_Mode renderMode = batch->sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL;
+  const float scale = size / rasterSize; // Raster pixels -> world units
+  const float unitScale = size / face->units_per_EM; // Font units -> world units
+  const float lineHeight = face->height * unitScale;
+  const float inv_w = 1.0f / cache->width, inv_h = 1.0f / cache->height;
+  const bool hasKerning = FT_HAS_KERNING(face);
+
+  float pen_x = pos[0], pen_y = pos[1];
+  FT_UInt prevIndex = 0;
+  uint32_t prevChar = 0;
+  float* out = batch->mapped + (size_t)batch->glyphCount * VSDL_TEXT_FLOATS_PER_GLYPH;
+
+  const unsigned char* s = (const unsigned char*)str;
+  while (*s) {
+      uint32_t c = next_codepoint(&s);
+      if (c == '\n') {
+          pen_x = pos[0];
+          pen_y -= lineHeight;
+          prevIndex = 0;
+          continue;
+      }
+
+      FT_UInt glyphIndex = c < 128 ? batch->asciiIndex[c] : FT_Get_Char_Index(face, c);
+      if (hasKerning && prevIndex) {
+          if (c < 128 && prevChar < 128) {
+              pen_x += batch->asciiKerning[prevChar][c] * unitScale;
+          } else {
+              FT_Vector kerning;
+              if (FT_Get_Kerning(face, prevIndex, glyphIndex, FT_KERNING_UNSCALED, &kerning) == 0) {
+                  pen_x += kerning.x * unitScale;
+              }
+          }
+      }
+      prevIndex = glyphIndex;
+      prevChar = c;
+
+      const GlyphEntry* glyph = vsdl_glyph_cache_get(cache, face, 0, rasterSize, glyphIndex, renderMode);
+      if (!glyph) continue;
+
+      if (glyph->width > 0 && glyph->height > 0) {
+          if (batch->glyphCount >= batch->capacity) {
+              if (!batch->overflowed) {
+                  vsdl_log("Text batch full (%u glyphs), dropping the rest of this frame\n", batch->capacity);
+                  batch->overflowed = true;
+              }
+              break;
+          }
+          float x0 = pen_x + glyph->bearingX * scale;
+          float x1 = x0 + glyph->width * scale;
+          float y1 = pen_y + glyph->bearingY * scale;
+          float y0 = y1 - glyph->height * scale;
+          float u0 = glyph->x * inv_w, u1 = (glyph->x + glyph->width) * inv_w;
+          float v0 = glyph->y * inv_h, v1 = (glyph->y + glyph->height) * inv_h;
+          const float quad[VSDL_TEXT_FLOATS_PER_GLYPH] = {
+              x0, y0, 0.0f,  color[0], color[1], color[2],  u0, v1,
+              x0, y1, 0.0f,  color[0], color[1], color[2],  u0, v0,
+              x1, y0, 0.0f,  color[0], color[1], color[2],  u1, v1,
+              x0, y1, 0.0f,  color[0], color[1], color[2],  u0, v0,
+              x1, y1, 0.0f,  color[0], color[1], color[2],  u1, v0,
+              x1, y0, 0.0f,  color[0], color[1], color[2],  u1, v1
+          };
+          // Mapped memory may be write-combined: write whole quads, never read back
+          memcpy(out, quad, sizeof(quad));
+          out += VSDL_TEXT_FLOATS_PER_GLYPH;
+          batch->glyphCount++;
+      }
+      pen_x += glyph->advance * scale;
+  }
+  return pen_x - pos[0];
+}
+
+void vsdl_text_end(VulkanContext* vkCtx) {
+  TextBatch* batch = vkCtx->textBatch;
+  if (batch->glyphCount > 0) {
+      vmaFlushAllocation(allocator, batch->allocation, 0, sizeof(float) * VSDL_TEXT_FLOATS_PER_GLYPH * (VkDeviceSize)batch->glyphCount);
+  }
+}
+
+/**
+ * Draws every quad written this frame with one draw call per mode range. Must be inside the render pass.
+ */
+void vsdl_text_record(VulkanContext* vkCtx, VkCommandBuffer commandBuffer) {
+  TextBatch* batch = vkCtx->textBatch;
+  if (!batch || batch->glyphCount == 0) {
+      return;
+  }
+  // Bound here as well because text may be recorded into its own secondary command buffer
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkCtx->pipelineLayout, 0, 1, &vkCtx->descriptorSet, 0, NULL);
+  TexturePushConstants push = {vkCtx->glyphAtlas->textureIndex};
+  vkCmdPushConstants(commandBuffer, vkCtx->pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
+  DrawPushConstants drawPush = {{0.0f, 0.0f, 0.0f, 0.0f}}; // Glyph quads are already in world space
+  vkCmdPushConstants(commandBuffer, vkCtx->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, VSDL_DRAW_PUSH_CONSTANT_OFFSET,
+                     sizeof(drawPush), &drawPush);
+  VkDeviceSize offsets[] = {0};
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, &batch->buffer, offsets);
+  for (uint32_t i = 0; i < batch->rangeCount; i++) {
+      uint32_t first = batch->ranges[i].first;
+      uint32_t end = i + 1 < batch->rangeCount ? batch->ranges[i + 1].first : batch->glyphCount;
+      if (end <= first) continue;
+      uint32_t features = VSDL_SHADER_TEXTURED | (batch->ranges[i].sdf ? VSDL_SHADER_SDF : 0);
+      vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vsdl_get_pipeline_variant(vkCtx, features));
+      vkCmdDraw(commandBuffer, (end - first) * 6, 1, first * 6, 0);
+  }
+}
\ No newline at end of file
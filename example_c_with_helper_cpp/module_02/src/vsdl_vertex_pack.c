@@ -0,0 +1,104 @@
+#include "vsdl_vertex_pack.h"
+#include "vsdl_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+const VkFormat vsdl_packed_vertex_formats[VSDL_PACKED_VERTEX_FORMAT_COUNT] = {
+    VK_FORMAT_R16G16B16A16_SFLOAT, // location 0: inPosition
+    VK_FORMAT_R8G8B8A8_UNORM,      // location 1: inColor
+    VK_FORMAT_R16G16_UNORM         // location 2: inTexCoord
+};
+
+#define VSDL_PACK_EMPTY_SLOT 0xFFFFFFFFu
+
+uint16_t vsdl_float_to_half(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+  uint32_t exponent = (bits >> 23) & 0xFFu;
+  if (exponent == 0xFFu) {
+      return (uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u)); // Infinity or quiet NaN
+  }
+
+  int32_t halfExponent = (int32_t)exponent - 127 + 15;
+  if (halfExponent >= 0x1F) {
+      return (uint16_t)(sign | 0x7C00u);
+  }
+  if (halfExponent <= 0) {
+      // Subnormal half: shift the implicit bit into the mantissa
+      if (halfExponent < -10) return (uint16_t)sign;
+      mantissa |= 0x800000u;
+      uint32_t shift = (uint32_t)(14 - halfExponent);
+      uint32_t half = mantissa >> shift;
+      uint32_t rest = mantissa & ((1u << shift) - 1u);
+      uint32_t halfway = 1u << (shift - 1u);
+      if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+      return (uint16_t)(sign | half);
+  }
+
+  uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+  uint32_t rest = mantissa & 0x1FFFu;
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++; // A carry into the exponent is still correct
+  return (uint16_t)(sign | half);
+}
+
+static uint32_t to_unorm(float value, float scale) {
+  if (!(value > 0.0f)) return 0; // Also catches NaN
+  if (value >= 1.0f) return (uint32_t)scale;
+  return (uint32_t)(value * scale + 0.5f);
+}
+
+void vsdl_pack_vertex(const float* vertex, PackedVertex* packed) {
+  packed->position[0] = vsdl_float_to_half(vertex[0]);
+  packed->position[1] = vsdl_float_to_half(vertex[1]);
+  packed->position[2] = vsdl_float_to_half(vertex[2]);
+  packed->position[3] = 0x3C00u; // 1.0
+  packed->color[0] = (uint8_t)to_unorm(vertex[3], 255.0f);
+  packed->color[1] = (uint8_t)to_unorm(vertex[4], 255.0f);
+  packed->color[2] = (uint8_t)to_unorm(vertex[5], 255.0f);
+  packed->color[3] = 255;
+  packed->uv[0] = (uint16_t)to_unorm(vertex[6], 65535.0f);
+  packed->uv[1] = (uint16_t)to_unorm(vertex[7], 65535.0f);
+}
+
+static uint32_t hash_packed_vertex(const PackedVertex* vertex) {
+  uint64_t words[2];
+  memcpy(words, vertex, sizeof(words));
+  uint64_t h = words[0] * 0x9E3779B97F4A7C15ull ^ (words[1] + 0x632BE59BD9B4E019ull);
+  h ^= h >> 32;
+  h *= 0xD6E8FEB86659FD93ull;
+  h ^= h >> 32;
+  return (uint32_t)h;
+}
+
+uint32_t vsdl_pack_mesh(const float* vertices, uint32_t vertexCount, PackedVertex* outVertices, uint32_t* outIndices) {
+  // Open addressing at load factor <= 0.5, slots hold indices into outVertices
+  uint32_t tableSize = 16;
+  while (tableSize < vertexCount * 2u) tableSize *= 2;
+  uint32_t* table = malloc(tableSize * sizeof(uint32_t));
+  if (!table) {
+      vsdl_log("Failed to allocate vertex dedup table (%u slots)\n", tableSize);
+      exit(1);
+  }
+  memset(table, 0xFF, tableSize * sizeof(uint32_t));
+
+  uint32_t uniqueCount = 0;
+  for (uint32_t i = 0; i < vertexCount; i++) {
+      PackedVertex packed;
+      vsdl_pack_vertex(vertices + (size_t)i * VSDL_VERTEX_FLOATS, &packed);
+      uint32_t slot = hash_packed_vertex(&packed) & (tableSize - 1u);
+      while (table[slot] != VSDL_PACK_EMPTY_SLOT &&
+             memcmp(&outVertices[table[slot]], &packed, sizeof(PackedVertex)) != 0) {
+          slot = (slot + 1u) & (tableSize - 1u);
+      }
+      if (table[slot] == VSDL_PACK_EMPTY_SLOT) {
+          table[slot] = uniqueCount;
+          outVertices[uniqueCount++] = packed;
+      }
+      outIndices[i] = table[slot];
+  }
+
+  free(table);
+  return uniqueCount;
+}
\ No newline at end of file
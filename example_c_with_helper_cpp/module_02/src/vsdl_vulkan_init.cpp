@@ -10,9 +10,11 @@ extern "C" void init_vulkan(SDL_Window* window, VkInstance* instance, VkPhysical
                            VkQueue* graphicsQueue, VkSurfaceKHR* surface, VkSwapchainKHR* swapchain, uint32_t* imageCount,
                            VkImage** swapchainImages, VkImageView** swapchainImageViews, uint32_t* graphicsQueueFamilyIndex) {
     vkb::InstanceBuilder builder;
+    // Headless (no window): no surface extensions, so it runs without a display
     builder.set_app_name("Vulkan SDL3")
            .set_engine_name("Custom")
-           .require_api_version(1, 3, 0);
+           .require_api_version(1, 3, 0)
+           .set_headless(window == NULL);
 #ifdef _DEBUG
     builder.request_validation_layers()
            .add_validation_feature_enable(VK_VALIDATION_FEATURE_ENABLE_BEST_PRACTICES_EXT);
@@ -24,14 +26,28 @@ extern "C" void init_vulkan(SDL_Window* window, VkInstance* instance, VkPhysical
     }
     *instance = inst_ret.value();
 
-    if (!SDL_Vulkan_CreateSurface(window, *instance, NULL, surface)) {
+    if (window && !SDL_Vulkan_CreateSurface(window, *instance, NULL, surface)) {
         fprintf(stderr, "Failed to create Vulkan surface: %s\n", SDL_GetError());
         exit(1);
     }
 
+    // Bindless texture table (vsdl_bindless.h): descriptor indexing is core since 1.2
+    VkPhysicalDeviceFeatures features = {};
+    features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+    VkPhysicalDeviceVulkan12Features features12 = {};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.descriptorIndexing = VK_TRUE;
+    features12.runtimeDescriptorArray = VK_TRUE;
+    features12.descriptorBindingPartiallyBound = VK_TRUE;
+    features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+
     vkb::PhysicalDeviceSelector phys_selector{inst_ret.value()};
-    phys_selector.set_surface(*surface)
-                 .set_minimum_version(1, 3)
+    if (window) {
+        phys_selector.set_surface(*surface);
+    }
+    phys_selector.set_minimum_version(1, 3)
+                 .set_required_features(features)
+                 .set_required_features_12(features12)
                  .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete);
     auto phys_ret = phys_selector.select();
     if (!phys_ret) {
@@ -56,6 +72,26 @@ extern "C" void init_vulkan(SDL_Window* window, VkInstance* instance, VkPhysical
     *graphicsQueue = queue_ret.value();
     *graphicsQueueFamilyIndex = dev_ret.value().get_queue_index(vkb::QueueType::graphics).value();
 
+    VmaAllocatorCreateInfo allocatorInfo = {};
+    allocatorInfo.physicalDevice = *physicalDevice;
+    allocatorInfo.device = *device;
+    allocatorInfo.instance = *instance;
+    allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
+    if (vmaCreateAllocator(&allocatorInfo, &allocator) != VK_SUCCESS) {
+        fprintf(stderr, "Failed to create VMA allocator\n");
+        exit(1);
+    }
+
+    // Headless: vsdl_headless_init supplies the images instead
+    if (!window) {
+        *surface = VK_NULL_HANDLE;
+        *swapchain = VK_NULL_HANDLE;
+        *imageCount = 0;
+        *swapchainImages = NULL;
+        *swapchainImageViews = NULL;
+        return;
+    }
+
     vkb::SwapchainBuilder swapchain_builder{dev_ret.value()};
     swapchain_builder.set_desired_format({VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR})
                      .set_desired_present_mode(VK_PRESENT_MODE_FIFO_KHR)
@@ -78,14 +114,4 @@ extern "C" void init_vulkan(SDL_Window* window, VkInstance* instance, VkPhysical
     for (uint32_t i = 0; i < *imageCount; i++) {
         (*swapchainImageViews)[i] = image_views[i];
     }
-
-    VmaAllocatorCreateInfo allocatorInfo = {};
-    allocatorInfo.physicalDevice = *physicalDevice;
-    allocatorInfo.device = *device;
-    allocatorInfo.instance = *instance;
-    allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
-    if (vmaCreateAllocator(&allocatorInfo, &allocator) != VK_SUCCESS) {
-        fprintf(stderr, "Failed to create VMA allocator\n");
-        exit(1);
-    }
 }
\ No newline at end of file
@@ -144,6 +144,8 @@ void cleanup(VkInstance instance, VkSurfaceKHR surface, VkDevice device, VkComma
     SDL_Quit();
 }
 
+// renderPass is VK_NULL_HANDLE with dynamic rendering: no framebuffers are made,
+// so a resize only rebuilds the image views and re-records the command buffers
 void recreateSwapchain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, SDL_Window* window,
                        VkRenderPass renderPass, VkPipeline graphicsPipeline, VkPipelineLayout pipelineLayout,
                        VkCommandPool commandPool, VkBuffer vertexBuffer, SwapchainData& swapchainData,
@@ -156,6 +158,7 @@ void recreateSwapchain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfa
     for (auto framebuffer : swapchainData.framebuffers) {
         vkDestroyFramebuffer(device, framebuffer, nullptr);
     }
+    swapchainData.framebuffers.clear();
     for (auto imageView : swapchainData.imageViews) {
         vkDestroyImageView(device, imageView, nullptr);
     }
@@ -236,8 +239,10 @@ void recreateSwapchain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfa
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully recreated %u image views", imageCount);
 
-    swapchainData.framebuffers.resize(imageCount);
-    for (size_t i = 0; i < imageCount; i++) {
+    if (renderPass != VK_NULL_HANDLE) {
+        swapchainData.framebuffers.resize(imageCount);
+    }
+    for (size_t i = 0; i < swapchainData.framebuffers.size(); i++) {
         VkImageView attachments[] = {swapchainData.imageViews[i]};
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -253,7 +258,7 @@ void recreateSwapchain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfa
             return;
         }
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully recreated %u framebuffers", imageCount);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully recreated %zu framebuffers", swapchainData.framebuffers.size());
 
     commandBuffers.resize(imageCount);
     VkCommandBufferAllocateInfo allocInfoCmd{};
@@ -291,23 +296,67 @@ void recreateSwapchain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfa
         scissor.extent = extent;
         vkCmdSetScissor(commandBuffers[i], 0, 1, &scissor);
 
-        VkRenderPassBeginInfo rpBeginInfo{};
-        rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        rpBeginInfo.renderPass = renderPass;
-        rpBeginInfo.framebuffer = swapchainData.framebuffers[i];
-        rpBeginInfo.renderArea.offset = {0, 0};
-        rpBeginInfo.renderArea.extent = extent;
         VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-        rpBeginInfo.clearValueCount = 1;
-        rpBeginInfo.pClearValues = &clearColor;
+        // Without a render pass the layout transitions are barriers of our own
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = swapchainData.images[i];
+        imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        if (renderPass != VK_NULL_HANDLE) {
+            VkRenderPassBeginInfo rpBeginInfo{};
+            rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            rpBeginInfo.renderPass = renderPass;
+            rpBeginInfo.framebuffer = swapchainData.framebuffers[i];
+            rpBeginInfo.renderArea.offset = {0, 0};
+            rpBeginInfo.renderArea.extent = extent;
+            rpBeginInfo.clearValueCount = 1;
+            rpBeginInfo.pClearValues = &clearColor;
+            vkCmdBeginRenderPass(commandBuffers[i], &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        } else {
+            imageBarrier.srcAccessMask = 0;
+            imageBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            imageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            vkCmdPipelineBarrier(commandBuffers[i], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+            VkRenderingAttachmentInfo colorAttachment{};
+            colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            colorAttachment.imageView = swapchainData.imageViews[i];
+            colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            colorAttachment.clearValue = clearColor;
+            VkRenderingInfo renderingInfo{};
+            renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+            renderingInfo.renderArea.offset = {0, 0};
+            renderingInfo.renderArea.extent = extent;
+            renderingInfo.layerCount = 1;
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachments = &colorAttachment;
+            vkCmdBeginRendering(commandBuffers[i], &renderingInfo);
+        }
 
-        vkCmdBeginRenderPass(commandBuffers[i], &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
         vkCmdBindPipeline(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
         VkBuffer vertexBuffers[] = {vertexBuffer};
         VkDeviceSize offsets[] = {0};
         vkCmdBindVertexBuffers(commandBuffers[i], 0, 1, vertexBuffers, offsets);
         vkCmdDraw(commandBuffers[i], static_cast<uint32_t>(vertices.size()), 1, 0, 0);
-        vkCmdEndRenderPass(commandBuffers[i]);
+
+        if (renderPass != VK_NULL_HANDLE) {
+            vkCmdEndRenderPass(commandBuffers[i]);
+        } else {
+            vkCmdEndRendering(commandBuffers[i]);
+            // Present waits on the submit's semaphore, so nothing has to wait here
+            imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            imageBarrier.dstAccessMask = 0;
+            imageBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            vkCmdPipelineBarrier(commandBuffers[i], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+        }
 
         if (vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to record command buffer %zu during swapchain recreation", i);
@@ -361,7 +410,7 @@ int main(int argc, char* argv[]) {
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "No Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    appInfo.apiVersion = VK_API_VERSION_1_3; // Dynamic rendering when the device has it
 
     const char* validationLayers[] = {"VK_LAYER_KHRONOS_validation"};
     VkInstanceCreateInfo createInfo{};
@@ -457,9 +506,28 @@ int main(int argc, char* argv[]) {
         queueCreateInfos.push_back(presentQueueCreateInfo);
     }
 
+    // Vulkan 1.3 devices render with vkCmdBeginRendering: no render pass has to
+    // exist before the pipeline, and no framebuffers are rebuilt on resize
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+    VkPhysicalDeviceVulkan13Features features13{};
+    features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    if (deviceProperties.apiVersion >= VK_API_VERSION_1_3) {
+        VkPhysicalDeviceFeatures2 supportedFeatures{};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &features13;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+    }
+    bool dynamicRendering = features13.dynamicRendering == VK_TRUE;
+    VkPhysicalDeviceVulkan13Features enabledFeatures13{};
+    enabledFeatures13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    enabledFeatures13.dynamicRendering = VK_TRUE;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Rendering with %s", dynamicRendering ? "dynamic rendering" : "a render pass");
+
     VkPhysicalDeviceFeatures deviceFeatures{};
     VkDeviceCreateInfo deviceCreateInfo{};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = dynamicRendering ? &enabledFeatures13 : nullptr;
     deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
     deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
@@ -607,14 +675,16 @@ int main(int argc, char* argv[]) {
     renderPassInfo.pSubpasses = &subpass;
 
     VkRenderPass renderPass = VK_NULL_HANDLE;
-    if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+    if (!dynamicRendering && vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render pass");
         cleanup(instance, surface, device, commandPool, allocator, vertexBuffer, vertexBufferAllocation,
                 VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, SwapchainData(), std::vector<VkCommandBuffer>(),
                 VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, window);
         return 1;
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully created render pass");
+    if (renderPass != VK_NULL_HANDLE) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully created render pass");
+    }
 
     std::vector<char> vertShaderCode = readFile("shaders/triangle.vert.spv");
     std::vector<char> fragShaderCode = readFile("shaders/triangle.frag.spv");
@@ -747,6 +817,14 @@ int main(int argc, char* argv[]) {
     pipelineInfo.layout = pipelineLayout;
     pipelineInfo.renderPass = renderPass;
     pipelineInfo.subpass = 0;
+    // With dynamic rendering the pipeline names its attachment formats instead
+    VkPipelineRenderingCreateInfo renderingCreateInfo{};
+    renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+    renderingCreateInfo.colorAttachmentCount = 1;
+    renderingCreateInfo.pColorAttachmentFormats = &colorAttachment.format;
+    if (dynamicRendering) {
+        pipelineInfo.pNext = &renderingCreateInfo;
+    }
 
     VkPipeline graphicsPipeline = VK_NULL_HANDLE;
     if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
@@ -857,8 +935,6 @@ int main(int argc, char* argv[]) {
             continue;
         }
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Presented image %u", imageIndex);
-
-        SDL_Delay(16);
     }
 
     cleanup(instance, surface, device, commandPool, allocator, vertexBuffer, vertexBufferAllocation,
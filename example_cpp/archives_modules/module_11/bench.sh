@@ -0,0 +1,85 @@
+#!/bin/sh
+# Headless frame-time benchmark on lavapipe (Mesa's CPU Vulkan driver).
+# Runs the renderer under SDL's offscreen video driver with 1, 2 and 3 frames
+# in flight, then 10k and 100k instances drawn per instance ("direct") and
+# batched through indirect commands ("indirect"), then pipeline creation with
+# a cold and a warm pipeline cache, then a resize storm (bursts of scripted
+# window resizes every frame), then frame pacing with a frame rate cap and with
+# vsync, then record time with and without the command cache for a static
+# 100k instance scene, then the scene at half resolution, then the resize storm
+# with dynamic rendering, then the headless backend (no window, surface or
+# swapchain), and prints the [bench] summary lines for each run.
+#
+# With GOLDEN=path/to/frame.ppm the headless run also reads back its last frame
+# and fails when it differs from that image.
+#
+#   ./bench.sh [frames] [meshes]   (after building into ./build)
+set -e
+
+FRAMES=${1:-600}
+MESHES=${2:-256}
+
+cd "$(dirname "$0")/build/Debug"
+EXECUTABLE=../VulkanTriangle
+if [ ! -x "$EXECUTABLE" ]; then
+    EXECUTABLE=./VulkanTriangle
+fi
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Executable not found! Please build the project first."
+    exit 1
+fi
+
+export SDL_VIDEO_DRIVER=offscreen
+if [ -z "$VK_DRIVER_FILES" ] && [ -z "$VK_ICD_FILENAMES" ]; then
+    for icd in /usr/share/vulkan/icd.d/lvp_icd.*.json; do
+        [ -f "$icd" ] && export VK_DRIVER_FILES="$icd"
+    done
+fi
+
+for fif in 1 2 3; do
+    "$EXECUTABLE" --frames-in-flight "$fif" --bench-frames "$FRAMES" --bench-meshes "$MESHES" 2>&1 | grep "\[bench\]"
+done
+
+for instances in 10000 100000; do
+    for mode in direct indirect; do
+        "$EXECUTABLE" --bench-frames "$FRAMES" --bench-meshes "$instances" --draw-mode "$mode" 2>&1 | grep "\[bench\]"
+    done
+done
+
+# First run starts without a cache file and writes one; the second loads it
+CACHE=bench_pipeline_cache.bin
+rm -f "$CACHE"
+for run in cold warm; do
+    "$EXECUTABLE" --bench-frames 1 --pipeline-cache "$CACHE" 2>&1 | grep "\[bench\] pipeline"
+done
+rm -f "$CACHE"
+
+# Four SDL_SetWindowSize calls per frame; reports rebuilds and time spent in each
+"$EXECUTABLE" --bench-frames 300 --bench-resize 4 2>&1 | grep "\[bench\]"
+
+# Frame pacing: jitter and input latency under a 60 fps cap and with vsync
+for pacing in "cap" "vsync"; do
+    "$EXECUTABLE" --bench-frames 300 --pacing "$pacing" 2>&1 | grep "\[bench\] \(pacing\|input\)"
+done
+
+# Static scene: the cache re-records once per frame slot and image, then only
+# the primary buffer around the render pass is recorded
+for cache in "" "--command-cache"; do
+    "$EXECUTABLE" --bench-frames "$FRAMES" --bench-meshes 100000 $cache 2>&1 | grep "\[bench\] \(frames-in-flight=2 record\|command cache\)"
+done
+
+# Scene at half resolution in a transient image, blitted up by a second pass
+"$EXECUTABLE" --bench-frames "$FRAMES" --bench-meshes "$MESHES" --render-scale 0.5 2>&1 | grep "\[bench\]"
+
+# Resize storm again without framebuffers: rebuilds only touch image views
+"$EXECUTABLE" --bench-frames 300 --bench-resize 4 --dynamic-rendering 2>&1 | grep "\[bench\] \(resize\|render graph\)"
+
+# Offscreen images instead of a swapchain; the same binary runs on GPU-less CI
+if [ -n "$GOLDEN" ]; then
+    STATUS=0
+    OUTPUT=$("$EXECUTABLE" --headless --bench-frames "$FRAMES" --bench-meshes "$MESHES" --golden "$GOLDEN" 2>&1) || STATUS=$?
+    echo "$OUTPUT" | grep "\[bench\]"
+    exit $STATUS
+else
+    "$EXECUTABLE" --headless --bench-frames "$FRAMES" --bench-meshes "$MESHES" 2>&1 | grep "\[bench\]"
+fi
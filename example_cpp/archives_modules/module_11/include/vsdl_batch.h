@@ -0,0 +1,14 @@
+// vsdl_batch.h
+#ifndef VSDL_BATCH_H
+#define VSDL_BATCH_H
+
+#include "vsdl_types.h"
+
+// Groups ctx.meshes by MeshType and writes their InstanceData and indirect
+// commands into this frame's instanceRing region.
+bool build_draw_batches(VSDL_Context& ctx, DrawBatches& batches);
+// Binds the arena and instance buffers and records the draws for batches.
+// Returns the number of draw commands recorded.
+uint32_t record_draw_batches(VSDL_Context& ctx, VkCommandBuffer commandBuffer, const DrawBatches& batches);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+// vsdl_bench.h
+#ifndef VSDL_BENCH_H
+#define VSDL_BENCH_H
+
+#include <vector>
+
+struct FrameTimeStats {
+  size_t count = 0;
+  double avgMs = 0.0;
+  double minMs = 0.0;
+  double maxMs = 0.0;
+  double p50Ms = 0.0;
+  double p95Ms = 0.0;
+  double p99Ms = 0.0;
+};
+
+FrameTimeStats compute_frame_time_stats(std::vector<double> samplesMs);
+void log_frame_time_stats(const char* label, const FrameTimeStats& stats);
+
+#endif
@@ -0,0 +1,26 @@
+// vsdl_command_cache.h
+#ifndef VSDL_COMMAND_CACHE_H
+#define VSDL_COMMAND_CACHE_H
+
+#include "vsdl_types.h"
+
+// Creates the pool the cached secondary command buffers come from (--command-cache)
+bool command_cache_create(VSDL_Context& ctx);
+// Only once no frame that executes a cached buffer is in flight
+void command_cache_destroy(VSDL_Context& ctx);
+// Marks every cached buffer stale: the mesh set, pipeline or framebuffers changed.
+// Cheap enough to call once per added instance.
+void command_cache_invalidate(VSDL_Context& ctx);
+// Entry for a frame slot and framebuffer image, allocating its buffer on first use.
+// A slot's entries are only re-recorded after that slot's fence has signaled,
+// so none of them can be pending when it is reset.
+CachedCommands& command_cache_entry(VSDL_Context& ctx, uint32_t frameSlot, uint32_t imageIndex);
+// Whether entry still matches the scene; uboOffset and framebuffer are baked into it
+bool command_cache_valid(const VSDL_Context& ctx, const CachedCommands& entry, uint32_t uboOffset,
+                         VkFramebuffer framebuffer);
+// Begins re-recording entry as render pass contents for framebuffer, which is
+// VK_NULL_HANDLE with dynamic rendering
+bool command_cache_begin(VSDL_Context& ctx, CachedCommands& entry, uint32_t uboOffset, VkFramebuffer framebuffer);
+bool command_cache_end(VSDL_Context& ctx, CachedCommands& entry, uint32_t drawCalls);
+
+#endif
\ No newline at end of file
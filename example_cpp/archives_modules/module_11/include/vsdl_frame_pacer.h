@@ -0,0 +1,74 @@
+// vsdl_frame_pacer.h
+#ifndef VSDL_FRAME_PACER_H
+#define VSDL_FRAME_PACER_H
+
+#include <SDL3/SDL.h>
+#include <vulkan/vulkan.h>
+#include <vector>
+
+#define VSDL_PACER_INPUT_SLOTS 8             // Presents whose input time is kept until they reach the display
+#define VSDL_PACER_PRESENT_TIMEOUT_NS 100000000ull // vkWaitForPresentKHR gives up after 100ms
+#define VSDL_PACER_SAFETY_MS 1.0             // Slack left before the predicted vblank
+#define VSDL_PACER_MIN_SPIN_US 200           // Bounds of the busy-wait tail after a sleep
+#define VSDL_PACER_MAX_SPIN_US 4000
+
+// How frames are paced, and which present modes the swapchain asks for (--pacing)
+enum class PacingMode {
+  VSYNC,    // FIFO. With present_wait, input is sampled just in time for the next vblank
+  ADAPTIVE, // FIFO_RELAXED when supported: a late frame tears instead of waiting a whole refresh
+  CAP,      // MAILBOX (IMMEDIATE with --allow-tearing), CPU-paced to --fps-cap
+  UNCAPPED  // MAILBOX (IMMEDIATE with --allow-tearing), never waits
+};
+
+struct FramePacer {
+  PacingMode mode = PacingMode::UNCAPPED;
+  bool allowTearing = false;
+  VkPresentModeKHR presentMode = VK_PRESENT_MODE_MAX_ENUM_KHR; // Last mode picked for the swapchain, none when headless
+  double refreshHz = 0.0;     // Display refresh rate, 0 when SDL does not know it
+  Uint64 intervalTicks = 0;   // CAP: frame interval; VSYNC/ADAPTIVE: refresh period
+  Uint64 deadlineTicks = 0;   // CAP: when the next frame may begin
+  Uint64 spinTicks = 0;       // Tail of each wait spent spinning, follows the measured sleep overshoot
+  double cpuWorkMs = 0.0;     // Smoothed time from input sampling to present
+  double gpuWorkMs = 0.0;     // Smoothed GPU frame time from the profiler
+
+  // VK_KHR_present_id + VK_KHR_present_wait
+  bool presentWait = false;
+  uint64_t presentId = 0;     // Last id passed to vkQueuePresentKHR
+  uint64_t waitedId = 0;      // Last id vkWaitForPresentKHR returned for
+  VkSwapchainKHR presentSwapchain = VK_NULL_HANDLE; // Swapchain the ids were presented to
+  Uint64 inputTicks[VSDL_PACER_INPUT_SLOTS] = {};   // Input time per id, indexed by id % slots
+  Uint64 lastDisplayTicks = 0; // When waitedId was reported on screen, 0 after a resync
+
+  // Benchmark samples, collected while recording is set
+  bool recording = false;
+  std::vector<double> waitMs;
+  std::vector<double> inputToPresentMs;
+  std::vector<double> inputToDisplayMs;
+};
+
+const char* pacing_mode_name(PacingMode mode);
+// Parses "vsync", "adaptive", "cap" or "uncapped"; returns false for anything else
+bool pacing_mode_parse(const char* name, PacingMode* mode);
+
+// Reads the refresh rate of the window's display. fpsCap is only used by CAP,
+// presentWait is whether the device enabled present_id and present_wait.
+void frame_pacer_init(FramePacer& pacer, PacingMode mode, uint32_t fpsCap, bool allowTearing,
+                      bool presentWait, SDL_Window* window);
+// Present mode for a new swapchain, the first supported one in the mode's preference list
+VkPresentModeKHR frame_pacer_choose_present_mode(FramePacer& pacer, VkPhysicalDevice physicalDevice,
+                                                 VkSurfaceKHR surface);
+// Call at the top of the frame, before input is polled. In VSYNC/ADAPTIVE waits
+// for the previous present to reach the display (present_wait), then until the
+// frame should start; returns the input sampling time to pass to the calls below.
+Uint64 frame_pacer_begin_frame(FramePacer& pacer, VkDevice device, VkSwapchainKHR swapchain);
+// Tags the present with an id when present_wait is on. Returns the pNext for
+// VkPresentInfoKHR, or nullptr; presentIdInfo must live until the present call.
+const void* frame_pacer_present_id(FramePacer& pacer, VkSwapchainKHR swapchain, Uint64 inputTicks,
+                                   VkPresentIdKHR& presentIdInfo);
+// Call after the present: updates the work estimates used to place the next frame.
+// gpuMs is the latest resolved GPU frame time, or 0.
+void frame_pacer_end_frame(FramePacer& pacer, Uint64 inputTicks, double gpuMs);
+// Logs jitter against the target interval and the input latency samples
+void frame_pacer_log_stats(const FramePacer& pacer, const std::vector<double>& frameTimesMs);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+// vsdl_headless.h
+#ifndef VSDL_HEADLESS_H
+#define VSDL_HEADLESS_H
+
+#include "vsdl_types.h"
+
+#define VSDL_HEADLESS_WIDTH 800
+#define VSDL_HEADLESS_HEIGHT 600
+#define VSDL_HEADLESS_FORMAT VK_FORMAT_B8G8R8A8_SRGB // Same as the preferred swapchain format
+#define VSDL_GOLDEN_MAX_DIFF_FRACTION 0.001          // Pixels allowed past goldenTolerance
+
+// Creates options.headlessImages offscreen color images and views in place of
+// a swapchain, plus the readback buffer when --readback or --golden is set
+bool headless_create(VSDL_Context& ctx);
+// Destroys the images, their views and the readback buffer
+void headless_destroy(VSDL_Context& ctx);
+// Stands in for vkAcquireNextImageKHR: the next image of the ring
+uint32_t headless_acquire(VSDL_Context& ctx);
+// Copies image imageIndex (left in TRANSFER_SRC_OPTIMAL by the render graph)
+// into the readback buffer, then writes options.readbackPath and/or compares
+// it with options.goldenPath. Call once the device is idle.
+bool headless_readback(VSDL_Context& ctx, uint32_t imageIndex);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+// vsdl_linear_alloc.h
+#ifndef VSDL_LINEAR_ALLOC_H
+#define VSDL_LINEAR_ALLOC_H
+
+#include "vsdl_types.h"
+
+bool linear_alloc_create(VSDL_Context& ctx, LinearAllocator& ring, VkBufferUsageFlags usage,
+                         VkDeviceSize regionSize, uint32_t regionCount, VkDeviceSize alignment);
+void linear_alloc_destroy(VSDL_Context& ctx, LinearAllocator& ring);
+// Switch to the region owned by frameIndex; call after that frame's fence has signaled.
+void linear_alloc_begin_frame(LinearAllocator& ring, uint32_t frameIndex);
+// Returns a CPU pointer to size bytes and the buffer offset of that memory,
+// or nullptr when the region is exhausted.
+void* linear_alloc(LinearAllocator& ring, VkDeviceSize size, VkDeviceSize* outOffset);
+// Make this frame's writes visible to the device (no-op on HOST_COHERENT memory).
+void linear_alloc_flush(VSDL_Context& ctx, LinearAllocator& ring);
+
+#endif
@@ -4,9 +4,12 @@
 
 #include "vsdl_types.h"
 
-bool create_triangle_buffer(VSDL_Context& ctx);
-bool destroy_mesh(VSDL_Context& ctx); // Added
-bool create_plane_buffer(VSDL_Context& ctx);
-bool destroy_mesh(VSDL_Context& ctx);
+// Uploads the shared triangle and plane geometry into the mesh arena
+bool create_mesh_geometry(VSDL_Context& ctx);
+bool add_mesh_instance(VSDL_Context& ctx, MeshType type, float x, float y, float scale, float rotation);
+bool create_triangle_instance(VSDL_Context& ctx);
+bool create_plane_instance(VSDL_Context& ctx);
+bool destroy_mesh_instance(VSDL_Context& ctx);
 bool create_uniform_buffer(VSDL_Context& ctx);
+bool create_instance_buffer(VSDL_Context& ctx);
 #endif
\ No newline at end of file
@@ -0,0 +1,17 @@
+// vsdl_mesh_arena.h
+#ifndef VSDL_MESH_ARENA_H
+#define VSDL_MESH_ARENA_H
+
+#include "vsdl_types.h"
+
+void range_allocator_init(RangeAllocator& ranges, uint32_t capacity);
+bool range_alloc(RangeAllocator& ranges, uint32_t count, uint32_t* outOffset);
+void range_free(RangeAllocator& ranges, uint32_t offset, uint32_t count);
+
+bool create_mesh_arena(VSDL_Context& ctx);
+void destroy_mesh_arena(VSDL_Context& ctx);
+// Reserves arena ranges for mesh and uploads its vertex/index data
+bool mesh_arena_upload(VSDL_Context& ctx, Mesh& mesh, const Vertex* vertices, uint32_t vertexCount,
+                       const uint32_t* indices, uint32_t indexCount);
+
+#endif
@@ -0,0 +1,15 @@
+// vsdl_pipeline_cache.h
+#ifndef VSDL_PIPELINE_CACHE_H
+#define VSDL_PIPELINE_CACHE_H
+
+#include "vsdl_types.h"
+
+// Creates ctx.pipelineCache, seeded from options.pipelineCachePath when the
+// file's header matches this device. Never fails on a missing or stale file.
+bool pipeline_cache_load(VSDL_Context& ctx);
+// Writes the cache to a temporary file and renames it over the old one. Skipped
+// unless a pipeline was created since loading and the data grew.
+bool pipeline_cache_save(VSDL_Context& ctx);
+void pipeline_cache_destroy(VSDL_Context& ctx);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+// vsdl_render_graph.h
+#ifndef VSDL_RENDER_GRAPH_H
+#define VSDL_RENDER_GRAPH_H
+
+#include "vsdl_types.h"
+
+#define VSDL_RENDER_GRAPH_MAX_USES 8 // Images one pass may touch
+
+// Declaration, once before render_graph_compile. Every call returns an index into
+// graph.images or graph.passes.
+uint32_t render_graph_import_backbuffer(RenderGraph& graph, const char* name, VkFormat format, VkImageLayout finalLayout);
+// Transient image, created and aliased by render_graph_create_targets
+uint32_t render_graph_create_image(RenderGraph& graph, const char* name, VkFormat format, float scale);
+uint32_t render_graph_add_pass(RenderGraph& graph, const char* name, RenderGraphRecordFn record);
+// CLEAR or DONT_CARE writes the attachment from scratch; LOAD also reads it
+void render_graph_color(RenderGraph& graph, uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearValue clearValue);
+void render_graph_depth(RenderGraph& graph, uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearValue clearValue);
+// SAMPLED or TRANSFER_SRC
+void render_graph_read(RenderGraph& graph, uint32_t pass, uint32_t image, RenderGraphUsage usage);
+// TRANSFER_DST
+void render_graph_write(RenderGraph& graph, uint32_t pass, uint32_t image, RenderGraphUsage usage);
+
+// Culls passes, computes lifetimes and barriers and creates the render passes,
+// or with graph.dynamicRendering only records each pass's attachment formats.
+// Needs only formats, so it runs before the pipelines are built.
+bool render_graph_compile(VSDL_Context& ctx, RenderGraph& graph);
+// Transient images, their shared memory, views and (without dynamic rendering)
+// framebuffers for the current ctx.swapchainExtent and ctx.swapchainImageViews
+bool render_graph_create_targets(VSDL_Context& ctx, RenderGraph& graph);
+// Hands the targets to a retired swapchain, freed once its frames complete
+void render_graph_retire_targets(RenderGraph& graph, RetiredSwapchain& retired);
+void render_graph_destroy(VSDL_Context& ctx, RenderGraph& graph);
+
+// VK_NULL_HANDLE with dynamic rendering
+VkFramebuffer render_graph_framebuffer(const RenderGraph& graph, uint32_t pass, uint32_t imageIndex);
+// Image behind an index during render_graph_execute, the current backbuffer for the import
+VkImage render_graph_image(const VSDL_Context& ctx, const RenderGraph& graph, uint32_t image);
+// Records every pass that was not culled, with its barriers, into commandBuffer
+void render_graph_execute(VSDL_Context& ctx, RenderGraph& graph, VkCommandBuffer commandBuffer, uint32_t imageIndex);
+
+#endif
\ No newline at end of file
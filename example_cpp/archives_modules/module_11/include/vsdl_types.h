@@ -5,6 +5,17 @@
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h> // Add this for VmaAllocator and VmaAllocation
 #include <vector>
+#include "vsdl_profiler.h"
+#include "vsdl_frame_pacer.h"
+
+#define VSDL_MAX_FRAMES_IN_FLIGHT 3
+#define VSDL_UNIFORM_RING_REGION_SIZE (64 * 1024) // Bytes of uniform data per frame
+#define VSDL_MESH_ARENA_VERTICES (256 * 1024)
+#define VSDL_MESH_ARENA_INDICES (512 * 1024)
+#define VSDL_MAX_INSTANCES (128 * 1024) // Instances the per-frame instance ring can hold
+#define VSDL_MESH_TYPE_COUNT 2
+#define VSDL_STAGING_RING_SIZE (8 * 1024 * 1024) // Bytes of persistently mapped staging memory
+#define VSDL_UPLOAD_BATCHES 4                    // Upload submissions that may be in flight at once
 
 struct Vertex {
   float pos[2];
@@ -15,18 +26,295 @@ struct UniformBufferObject {
   float transform[16];
 };
 
-enum class MeshType { TRIANGLE, PLANE };
+// Per-instance vertex attributes (binding 1), expanded in tri.vert
+struct InstanceData {
+  float offset[2];
+  float scale;
+  float rotation; // Radians
+};
+
+enum class MeshType { TRIANGLE, PLANE }; // Indexes VSDL_Context::meshGeometry
 
+// A mesh is a pair of ranges inside the shared MeshArena buffers
 struct Mesh {
+  uint32_t vertexOffset = 0; // First vertex in MeshArena::vertexBuffer
+  uint32_t vertexCount = 0;
+  uint32_t firstIndex = 0;   // First index in MeshArena::indexBuffer
+  uint32_t indexCount = 0;   // 3 for triangles, 6 for planes
+  MeshType type = MeshType::TRIANGLE;
+};
+
+// One drawable copy of the shared geometry for its type
+struct MeshInstance {
+  MeshType type = MeshType::TRIANGLE;
+  InstanceData data = {{0.0f, 0.0f}, 1.0f, 0.0f};
+};
+
+// First-fit free list over [0, capacity) elements, sorted by offset and
+// coalesced on free
+struct RangeAllocator {
+  struct Range {
+    uint32_t offset;
+    uint32_t count;
+  };
+  uint32_t capacity = 0;
+  std::vector<Range> freeRanges;
+};
+
+// One device-local vertex buffer and one index buffer shared by every Mesh,
+// so the draw loop binds them once and selects meshes via firstIndex/vertexOffset
+struct MeshArena {
   VkBuffer vertexBuffer = VK_NULL_HANDLE;
   VmaAllocation vertexAllocation = VK_NULL_HANDLE;
-  VkBuffer indexBuffer = VK_NULL_HANDLE; // Optional, used for planes
+  void* vertexMapped = nullptr; // Non-null when VMA picked host-visible memory
+  VkBuffer indexBuffer = VK_NULL_HANDLE;
   VmaAllocation indexAllocation = VK_NULL_HANDLE;
-  uint32_t indexCount = 0; // 0 for triangles, 6 for planes
-  MeshType type = MeshType::TRIANGLE;
+  void* indexMapped = nullptr;
+  RangeAllocator vertexRanges;
+  RangeAllocator indexRanges;
+};
+
+// Swapchain state replaced by a rebuild. Frames submitted before the rebuild
+// may still render into these framebuffers or wait on these semaphores.
+struct RetiredSwapchain {
+  VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+  std::vector<VkImageView> imageViews;  // Swapchain and render graph transient views
+  std::vector<VkFramebuffer> framebuffers;
+  std::vector<VkImage> images;           // Render graph transient images
+  VmaAllocation imageMemory = VK_NULL_HANDLE; // Shared by the transient images
+  std::vector<VkSemaphore> renderFinishedSemaphores;
+  uint64_t retireFrame = 0; // Free once completedFrameNumber reaches this value
+};
+
+// Per-frame resources for the frames-in-flight ring. Each slot owns its own
+// command pool so it can be reset wholesale once its fence has signaled.
+struct FrameData {
+  VkCommandPool commandPool = VK_NULL_HANDLE;
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
+  VkFence inFlightFence = VK_NULL_HANDLE;
+  uint64_t submittedFrameNumber = 0; // Value of frameNumber when this slot last submitted
+};
+
+// Render pass contents of one frame slot for one framebuffer, recorded into a
+// secondary command buffer and executed again until the scene changes
+struct CachedCommands {
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  uint64_t generation = 0;   // CommandCache::generation when recorded, 0 when never recorded
+  uint32_t uboOffset = 0;    // Dynamic offset baked into the descriptor set bind
+  VkFramebuffer framebuffer = VK_NULL_HANDLE;
+  uint32_t drawCalls = 0;
+};
+
+// Cached render pass contents per frame slot and swapchain image (--command-cache).
+// Batches write a slot's instance region at the same offsets every frame, so while
+// the mesh set is unchanged the region still holds what a cached buffer reads.
+struct CommandCache {
+  VkCommandPool pool = VK_NULL_HANDLE;
+  std::vector<CachedCommands> entries[VSDL_MAX_FRAMES_IN_FLIGHT]; // Indexed by image
+  uint64_t generation = 1; // Bumped by command_cache_invalidate
+  uint32_t records = 0;    // Entries (re-)recorded, for the benchmark summary
+  uint32_t reuses = 0;     // Frames that executed an entry unchanged
+};
+
+struct VSDL_Context;
+struct RenderGraphPass;
+
+// How a render graph pass touches an image; decides layout, stages and access
+enum class RenderGraphUsage {
+  COLOR_ATTACHMENT,
+  DEPTH_ATTACHMENT,
+  SAMPLED,      // Read in the fragment shader
+  TRANSFER_SRC,
+  TRANSFER_DST
+};
+
+struct RenderGraphImage {
+  const char* name = nullptr;
+  VkFormat format = VK_FORMAT_UNDEFINED;
+  float scale = 1.0f;          // Extent relative to the backbuffer
+  bool imported = false;       // The backbuffer: a swapchain or headless image picked per frame
+  VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED; // Imported: layout handed to present or readback
+  VkImageUsageFlags usage = 0; // Union of the declared uses
+  // Set by render_graph_compile
+  uint32_t firstPass = UINT32_MAX; // Lifetime over the passes left after culling
+  uint32_t lastPass = 0;
+  // Set by render_graph_create_targets, transient images only
+  VkExtent2D extent = {0, 0};
+  VkImage image = VK_NULL_HANDLE;
+  VkImageView view = VK_NULL_HANDLE;
+  VkDeviceSize offset = 0; // Placement in RenderGraph::memory
+  VkDeviceSize size = 0;
+};
+
+struct RenderGraphUse {
+  uint32_t image = 0;
+  RenderGraphUsage usage = RenderGraphUsage::COLOR_ATTACHMENT;
+  VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE; // Attachments only
+  VkClearValue clearValue = {};
+};
+
+struct RenderGraphBarrier {
+  uint32_t image = 0;
+  VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkImageLayout newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkPipelineStageFlags srcStage = 0;
+  VkPipelineStageFlags dstStage = 0;
+  VkAccessFlags srcAccess = 0;
+  VkAccessFlags dstAccess = 0;
+};
+
+// Records a pass's commands; graphics passes are called inside their render pass
+// (or between vkCmdBeginRendering and vkCmdEndRendering)
+typedef void (*RenderGraphRecordFn)(VSDL_Context& ctx, const RenderGraphPass& pass, VkCommandBuffer commandBuffer);
+
+struct RenderGraphPass {
+  const char* name = nullptr; // Also the name of the pass's GPU timestamp scope
+  std::vector<RenderGraphUse> uses;
+  RenderGraphRecordFn record = nullptr;
+  void* userData = nullptr;   // Per-frame inputs of record, set by the renderer
+  VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE; // SECONDARY to execute cached buffers
+  // Set by render_graph_compile
+  bool culled = false;        // Writes nothing a later pass or the backbuffer needs
+  bool graphics = false;      // Has attachments: recorded inside a render pass
+  bool backbufferAttachment = false; // Needs one framebuffer per backbuffer image
+  VkRenderPass renderPass = VK_NULL_HANDLE; // VK_NULL_HANDLE with dynamic rendering
+  std::vector<VkFormat> colorFormats;       // What dynamic rendering pipelines and secondaries declare
+  VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+  std::vector<RenderGraphBarrier> barriers; // Recorded before the pass
+  // Set by render_graph_create_targets
+  VkExtent2D extent = {0, 0};
+  std::vector<VkFramebuffer> framebuffers;
+};
+
+// Passes declare which images they read and write; compiling the graph culls
+// passes whose results are never used, derives every layout transition and
+// barrier, and places transient images with disjoint lifetimes in the same memory.
+struct RenderGraph {
+  std::vector<RenderGraphImage> images;
+  std::vector<RenderGraphPass> passes;
+  std::vector<RenderGraphBarrier> finalBarriers; // Backbuffer to its final layout
+  bool dynamicRendering = false;             // vkCmdBeginRendering: no render passes or framebuffers
+  uint32_t backbuffer = UINT32_MAX;
+  uint32_t imageIndex = 0;                   // Backbuffer image of the frame being executed
+  VmaAllocation memory = VK_NULL_HANDLE;     // Shared by every transient image
+  VkDeviceSize memoryBytes = 0;
+  VkDeviceSize unaliasedBytes = 0;           // What one allocation per transient image would take
+  uint32_t barrierCount = 0;                 // Per frame, including the final transitions
+};
+
+// Persistently mapped buffer split into one region per frame in flight.
+// Sub-allocations bump a head pointer inside the active region and are
+// addressed by offset (e.g. dynamic UBO offsets), so the CPU never writes
+// memory that an in-flight frame may still be reading and never maps/unmaps.
+struct LinearAllocator {
+  VkBuffer buffer = VK_NULL_HANDLE;
+  VmaAllocation allocation = VK_NULL_HANDLE;
+  uint8_t* mapped = nullptr;
+  VkDeviceSize alignment = 1;
+  VkDeviceSize regionSize = 0;
+  uint32_t regionCount = 0;
+  uint32_t region = 0;   // Region owned by the frame currently being recorded
+  VkDeviceSize head = 0; // Bytes used in the active region
+};
+
+// This frame's instances grouped by MeshType. InstanceData and the indirect
+// commands live in the instance ring; commands is the CPU copy used by the
+// paths that cannot read them from the buffer.
+struct DrawBatches {
+  VkDeviceSize instanceOffset = 0; // First InstanceData of the frame in instanceRing
+  VkDeviceSize indirectOffset = 0; // VkDrawIndexedIndirectCommand array in instanceRing
+  VkDeviceSize countOffset = 0;    // uint32_t draw count for vkCmdDrawIndexedIndirectCount
+  VkDrawIndexedIndirectCommand commands[VSDL_MESH_TYPE_COUNT] = {};
+  uint32_t drawCount = 0;     // One per MeshType with at least one instance
+  uint32_t instanceCount = 0;
+};
+
+// Optional device features enabled in vsdl_init when supported
+struct VSDL_DeviceFeatures {
+  bool multiDrawIndirect = false;
+  bool drawIndirectFirstInstance = false;
+  bool drawIndirectCount = false;
+  bool pipelineStatisticsQuery = false;
+  bool presentWait = false; // VK_KHR_present_id and VK_KHR_present_wait, never when headless
+  bool linearBlit = false;  // Backbuffer format supports linear-filtered blits (--render-scale)
+  bool dynamicRendering = false; // Vulkan 1.3 or VK_KHR_dynamic_rendering, only asked for with --dynamic-rendering
+};
+
+// One submission of the upload manager, reusable once the timeline
+// semaphore reaches timelineValue
+struct UploadBatch {
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  uint64_t timelineValue = 0;
+  uint64_t stagingEnd = 0; // Staging ring position released when this batch completes
+};
+
+// Copy recorded by upload_buffer, submitted by upload_flush
+struct PendingBufferCopy {
+  VkBuffer dst;
+  VkBufferCopy region;
+};
+
+// Streams data to device-local resources through a persistently mapped
+// staging ring. Copies are batched into one submission per upload_flush on
+// the transfer queue, and completion is tracked with a timeline semaphore
+// instead of vkQueueWaitIdle. stagingHead/stagingTail are running byte
+// counts; the ring offset is the count modulo VSDL_STAGING_RING_SIZE.
+struct UploadManager {
+  VkBuffer stagingBuffer = VK_NULL_HANDLE;
+  VmaAllocation stagingAllocation = VK_NULL_HANDLE;
+  uint8_t* stagingMapped = nullptr;
+  uint64_t stagingHead = 0; // Next byte to hand out
+  uint64_t stagingTail = 0; // Oldest byte still owned by a pending or in-flight batch
+  VkCommandPool commandPool = VK_NULL_HANDLE; // On the transfer queue family
+  uint32_t queueFamilies[2] = {0, 0};         // Graphics and transfer, for concurrent sharing
+  UploadBatch batches[VSDL_UPLOAD_BATCHES];
+  uint32_t nextBatch = 0;
+  VkSemaphore timeline = VK_NULL_HANDLE;
+  uint64_t submittedValue = 0; // Value signaled by the most recent batch
+  uint64_t completedValue = 0; // Last value read back from the timeline
+  uint64_t graphicsWaitValue = 0; // Highest value a graphics submit has waited on
+  std::vector<PendingBufferCopy> pendingBuffers;
+};
+
+// Offscreen stand-in for the surface and swapchain (options.headless). The
+// images double as ctx.swapchainImages so the render loop indexes them the
+// same way; nothing is presented.
+struct HeadlessTarget {
+  std::vector<VmaAllocation> allocations; // One per ctx.swapchainImages entry
+  uint32_t nextImage = 0;
+  VkBuffer readbackBuffer = VK_NULL_HANDLE; // Persistently mapped, one frame of pixels
+  VmaAllocation readbackAllocation = VK_NULL_HANDLE;
+  uint8_t* readbackMapped = nullptr;
+};
+
+// Runtime options, filled from the command line in main.cpp
+struct VSDL_Options {
+  uint32_t framesInFlight = 2; // 1..VSDL_MAX_FRAMES_IN_FLIGHT
+  uint32_t benchFrames = 0;    // Non-zero: render this many frames, log timings and exit
+  uint32_t benchMeshes = 0;    // Extra mesh instances spawned before a benchmark run
+  bool indirectDraw = true;    // false: one vkCmdDrawIndexed per instance (--draw-mode direct)
+  const char* pipelineCachePath = "pipeline_cache.bin"; // nullptr: never load or save (--no-pipeline-cache)
+  uint32_t benchResizeBurst = 0; // Non-zero: SDL_SetWindowSize calls per benchmark frame (--bench-resize)
+  bool headless = false;        // Render into offscreen images, no window or swapchain (--headless)
+  uint32_t headlessImages = 3;  // Images in the headless ring (--headless-images)
+  uint32_t headlessFrames = 240; // Headless without benchFrames: frames before exiting (--headless-frames)
+  const char* readbackPath = nullptr; // Headless: write the last frame as a PPM (--readback)
+  const char* goldenPath = nullptr;   // Headless: compare the last frame against this PPM (--golden)
+  uint32_t goldenTolerance = 2;       // Per-channel difference still counted as a match
+  const char* profileTracePath = nullptr; // Write a Chrome trace of CPU and GPU scopes on exit (--profile-trace)
+  const char* zoneTracePath = nullptr;    // Write the CPU zones (VSDL_ZONE) as a Chrome trace on exit (--zone-trace)
+  PacingMode pacing = PacingMode::UNCAPPED; // Frame pacing and present mode policy (--pacing)
+  uint32_t fpsCap = 60;                     // Frame rate of --pacing cap (--fps-cap)
+  bool allowTearing = false;                // Let cap and uncapped pick IMMEDIATE over MAILBOX (--allow-tearing)
+  bool commandCache = false;                // Reuse recorded render pass contents until the scene changes (--command-cache)
+  float renderScale = 1.0f;                 // Scene resolution relative to the backbuffer, blitted up (--render-scale)
+  bool dynamicRendering = false;            // vkCmdBeginRendering instead of render passes and framebuffers (--dynamic-rendering)
 };
 
 struct VSDL_Context {
+  VSDL_Options options;
+  VSDL_DeviceFeatures features;
   SDL_Window* window = nullptr;
   VkInstance instance = VK_NULL_HANDLE;
   VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
@@ -34,26 +322,42 @@ struct VSDL_Context {
   VmaAllocator allocator = VK_NULL_HANDLE;
   uint32_t graphicsFamily = 0;
   VkQueue graphicsQueue = VK_NULL_HANDLE;
+  uint32_t transferFamily = 0; // Dedicated transfer family when present, else graphicsFamily
+  VkQueue transferQueue = VK_NULL_HANDLE;
+  UploadManager upload;
   VkSurfaceKHR surface = VK_NULL_HANDLE;
   VkSwapchainKHR swapchain = VK_NULL_HANDLE;
   std::vector<VkImage> swapchainImages;
   VkFormat swapchainImageFormat = VK_FORMAT_UNDEFINED;
   VkExtent2D swapchainExtent = {0, 0};
   std::vector<VkImageView> swapchainImageViews;
-  VkRenderPass renderPass = VK_NULL_HANDLE;
   VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
   VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
   VkPipeline graphicsPipeline = VK_NULL_HANDLE;
-  std::vector<VkFramebuffer> framebuffers;
+  VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+  bool pipelineCacheWarm = false; // Seeded from disk rather than empty
+  bool pipelineCacheUsed = false; // A pipeline was created against it since loading
+  size_t pipelineCacheLoadedBytes = 0; // Size of the data it was seeded with
+  RenderGraph renderGraph;
+  uint32_t scenePass = 0; // Pass of renderGraph that pipelines and cached commands are built for
   VkCommandPool commandPool = VK_NULL_HANDLE;
-  std::vector<Mesh> meshes; // Replaces vertexBuffers
-  VkBuffer uniformBuffer = VK_NULL_HANDLE;
-  VmaAllocation uniformBufferAllocation = VK_NULL_HANDLE;
+  MeshArena meshArena;
+  Mesh meshGeometry[VSDL_MESH_TYPE_COUNT]; // Shared geometry per MeshType
+  std::vector<MeshInstance> meshes;
+  LinearAllocator uniformRing;
+  LinearAllocator instanceRing; // Per-frame InstanceData and indirect draw commands
   VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
   VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
-  VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
-  VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
-  VkFence frameFence = VK_NULL_HANDLE;
+  FrameData frames[VSDL_MAX_FRAMES_IN_FLIGHT];
+  CommandCache commandCache;
+  uint32_t currentFrame = 0;
+  uint64_t frameNumber = 0;          // Frames submitted so far
+  uint64_t completedFrameNumber = 0; // Frames known to have finished on the GPU
+  std::vector<VkSemaphore> renderFinishedSemaphores; // One per swapchain image
+  std::vector<RetiredSwapchain> retiredSwapchains;
+  HeadlessTarget headlessTarget;
+  Profiler profiler;
+  FramePacer pacer;
 };
 
 #endif
\ No newline at end of file
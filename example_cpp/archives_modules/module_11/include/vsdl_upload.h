@@ -0,0 +1,24 @@
+// vsdl_upload.h
+#ifndef VSDL_UPLOAD_H
+#define VSDL_UPLOAD_H
+
+#include "vsdl_types.h"
+
+bool upload_manager_create(VSDL_Context& ctx);
+void upload_manager_destroy(VSDL_Context& ctx);
+// Shares resources written by the transfer queue with the graphics queue
+// when the two families differ. Call before vmaCreateBuffer.
+void upload_set_sharing(const VSDL_Context& ctx, VkBufferCreateInfo& info);
+// Copies data into the staging ring and queues a copy to dst. The data may be
+// freed on return; the destination is written at the next upload_flush.
+bool upload_buffer(VSDL_Context& ctx, VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+// Records every pending copy into one command buffer and submits it.
+// outValue (optional) receives the timeline value that signals completion of
+// all uploads so far; nothing is submitted when no copies are pending.
+bool upload_flush(VSDL_Context& ctx, uint64_t* outValue);
+// Blocks until the timeline reaches value, releasing finished staging space
+bool upload_wait(VSDL_Context& ctx, uint64_t value);
+// Polls the timeline and releases staging space of finished batches
+uint64_t upload_poll(VSDL_Context& ctx);
+
+#endif
\ No newline at end of file
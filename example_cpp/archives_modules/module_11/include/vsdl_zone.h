@@ -0,0 +1,46 @@
+// vsdl_zone.h
+#ifndef VSDL_ZONE_H
+#define VSDL_ZONE_H
+
+#include <SDL3/SDL.h>
+
+#define VSDL_ZONE_RING_SIZE 65536 // Zones kept per thread; the oldest are overwritten
+
+// CPU zones: VSDL_ZONE("name") times the rest of the enclosing block and
+// records it into a ring owned by the calling thread. Built only with
+// VSDL_ENABLE_ZONES (CMake option VSDL_ZONES); otherwise the macro expands
+// to nothing and no zone code or storage is compiled in.
+#ifdef VSDL_ENABLE_ZONES
+
+void zone_record(const char* name, Uint64 startTicks, Uint64 endTicks);
+
+struct ZoneScope {
+  explicit ZoneScope(const char* zoneName) : name(zoneName), startTicks(SDL_GetPerformanceCounter()) {}
+  ~ZoneScope() { zone_record(name, startTicks, SDL_GetPerformanceCounter()); }
+  ZoneScope(const ZoneScope&) = delete;
+  ZoneScope& operator=(const ZoneScope&) = delete;
+
+  const char* name; // String literal, stored by pointer
+  Uint64 startTicks;
+};
+
+#define VSDL_ZONE_CONCAT_(a, b) a##b
+#define VSDL_ZONE_CONCAT(a, b) VSDL_ZONE_CONCAT_(a, b)
+#define VSDL_ZONE(name) ZoneScope VSDL_ZONE_CONCAT(vsdlZone, __LINE__)(name)
+
+// Writes every thread's ring as Chrome trace JSON (chrome://tracing, Perfetto).
+// Call once the threads that record zones are idle.
+bool zone_write_trace(const char* path);
+
+#else
+
+#define VSDL_ZONE(name) ((void)0)
+
+inline bool zone_write_trace(const char* path) {
+  SDL_Log("Zones are compiled out (configure with -DVSDL_ZONES=ON), %s not written", path);
+  return true;
+}
+
+#endif
+
+#endif
\ No newline at end of file
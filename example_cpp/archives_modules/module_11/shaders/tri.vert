@@ -1,6 +1,7 @@
 #version 450
 layout(location = 0) in vec2 inPosition;
 layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec4 inInstance; // xy: offset, z: scale, w: rotation
 layout(location = 0) out vec3 fragColor;
 
 layout(binding = 0) uniform UniformBufferObject {
@@ -15,6 +16,9 @@ void main() {
         0.0, 0.0, 1.0, 0.0,
         0.0, 0.0, 0.0, 1.0
     );
-    gl_Position = ortho * ubo.transform * vec4(inPosition, 0.0, 1.0);
+    float c = cos(inInstance.w);
+    float s = sin(inInstance.w);
+    vec2 position = mat2(c, s, -s, c) * (inPosition * inInstance.z) + inInstance.xy;
+    gl_Position = ortho * ubo.transform * vec4(position, 0.0, 1.0);
     fragColor = inColor;
 }
\ No newline at end of file
@@ -7,9 +7,92 @@
 #include "vsdl_renderer.h"
 #include "vsdl_cleanup.h"
 
+static void parse_options(VSDL_Options& options, int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (SDL_strcmp(argv[i], "--frames-in-flight") == 0 && hasValue) {
+            int value = SDL_atoi(argv[++i]);
+            options.framesInFlight = (uint32_t)SDL_clamp(value, 1, VSDL_MAX_FRAMES_IN_FLIGHT);
+        } else if (SDL_strcmp(argv[i], "--bench-frames") == 0 && hasValue) {
+            options.benchFrames = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (SDL_strcmp(argv[i], "--bench-meshes") == 0 && hasValue) {
+            options.benchMeshes = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (SDL_strcmp(argv[i], "--draw-mode") == 0 && hasValue) {
+            options.indirectDraw = SDL_strcmp(argv[++i], "direct") != 0;
+        } else if (SDL_strcmp(argv[i], "--pipeline-cache") == 0 && hasValue) {
+            options.pipelineCachePath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--no-pipeline-cache") == 0) {
+            options.pipelineCachePath = nullptr;
+        } else if (SDL_strcmp(argv[i], "--bench-resize") == 0 && hasValue) {
+            options.benchResizeBurst = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (SDL_strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (SDL_strcmp(argv[i], "--headless-images") == 0 && hasValue) {
+            options.headlessImages = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 1);
+        } else if (SDL_strcmp(argv[i], "--headless-frames") == 0 && hasValue) {
+            options.headlessFrames = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 1);
+        } else if (SDL_strcmp(argv[i], "--readback") == 0 && hasValue) {
+            options.readbackPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--golden") == 0 && hasValue) {
+            options.goldenPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--golden-tolerance") == 0 && hasValue) {
+            options.goldenTolerance = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (SDL_strcmp(argv[i], "--profile-trace") == 0 && hasValue) {
+            options.profileTracePath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--zone-trace") == 0 && hasValue) {
+            options.zoneTracePath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--pacing") == 0 && hasValue) {
+            if (!pacing_mode_parse(argv[++i], &options.pacing)) {
+                SDL_Log("Unknown pacing mode %s, keeping %s", argv[i], pacing_mode_name(options.pacing));
+            }
+        } else if (SDL_strcmp(argv[i], "--fps-cap") == 0 && hasValue) {
+            options.fpsCap = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 1);
+            options.pacing = PacingMode::CAP;
+        } else if (SDL_strcmp(argv[i], "--allow-tearing") == 0) {
+            options.allowTearing = true;
+        } else if (SDL_strcmp(argv[i], "--command-cache") == 0) {
+            options.commandCache = true;
+        } else if (SDL_strcmp(argv[i], "--render-scale") == 0 && hasValue) {
+            options.renderScale = SDL_clamp((float)SDL_atof(argv[++i]), 0.25f, 1.0f);
+        } else if (SDL_strcmp(argv[i], "--dynamic-rendering") == 0) {
+            options.dynamicRendering = true;
+        } else {
+            SDL_Log("Ignoring unknown argument: %s", argv[i]);
+        }
+    }
+    SDL_Log("Options: frames in flight %u, bench frames %u, bench meshes %u, draw mode %s, pipeline cache %s, resize burst %u",
+            options.framesInFlight, options.benchFrames, options.benchMeshes,
+            options.indirectDraw ? "indirect" : "direct",
+            options.pipelineCachePath ? options.pipelineCachePath : "disabled", options.benchResizeBurst);
+    SDL_Log("Pacing: %s, fps cap %u, tearing %s", pacing_mode_name(options.pacing), options.fpsCap,
+            options.allowTearing ? "allowed" : "off");
+    if (options.commandCache) {
+        SDL_Log("Command cache: on");
+    }
+    if (options.renderScale < 1.0f) {
+        SDL_Log("Render scale: %.2f", options.renderScale);
+    }
+    if (options.dynamicRendering) {
+        SDL_Log("Dynamic rendering: requested");
+    }
+    if (options.headless) {
+        SDL_Log("Headless: %u images, %u frames, readback %s, golden %s (tolerance %u)", options.headlessImages,
+                options.benchFrames > 0 ? options.benchFrames : options.headlessFrames,
+                options.readbackPath ? options.readbackPath : "off", options.goldenPath ? options.goldenPath : "off",
+                options.goldenTolerance);
+    }
+    if (options.profileTracePath) {
+        SDL_Log("Profile trace: %s", options.profileTracePath);
+    }
+    if (options.zoneTracePath) {
+        SDL_Log("Zone trace: %s", options.zoneTracePath);
+    }
+}
+
 int main(int argc, char* argv[]) {
     SDL_Log("init main");
     VSDL_Context ctx = {};
+    parse_options(ctx.options, argc, argv);
     if (!vsdl_init(ctx)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Initialization failed");
         vsdl_cleanup(ctx);
@@ -0,0 +1,130 @@
+// vsdl_batch.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <SDL3/SDL_log.h>
+#include "vsdl_batch.h"
+#include "vsdl_types.h"
+#include "vsdl_linear_alloc.h"
+#include "vsdl_zone.h"
+
+bool build_draw_batches(VSDL_Context& ctx, DrawBatches& batches) {
+    VSDL_ZONE("build batches");
+    batches = DrawBatches{};
+    if (ctx.meshes.empty()) {
+        return true;
+    }
+
+    // Counting sort by type: each batch gets a contiguous run of instances
+    uint32_t counts[VSDL_MESH_TYPE_COUNT] = {};
+    for (const auto& mesh : ctx.meshes) {
+        counts[(int)mesh.type]++;
+    }
+    uint32_t firstInstance[VSDL_MESH_TYPE_COUNT];
+    uint32_t cursor[VSDL_MESH_TYPE_COUNT];
+    uint32_t total = 0;
+    for (int type = 0; type < VSDL_MESH_TYPE_COUNT; type++) {
+        firstInstance[type] = cursor[type] = total;
+        total += counts[type];
+    }
+
+    InstanceData* instances = static_cast<InstanceData*>(
+        linear_alloc(ctx.instanceRing, total * sizeof(InstanceData), &batches.instanceOffset));
+    if (!instances) {
+        return false;
+    }
+    for (const auto& mesh : ctx.meshes) {
+        instances[cursor[(int)mesh.type]++] = mesh.data;
+    }
+
+    // firstInstance is relative to instanceOffset, which is bound as the
+    // vertex buffer offset of binding 1
+    for (int type = 0; type < VSDL_MESH_TYPE_COUNT; type++) {
+        if (counts[type] == 0) {
+            continue;
+        }
+        const Mesh& geometry = ctx.meshGeometry[type];
+        VkDrawIndexedIndirectCommand& command = batches.commands[batches.drawCount++];
+        command.indexCount = geometry.indexCount;
+        command.instanceCount = counts[type];
+        command.firstIndex = geometry.firstIndex;
+        command.vertexOffset = (int32_t)geometry.vertexOffset;
+        command.firstInstance = firstInstance[type];
+    }
+    batches.instanceCount = total;
+
+    if (!ctx.options.indirectDraw || !ctx.features.drawIndirectFirstInstance) {
+        return true; // Drawn from the CPU copy in batches.commands
+    }
+
+    size_t commandBytes = batches.drawCount * sizeof(VkDrawIndexedIndirectCommand);
+    void* indirect = linear_alloc(ctx.instanceRing, commandBytes, &batches.indirectOffset);
+    if (!indirect) {
+        return false;
+    }
+    SDL_memcpy(indirect, batches.commands, commandBytes);
+
+    if (ctx.features.drawIndirectCount) {
+        uint32_t* drawCount = static_cast<uint32_t*>(linear_alloc(ctx.instanceRing, sizeof(uint32_t), &batches.countOffset));
+        if (!drawCount) {
+            return false;
+        }
+        *drawCount = batches.drawCount;
+    }
+    return true;
+}
+
+uint32_t record_draw_batches(VSDL_Context& ctx, VkCommandBuffer commandBuffer, const DrawBatches& batches) {
+    VSDL_ZONE("record draws");
+    if (batches.instanceCount == 0) {
+        return 0;
+    }
+
+    // All geometry lives in the arena buffers; instances come from this frame's ring region
+    VkBuffer vertexBuffers[] = {ctx.meshArena.vertexBuffer, ctx.instanceRing.buffer};
+    VkDeviceSize offsets[] = {0, batches.instanceOffset};
+    vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(commandBuffer, ctx.meshArena.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    uint32_t drawCalls = 0;
+    if (!ctx.options.indirectDraw) {
+        // Reference path: one draw per instance, as the loop did before batching
+        for (uint32_t i = 0; i < batches.drawCount; i++) {
+            const VkDrawIndexedIndirectCommand& command = batches.commands[i];
+            for (uint32_t instance = 0; instance < command.instanceCount; instance++) {
+                vkCmdDrawIndexed(commandBuffer, command.indexCount, 1, command.firstIndex, command.vertexOffset,
+                                 command.firstInstance + instance);
+                drawCalls++;
+            }
+        }
+        return drawCalls;
+    }
+
+    // Indirect commands with a non-zero firstInstance need drawIndirectFirstInstance;
+    // without it, issue the same batches as instanced direct draws
+    if (!ctx.features.drawIndirectFirstInstance) {
+        for (uint32_t i = 0; i < batches.drawCount; i++) {
+            const VkDrawIndexedIndirectCommand& command = batches.commands[i];
+            vkCmdDrawIndexed(commandBuffer, command.indexCount, command.instanceCount, command.firstIndex,
+                             command.vertexOffset, command.firstInstance);
+            drawCalls++;
+        }
+        return drawCalls;
+    }
+
+    const uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+    if (ctx.features.multiDrawIndirect && ctx.features.drawIndirectCount) {
+        vkCmdDrawIndexedIndirectCount(commandBuffer, ctx.instanceRing.buffer, batches.indirectOffset,
+                                      ctx.instanceRing.buffer, batches.countOffset, VSDL_MESH_TYPE_COUNT, stride);
+        drawCalls = 1;
+    } else if (ctx.features.multiDrawIndirect) {
+        vkCmdDrawIndexedIndirect(commandBuffer, ctx.instanceRing.buffer, batches.indirectOffset, batches.drawCount, stride);
+        drawCalls = 1;
+    } else {
+        for (uint32_t i = 0; i < batches.drawCount; i++) {
+            vkCmdDrawIndexedIndirect(commandBuffer, ctx.instanceRing.buffer, batches.indirectOffset + i * stride, 1, stride);
+            drawCalls++;
+        }
+    }
+    return drawCalls;
+}
\ No newline at end of file
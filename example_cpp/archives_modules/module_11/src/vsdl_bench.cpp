@@ -0,0 +1,40 @@
+// vsdl_bench.cpp
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include "vsdl_bench.h"
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+FrameTimeStats compute_frame_time_stats(std::vector<double> samplesMs) {
+    FrameTimeStats stats;
+    if (samplesMs.empty()) {
+        return stats;
+    }
+    std::sort(samplesMs.begin(), samplesMs.end());
+
+    double sum = 0.0;
+    for (double ms : samplesMs) {
+        sum += ms;
+    }
+    stats.count = samplesMs.size();
+    stats.avgMs = sum / samplesMs.size();
+    stats.minMs = samplesMs.front();
+    stats.maxMs = samplesMs.back();
+    stats.p50Ms = percentile(samplesMs, 0.50);
+    stats.p95Ms = percentile(samplesMs, 0.95);
+    stats.p99Ms = percentile(samplesMs, 0.99);
+    return stats;
+}
+
+void log_frame_time_stats(const char* label, const FrameTimeStats& stats) {
+    if (stats.count == 0) {
+        SDL_Log("[bench] %s: no samples", label);
+        return;
+    }
+    SDL_Log("[bench] %s: frames=%zu avg=%.3fms (%.1f fps) min=%.3fms p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms",
+            label, stats.count, stats.avgMs, 1000.0 / stats.avgMs, stats.minMs,
+            stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+}
@@ -7,25 +7,53 @@
 #include <SDL3/SDL_vulkan.h>
 #include "vsdl_cleanup.h"
 #include "vsdl_types.h"
+#include "vsdl_linear_alloc.h"
+#include "vsdl_mesh_arena.h"
+#include "vsdl_upload.h"
+#include "vsdl_pipeline_cache.h"
+#include "vsdl_headless.h"
+#include "vsdl_render_graph.h"
 
 void vsdl_cleanup(VSDL_Context& ctx) {
     SDL_Log("init cleanup");
 
-    if (ctx.uniformBuffer) {
-        SDL_Log("Destroying uniform buffer");
-        vmaDestroyBuffer(ctx.allocator, ctx.uniformBuffer, ctx.uniformBufferAllocation);
-        ctx.uniformBuffer = VK_NULL_HANDLE;
-        ctx.uniformBufferAllocation = VK_NULL_HANDLE;
+    if (ctx.uniformRing.buffer) {
+        SDL_Log("Destroying uniform ring buffer");
+        linear_alloc_destroy(ctx, ctx.uniformRing);
     }
 
-    for (auto& mesh : ctx.meshes) {
-        SDL_Log("Destroying mesh");
-        vmaDestroyBuffer(ctx.allocator, mesh.vertexBuffer, mesh.vertexAllocation);
-        if (mesh.indexBuffer) {
-            vmaDestroyBuffer(ctx.allocator, mesh.indexBuffer, mesh.indexAllocation);
-        }
+    if (ctx.instanceRing.buffer) {
+        SDL_Log("Destroying instance ring buffer");
+        linear_alloc_destroy(ctx, ctx.instanceRing);
     }
+
     ctx.meshes.clear();
+    if (ctx.meshArena.vertexBuffer) {
+        SDL_Log("Destroying mesh arena");
+        destroy_mesh_arena(ctx);
+    }
+
+    if (ctx.upload.stagingBuffer || ctx.upload.commandPool) {
+        SDL_Log("Destroying upload manager");
+        upload_manager_destroy(ctx);
+    }
+
+    // Before the headless images: framebuffers of the graph reference their views
+    if (!ctx.renderGraph.passes.empty()) {
+        SDL_Log("Destroying render graph");
+        render_graph_destroy(ctx, ctx.renderGraph);
+        ctx.scenePass = 0;
+    }
+
+    if (!ctx.headlessTarget.allocations.empty()) {
+        SDL_Log("Destroying headless target");
+        headless_destroy(ctx);
+    }
+
+    if (ctx.profiler.timestampPool || ctx.profiler.statsPool) {
+        SDL_Log("Destroying profiler query pools");
+        profiler_destroy(ctx.profiler);
+    }
 
     if (ctx.allocator) {
         SDL_Log("Destroying VMA allocator");
@@ -39,18 +67,17 @@ void vsdl_cleanup(VSDL_Context& ctx) {
         ctx.commandPool = VK_NULL_HANDLE;
     }
 
-    for (auto& fb : ctx.framebuffers) {
-        SDL_Log("Destroying framebuffer");
-        vkDestroyFramebuffer(ctx.device, fb, nullptr);
-    }
-    ctx.framebuffers.clear();
-
     if (ctx.graphicsPipeline) {
         SDL_Log("Destroying graphics pipeline");
         vkDestroyPipeline(ctx.device, ctx.graphicsPipeline, nullptr);
         ctx.graphicsPipeline = VK_NULL_HANDLE;
     }
 
+    if (ctx.pipelineCache) {
+        SDL_Log("Saving and destroying pipeline cache");
+        pipeline_cache_destroy(ctx);
+    }
+
     if (ctx.pipelineLayout) {
         SDL_Log("Destroying pipeline layout");
         vkDestroyPipelineLayout(ctx.device, ctx.pipelineLayout, nullptr);
@@ -69,12 +96,6 @@ void vsdl_cleanup(VSDL_Context& ctx) {
         ctx.swapchain = VK_NULL_HANDLE;
     }
 
-    if (ctx.renderPass) {
-        SDL_Log("Destroying render pass");
-        vkDestroyRenderPass(ctx.device, ctx.renderPass, nullptr);
-        ctx.renderPass = VK_NULL_HANDLE;
-    }
-
     if (ctx.descriptorPool) {
         SDL_Log("Destroying descriptor pool");
         vkDestroyDescriptorPool(ctx.device, ctx.descriptorPool, nullptr);
@@ -0,0 +1,103 @@
+// vsdl_command_cache.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <SDL3/SDL.h>
+#include "vsdl_command_cache.h"
+
+bool command_cache_create(VSDL_Context& ctx) {
+    // Entries are re-recorded one at a time, so buffers must be resettable individually
+    VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.queueFamilyIndex = ctx.graphicsFamily;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (vkCreateCommandPool(ctx.device, &poolInfo, nullptr, &ctx.commandCache.pool) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create command cache pool");
+        return false;
+    }
+    SDL_Log("Command cache created");
+    return true;
+}
+
+void command_cache_destroy(VSDL_Context& ctx) {
+    if (ctx.commandCache.pool) {
+        vkDestroyCommandPool(ctx.device, ctx.commandCache.pool, nullptr); // Frees every cached buffer
+    }
+    ctx.commandCache = CommandCache{};
+}
+
+void command_cache_invalidate(VSDL_Context& ctx) {
+    ctx.commandCache.generation++;
+}
+
+CachedCommands& command_cache_entry(VSDL_Context& ctx, uint32_t frameSlot, uint32_t imageIndex) {
+    // Grows only: a smaller swapchain leaves unused entries that may still be pending
+    std::vector<CachedCommands>& entries = ctx.commandCache.entries[frameSlot];
+    if (imageIndex >= entries.size()) {
+        entries.resize(imageIndex + 1);
+    }
+    CachedCommands& entry = entries[imageIndex];
+    if (!entry.commandBuffer) {
+        VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocInfo.commandPool = ctx.commandCache.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(ctx.device, &allocInfo, &entry.commandBuffer) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate cached command buffer (frame %u, image %u)",
+                         frameSlot, imageIndex);
+            entry.commandBuffer = VK_NULL_HANDLE;
+        }
+    }
+    return entry;
+}
+
+bool command_cache_valid(const VSDL_Context& ctx, const CachedCommands& entry, uint32_t uboOffset,
+                         VkFramebuffer framebuffer) {
+    return entry.generation == ctx.commandCache.generation && entry.uboOffset == uboOffset &&
+           entry.framebuffer == framebuffer;
+}
+
+bool command_cache_begin(VSDL_Context& ctx, CachedCommands& entry, uint32_t uboOffset, VkFramebuffer framebuffer) {
+    if (!entry.commandBuffer) {
+        return false;
+    }
+    // Dynamic rendering has no render pass to inherit, only the attachment formats
+    const RenderGraphPass& scenePass = ctx.renderGraph.passes[ctx.scenePass];
+    VkCommandBufferInheritanceRenderingInfo renderingInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO};
+    renderingInfo.colorAttachmentCount = (uint32_t)scenePass.colorFormats.size();
+    renderingInfo.pColorAttachmentFormats = scenePass.colorFormats.data();
+    renderingInfo.depthAttachmentFormat = scenePass.depthFormat;
+    renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritance = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+    if (ctx.renderGraph.dynamicRendering) {
+        inheritance.pNext = &renderingInfo;
+    } else {
+        inheritance.renderPass = scenePass.renderPass;
+        inheritance.framebuffer = framebuffer;
+    }
+    inheritance.subpass = 0;
+
+    // No ONE_TIME_SUBMIT: the point is to execute it again on later frames
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    if (vkBeginCommandBuffer(entry.commandBuffer, &beginInfo) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin cached command buffer");
+        return false;
+    }
+    entry.generation = 0; // Stale until recording completes
+    entry.uboOffset = uboOffset;
+    entry.framebuffer = framebuffer;
+    return true;
+}
+
+bool command_cache_end(VSDL_Context& ctx, CachedCommands& entry, uint32_t drawCalls) {
+    if (vkEndCommandBuffer(entry.commandBuffer) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to end cached command buffer");
+        return false;
+    }
+    entry.generation = ctx.commandCache.generation;
+    entry.drawCalls = drawCalls;
+    ctx.commandCache.records++;
+    return true;
+}
\ No newline at end of file
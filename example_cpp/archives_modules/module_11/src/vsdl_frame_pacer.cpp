@@ -0,0 +1,268 @@
+// vsdl_frame_pacer.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <SDL3/SDL.h>
+#include <cmath>
+#include "vsdl_frame_pacer.h"
+#include "vsdl_bench.h"
+
+static double ticksToMs(Uint64 ticks) {
+    return (double)ticks * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static Uint64 msToTicks(double ms) {
+    return (Uint64)(ms * (double)SDL_GetPerformanceFrequency() / 1000.0);
+}
+
+static const char* presentModeName(VkPresentModeKHR mode) {
+    switch (mode) {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return "immediate";
+        case VK_PRESENT_MODE_MAILBOX_KHR: return "mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR: return "fifo";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "fifo-relaxed";
+        default: return "none";
+    }
+}
+
+// Sampling input just before the vblank only works when presents are locked to it
+static bool pacesToVblank(const FramePacer& pacer) {
+    return pacer.presentWait && pacer.intervalTicks > 0 &&
+           (pacer.presentMode == VK_PRESENT_MODE_FIFO_KHR || pacer.presentMode == VK_PRESENT_MODE_FIFO_RELAXED_KHR);
+}
+
+// Sleeps most of the way to deadline and spins the rest. The spin margin tracks
+// how far the OS overshoots sleeps: it grows at once and decays slowly.
+static Uint64 waitUntil(FramePacer& pacer, Uint64 deadline) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (deadline <= start) {
+        return 0;
+    }
+    Uint64 remaining = deadline - start;
+    if (remaining > pacer.spinTicks) {
+        Uint64 sleepTicks = remaining - pacer.spinTicks;
+        SDL_DelayNS(sleepTicks * SDL_NS_PER_SECOND / SDL_GetPerformanceFrequency());
+        Uint64 slept = SDL_GetPerformanceCounter() - start;
+        Uint64 overshoot = slept > sleepTicks ? slept - sleepTicks : 0;
+        Uint64 minSpin = msToTicks(VSDL_PACER_MIN_SPIN_US / 1000.0);
+        Uint64 maxSpin = msToTicks(VSDL_PACER_MAX_SPIN_US / 1000.0);
+        Uint64 spin = SDL_max(overshoot + overshoot / 4, pacer.spinTicks - pacer.spinTicks / 16);
+        pacer.spinTicks = SDL_clamp(spin, minSpin, maxSpin);
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+        SDL_CPUPauseInstruction();
+    }
+    return SDL_GetPerformanceCounter() - start;
+}
+
+const char* pacing_mode_name(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSYNC: return "vsync";
+        case PacingMode::ADAPTIVE: return "adaptive";
+        case PacingMode::CAP: return "cap";
+        case PacingMode::UNCAPPED: return "uncapped";
+    }
+    return "unknown";
+}
+
+bool pacing_mode_parse(const char* name, PacingMode* mode) {
+    const PacingMode modes[] = {PacingMode::VSYNC, PacingMode::ADAPTIVE, PacingMode::CAP, PacingMode::UNCAPPED};
+    for (PacingMode candidate : modes) {
+        if (SDL_strcmp(name, pacing_mode_name(candidate)) == 0) {
+            *mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void frame_pacer_init(FramePacer& pacer, PacingMode mode, uint32_t fpsCap, bool allowTearing,
+                      bool presentWait, SDL_Window* window) {
+    pacer.mode = mode;
+    pacer.allowTearing = allowTearing;
+    pacer.presentWait = presentWait;
+    pacer.spinTicks = msToTicks(1.0);
+
+    pacer.refreshHz = 0.0;
+    if (window) {
+        const SDL_DisplayMode* displayMode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+        if (displayMode && displayMode->refresh_rate > 0.0f) {
+            pacer.refreshHz = displayMode->refresh_rate_numerator > 0
+                                  ? (double)displayMode->refresh_rate_numerator / displayMode->refresh_rate_denominator
+                                  : displayMode->refresh_rate;
+        }
+    }
+
+    if (mode == PacingMode::CAP) {
+        pacer.intervalTicks = SDL_GetPerformanceFrequency() / SDL_max(fpsCap, 1u);
+    } else if (pacer.refreshHz > 0.0) {
+        pacer.intervalTicks = (Uint64)((double)SDL_GetPerformanceFrequency() / pacer.refreshHz);
+    } else {
+        pacer.intervalTicks = 0;
+    }
+    SDL_Log("Frame pacing: %s, refresh %.2f Hz, interval %.3fms, present wait %d", pacing_mode_name(mode),
+            pacer.refreshHz, ticksToMs(pacer.intervalTicks), presentWait);
+}
+
+VkPresentModeKHR frame_pacer_choose_present_mode(FramePacer& pacer, VkPhysicalDevice physicalDevice,
+                                                 VkSurfaceKHR surface) {
+    uint32_t presentModeCount;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr);
+    std::vector<VkPresentModeKHR> presentModes(presentModeCount);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, presentModes.data());
+
+    // FIFO is always supported, so every list ends with it
+    std::vector<VkPresentModeKHR> preferred;
+    switch (pacer.mode) {
+        case PacingMode::VSYNC:
+            break;
+        case PacingMode::ADAPTIVE:
+            preferred.push_back(VK_PRESENT_MODE_FIFO_RELAXED_KHR);
+            break;
+        case PacingMode::CAP:
+        case PacingMode::UNCAPPED:
+            if (pacer.allowTearing) {
+                preferred.push_back(VK_PRESENT_MODE_IMMEDIATE_KHR);
+            }
+            preferred.push_back(VK_PRESENT_MODE_MAILBOX_KHR);
+            break;
+    }
+    preferred.push_back(VK_PRESENT_MODE_FIFO_KHR);
+
+    VkPresentModeKHR chosen = VK_PRESENT_MODE_FIFO_KHR;
+    for (VkPresentModeKHR mode : preferred) {
+        bool supported = false;
+        for (VkPresentModeKHR available : presentModes) {
+            supported = supported || available == mode;
+        }
+        if (supported) {
+            chosen = mode;
+            break;
+        }
+    }
+    if (chosen != pacer.presentMode) {
+        SDL_Log("Present mode: %s (pacing %s)", presentModeName(chosen), pacing_mode_name(pacer.mode));
+    }
+    pacer.presentMode = chosen;
+    return chosen;
+}
+
+Uint64 frame_pacer_begin_frame(FramePacer& pacer, VkDevice device, VkSwapchainKHR swapchain) {
+    Uint64 waitStart = SDL_GetPerformanceCounter();
+
+    // VSYNC/ADAPTIVE block until the previous frame is on screen, so at most one
+    // present is queued. CAP and UNCAPPED only poll the oldest present not yet
+    // seen on screen for the latency samples and never wait.
+    if (pacer.presentWait && swapchain != VK_NULL_HANDLE && swapchain == pacer.presentSwapchain &&
+        pacer.presentId > pacer.waitedId) {
+        bool block = pacesToVblank(pacer);
+        uint64_t id = block ? pacer.presentId : pacer.waitedId + 1;
+        VkResult result = vkWaitForPresentKHR(device, swapchain, id, block ? VSDL_PACER_PRESENT_TIMEOUT_NS : 0);
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+            pacer.waitedId = id;
+            pacer.lastDisplayTicks = SDL_GetPerformanceCounter();
+            if (pacer.recording) {
+                pacer.inputToDisplayMs.push_back(ticksToMs(pacer.lastDisplayTicks - pacer.inputTicks[id % VSDL_PACER_INPUT_SLOTS]));
+            }
+        } else if (block || result != VK_TIMEOUT) {
+            // Timed out or the swapchain went away: fall back to plain FIFO blocking until the next present
+            pacer.waitedId = id;
+            pacer.lastDisplayTicks = 0;
+        } else if (pacer.presentId - pacer.waitedId >= VSDL_PACER_INPUT_SLOTS) {
+            // Not on screen yet and its input time is about to be overwritten (MAILBOX drops frames)
+            pacer.waitedId = pacer.presentId - VSDL_PACER_INPUT_SLOTS + 1;
+        }
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 deadline = 0;
+    if (pacer.mode == PacingMode::CAP) {
+        // More than a whole interval behind (first frame, hitch, minimized window): restart the
+        // schedule from now instead of rendering a burst of frames to catch up
+        if (pacer.deadlineTicks == 0 || now > pacer.deadlineTicks + pacer.intervalTicks) {
+            pacer.deadlineTicks = now;
+        }
+        deadline = pacer.deadlineTicks;
+        pacer.deadlineTicks += pacer.intervalTicks;
+    } else if (pacesToVblank(pacer) && pacer.lastDisplayTicks > 0) {
+        // Start as late as possible while still finishing before the vblank after the one just shown
+        Uint64 nextVblank = pacer.lastDisplayTicks + pacer.intervalTicks;
+        Uint64 work = msToTicks(pacer.cpuWorkMs + pacer.gpuWorkMs + VSDL_PACER_SAFETY_MS);
+        deadline = nextVblank > work ? nextVblank - work : 0;
+    }
+    waitUntil(pacer, deadline);
+
+    Uint64 inputTicks = SDL_GetPerformanceCounter();
+    if (pacer.recording) {
+        pacer.waitMs.push_back(ticksToMs(inputTicks - waitStart));
+    }
+    return inputTicks;
+}
+
+const void* frame_pacer_present_id(FramePacer& pacer, VkSwapchainKHR swapchain, Uint64 inputTicks,
+                                   VkPresentIdKHR& presentIdInfo) {
+    if (!pacer.presentWait) {
+        return nullptr;
+    }
+    // Ids keep increasing across swapchains; only those sent to the current one are waited on
+    if (swapchain != pacer.presentSwapchain) {
+        pacer.presentSwapchain = swapchain;
+        pacer.waitedId = pacer.presentId;
+        pacer.lastDisplayTicks = 0;
+    }
+    pacer.presentId++;
+    pacer.inputTicks[pacer.presentId % VSDL_PACER_INPUT_SLOTS] = inputTicks;
+
+    presentIdInfo = {VK_STRUCTURE_TYPE_PRESENT_ID_KHR};
+    presentIdInfo.swapchainCount = 1;
+    presentIdInfo.pPresentIds = &pacer.presentId;
+    return &presentIdInfo;
+}
+
+void frame_pacer_end_frame(FramePacer& pacer, Uint64 inputTicks, double gpuMs) {
+    const double smoothing = 0.1;
+    double cpuMs = ticksToMs(SDL_GetPerformanceCounter() - inputTicks);
+    pacer.cpuWorkMs = pacer.cpuWorkMs > 0.0 ? pacer.cpuWorkMs + (cpuMs - pacer.cpuWorkMs) * smoothing : cpuMs;
+    if (gpuMs > 0.0) {
+        pacer.gpuWorkMs = pacer.gpuWorkMs > 0.0 ? pacer.gpuWorkMs + (gpuMs - pacer.gpuWorkMs) * smoothing : gpuMs;
+    }
+    if (pacer.recording) {
+        pacer.inputToPresentMs.push_back(cpuMs);
+    }
+}
+
+void frame_pacer_log_stats(const FramePacer& pacer, const std::vector<double>& frameTimesMs) {
+    if (frameTimesMs.empty()) {
+        return;
+    }
+    double sum = 0.0;
+    for (double ms : frameTimesMs) {
+        sum += ms;
+    }
+    double mean = sum / frameTimesMs.size();
+    // Without a known interval, jitter is measured against the average frame time
+    double targetMs = pacer.intervalTicks > 0 && (pacer.mode == PacingMode::CAP || pacer.presentMode == VK_PRESENT_MODE_FIFO_KHR ||
+                                                  pacer.presentMode == VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+                          ? ticksToMs(pacer.intervalTicks)
+                          : mean;
+
+    double variance = 0.0;
+    double deviation = 0.0;
+    uint32_t missed = 0;
+    for (double ms : frameTimesMs) {
+        variance += (ms - mean) * (ms - mean);
+        deviation += std::fabs(ms - targetMs);
+        if (ms > targetMs * 1.5) {
+            missed++;
+        }
+    }
+    SDL_Log("[bench] pacing mode=%s present=%s target=%.3fms jitter stddev=%.3fms mean |dt-target|=%.3fms missed=%u (%.1f%%)",
+            pacing_mode_name(pacer.mode), presentModeName(pacer.presentMode), targetMs,
+            std::sqrt(variance / frameTimesMs.size()), deviation / frameTimesMs.size(), missed,
+            100.0 * missed / frameTimesMs.size());
+    log_frame_time_stats("pacing wait", compute_frame_time_stats(pacer.waitMs));
+    log_frame_time_stats("input to present", compute_frame_time_stats(pacer.inputToPresentMs));
+    if (pacer.presentWait) {
+        log_frame_time_stats("input to display", compute_frame_time_stats(pacer.inputToDisplayMs));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+// vsdl_headless.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include <SDL3/SDL.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "vsdl_headless.h"
+#include "vsdl_types.h"
+
+bool headless_create(VSDL_Context& ctx) {
+    HeadlessTarget& target = ctx.headlessTarget;
+    ctx.swapchainImageFormat = VSDL_HEADLESS_FORMAT;
+    ctx.swapchainExtent = {VSDL_HEADLESS_WIDTH, VSDL_HEADLESS_HEIGHT};
+
+    // An image is reused only after every frame slot has cycled past it
+    uint32_t imageCount = SDL_max(ctx.options.headlessImages, ctx.options.framesInFlight);
+    ctx.swapchainImages.assign(imageCount, VK_NULL_HANDLE);
+    ctx.swapchainImageViews.assign(imageCount, VK_NULL_HANDLE);
+    target.allocations.assign(imageCount, VK_NULL_HANDLE);
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+        VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = ctx.swapchainImageFormat;
+        imageInfo.extent = {ctx.swapchainExtent.width, ctx.swapchainExtent.height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        // Color attachment or blit target of the render graph, copy source for readback
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        if (vmaCreateImage(ctx.allocator, &imageInfo, &allocInfo, &ctx.swapchainImages[i], &target.allocations[i], nullptr) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create headless image %u", i);
+            return false;
+        }
+
+        VkImageViewCreateInfo viewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        viewInfo.image = ctx.swapchainImages[i];
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = ctx.swapchainImageFormat;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        if (vkCreateImageView(ctx.device, &viewInfo, nullptr, &ctx.swapchainImageViews[i]) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create headless image view %u", i);
+            return false;
+        }
+    }
+
+    if (ctx.options.readbackPath || ctx.options.goldenPath) {
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = (VkDeviceSize)ctx.swapchainExtent.width * ctx.swapchainExtent.height * 4;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo info = {};
+        if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, &target.readbackBuffer, &target.readbackAllocation, &info) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create readback buffer");
+            return false;
+        }
+        target.readbackMapped = static_cast<uint8_t*>(info.pMappedData);
+    }
+
+    SDL_Log("Headless target created: %u images %ux%u%s", imageCount, ctx.swapchainExtent.width,
+            ctx.swapchainExtent.height, target.readbackBuffer ? " with readback" : "");
+    return true;
+}
+
+void headless_destroy(VSDL_Context& ctx) {
+    HeadlessTarget& target = ctx.headlessTarget;
+    for (auto& view : ctx.swapchainImageViews) {
+        if (view) {
+            vkDestroyImageView(ctx.device, view, nullptr);
+        }
+    }
+    ctx.swapchainImageViews.clear();
+    for (size_t i = 0; i < target.allocations.size(); i++) {
+        if (ctx.swapchainImages[i]) {
+            vmaDestroyImage(ctx.allocator, ctx.swapchainImages[i], target.allocations[i]);
+        }
+    }
+    ctx.swapchainImages.clear();
+    if (target.readbackBuffer) {
+        vmaDestroyBuffer(ctx.allocator, target.readbackBuffer, target.readbackAllocation);
+    }
+    target = HeadlessTarget{};
+}
+
+uint32_t headless_acquire(VSDL_Context& ctx) {
+    HeadlessTarget& target = ctx.headlessTarget;
+    uint32_t imageIndex = target.nextImage;
+    target.nextImage = (target.nextImage + 1) % (uint32_t)ctx.swapchainImages.size();
+    return imageIndex;
+}
+
+// Binary PPM (P6): trivial to write and read back, and viewable everywhere
+static bool writePpm(const char* path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", path);
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(rgb.data()), (std::streamsize)rgb.size());
+    return (bool)file;
+}
+
+static bool readPpm(const char* path, std::vector<uint8_t>& rgb, uint32_t* width, uint32_t* height) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    uint32_t maxValue = 0;
+    if (!file.is_open() || !(file >> magic >> *width >> *height >> maxValue) || magic != "P6" || maxValue != 255) {
+        return false;
+    }
+    file.get(); // Single whitespace byte before the pixel data
+    rgb.resize((size_t)*width * *height * 3);
+    file.read(reinterpret_cast<char*>(rgb.data()), (std::streamsize)rgb.size());
+    return (bool)file;
+}
+
+static bool compareGolden(VSDL_Context& ctx, const std::vector<uint8_t>& rgb) {
+    std::vector<uint8_t> golden;
+    uint32_t width = 0, height = 0;
+    if (!readPpm(ctx.options.goldenPath, golden, &width, &height)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to read golden image %s", ctx.options.goldenPath);
+        return false;
+    }
+    if (width != ctx.swapchainExtent.width || height != ctx.swapchainExtent.height) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Golden image is %ux%u, frame is %ux%u", width, height,
+                     ctx.swapchainExtent.width, ctx.swapchainExtent.height);
+        return false;
+    }
+
+    size_t pixelCount = (size_t)width * height;
+    size_t differing = 0;
+    int maxDelta = 0;
+    for (size_t i = 0; i < pixelCount; i++) {
+        int pixelDelta = 0;
+        for (size_t c = 0; c < 3; c++) {
+            pixelDelta = SDL_max(pixelDelta, SDL_abs((int)rgb[i * 3 + c] - (int)golden[i * 3 + c]));
+        }
+        maxDelta = SDL_max(maxDelta, pixelDelta);
+        if (pixelDelta > (int)ctx.options.goldenTolerance) {
+            differing++;
+        }
+    }
+    bool match = differing <= (size_t)(pixelCount * VSDL_GOLDEN_MAX_DIFF_FRACTION);
+    SDL_Log("[bench] golden %s: %zu of %zu pixels differ by more than %u (max delta %d)",
+            match ? "match" : "MISMATCH", differing, pixelCount, ctx.options.goldenTolerance, maxDelta);
+    return match;
+}
+
+bool headless_readback(VSDL_Context& ctx, uint32_t imageIndex) {
+    HeadlessTarget& target = ctx.headlessTarget;
+    if (!target.readbackBuffer) {
+        return true;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocInfo.commandPool = ctx.commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(ctx.device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate readback command buffer");
+        return false;
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    // Make the frame's last writes (scene pass or upscale blit) visible to the
+    // copy; waiting idle only orders execution, it makes nothing visible
+    VkImageMemoryBarrier imageBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = ctx.swapchainImages[imageIndex];
+    imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {ctx.swapchainExtent.width, ctx.swapchainExtent.height, 1};
+    vkCmdCopyImageToBuffer(commandBuffer, ctx.swapchainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           target.readbackBuffer, 1, &region);
+
+    VkBufferMemoryBarrier barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = target.readbackBuffer;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &barrier, 0, nullptr);
+    vkEndCommandBuffer(commandBuffer);
+
+    // One copy at shutdown, outside the measured frames; waiting idle is fine here
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    bool submitted = vkQueueSubmit(ctx.graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS &&
+                     vkQueueWaitIdle(ctx.graphicsQueue) == VK_SUCCESS;
+    vkFreeCommandBuffers(ctx.device, ctx.commandPool, 1, &commandBuffer);
+    if (!submitted) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to read back headless image");
+        return false;
+    }
+    vmaInvalidateAllocation(ctx.allocator, target.readbackAllocation, 0, VK_WHOLE_SIZE);
+
+    // BGRA -> RGB
+    size_t pixelCount = (size_t)ctx.swapchainExtent.width * ctx.swapchainExtent.height;
+    std::vector<uint8_t> rgb(pixelCount * 3);
+    for (size_t i = 0; i < pixelCount; i++) {
+        rgb[i * 3 + 0] = target.readbackMapped[i * 4 + 2];
+        rgb[i * 3 + 1] = target.readbackMapped[i * 4 + 1];
+        rgb[i * 3 + 2] = target.readbackMapped[i * 4 + 0];
+    }
+
+    bool ok = true;
+    if (ctx.options.readbackPath) {
+        if (writePpm(ctx.options.readbackPath, rgb, ctx.swapchainExtent.width, ctx.swapchainExtent.height)) {
+            SDL_Log("Headless frame written to %s", ctx.options.readbackPath);
+        } else {
+            ok = false;
+        }
+    }
+    if (ctx.options.goldenPath) {
+        ok = compareGolden(ctx, rgb) && ok;
+    }
+    return ok;
+}
\ No newline at end of file
@@ -7,20 +7,25 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
 #include "vsdl_types.h"
+#include "vsdl_upload.h"
+#include "vsdl_pipeline_cache.h"
 #include <stdexcept>
 
 bool vsdl_init(VSDL_Context& ctx) {
+    // Headless runs need no video driver at all, only the event queue for quit
     SDL_Log("vsdl_init SDL_Init");
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
+    if (!SDL_Init(ctx.options.headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init failed: %s", SDL_GetError());
         return false;
     }
 
-    SDL_Log("vsdl_init SDL_CreateWindow");
-    ctx.window = SDL_CreateWindow("Vulkan Triangle", 800, 600, SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE );
-    if (!ctx.window) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Window creation failed: %s", SDL_GetError());
-        return false;
+    if (!ctx.options.headless) {
+        SDL_Log("vsdl_init SDL_CreateWindow");
+        ctx.window = SDL_CreateWindow("Vulkan Triangle", 800, 600, SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE );
+        if (!ctx.window) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Window creation failed: %s", SDL_GetError());
+            return false;
+        }
     }
 
     SDL_Log("vsdl_init volkInitialize");
@@ -37,10 +42,21 @@ bool vsdl_init(VSDL_Context& ctx) {
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.apiVersion = VK_API_VERSION_1_3;
 
-    const char* instanceExtensions[] = {VK_KHR_SURFACE_EXTENSION_NAME, "VK_KHR_win32_surface"};
+    // Ask SDL for the surface extensions of the active video driver so the same
+    // binary runs on win32, X11/Wayland and the offscreen (headless) driver.
+    // Headless mode renders into its own images and needs no surface extensions.
+    Uint32 instanceExtensionCount = 0;
+    const char* const* instanceExtensions = nullptr;
+    if (!ctx.options.headless) {
+        instanceExtensions = SDL_Vulkan_GetInstanceExtensions(&instanceExtensionCount);
+    }
+    if (!instanceExtensions && !ctx.options.headless) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to query Vulkan instance extensions: %s", SDL_GetError());
+        return false;
+    }
     VkInstanceCreateInfo createInfo = {VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
     createInfo.pApplicationInfo = &appInfo;
-    createInfo.enabledExtensionCount = 2;
+    createInfo.enabledExtensionCount = instanceExtensionCount;
     createInfo.ppEnabledExtensionNames = instanceExtensions;
 
     SDL_Log("init vkCreateInstance");
@@ -49,7 +65,7 @@ bool vsdl_init(VSDL_Context& ctx) {
         return false;
     }
     volkLoadInstance(ctx.instance);
-    SDL_Log("Vulkan instance created with %u extensions", 2);
+    SDL_Log("Vulkan instance created with %u extensions", instanceExtensionCount);
 
     uint32_t deviceCount = 0;
     vkEnumeratePhysicalDevices(ctx.instance, &deviceCount, nullptr);
@@ -75,24 +91,127 @@ bool vsdl_init(VSDL_Context& ctx) {
             break;
         }
     }
+    // Prefer a transfer-only family (usually a DMA engine) for uploads so they
+    // run alongside rendering; fall back to the graphics queue.
+    uint32_t transferFamily = graphicsFamily;
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            transferFamily = i;
+            break;
+        }
+    }
     SDL_free(queueFamilies);
     if (graphicsFamily == UINT32_MAX) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No graphics queue family found");
         return false;
     }
-    SDL_Log("Graphics queue family: %u", graphicsFamily);
+    SDL_Log("Graphics queue family: %u, transfer queue family: %u", graphicsFamily, transferFamily);
 
     float queuePriority = 1.0f;
-    VkDeviceQueueCreateInfo queueCreateInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-    queueCreateInfo.queueFamilyIndex = graphicsFamily;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceQueueCreateInfo queueCreateInfos[2] = {};
+    queueCreateInfos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfos[0].queueFamilyIndex = graphicsFamily;
+    queueCreateInfos[0].queueCount = 1;
+    queueCreateInfos[0].pQueuePriorities = &queuePriority;
+    queueCreateInfos[1] = queueCreateInfos[0];
+    queueCreateInfos[1].queueFamilyIndex = transferFamily;
+    uint32_t queueCreateInfoCount = transferFamily != graphicsFamily ? 2 : 1;
+
+    // Indirect drawing features used by the batching path; each is optional
+    VkPhysicalDeviceVulkan12Features supported12 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+    VkPhysicalDeviceFeatures2 supported = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+    supported.pNext = &supported12;
+
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(ctx.physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(ctx.physicalDevice, nullptr, &extensionCount, extensions.data());
+    bool hasPresentId = false, hasPresentWait = false, hasDynamicRendering = false;
+    for (const auto& extension : extensions) {
+        hasPresentId = hasPresentId || SDL_strcmp(extension.extensionName, VK_KHR_PRESENT_ID_EXTENSION_NAME) == 0;
+        hasPresentWait = hasPresentWait || SDL_strcmp(extension.extensionName, VK_KHR_PRESENT_WAIT_EXTENSION_NAME) == 0;
+        hasDynamicRendering = hasDynamicRendering || SDL_strcmp(extension.extensionName, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) == 0;
+    }
+
+    // Present ids and vkWaitForPresentKHR let the frame pacer see when frames
+    // reach the display; only queried when both extensions exist
+    VkPhysicalDevicePresentIdFeaturesKHR supportedPresentId = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR};
+    VkPhysicalDevicePresentWaitFeaturesKHR supportedPresentWait = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR};
+    bool queryPresentWait = !ctx.options.headless && hasPresentId && hasPresentWait;
+    if (queryPresentWait) {
+        supported12.pNext = &supportedPresentId;
+        supportedPresentId.pNext = &supportedPresentWait;
+    }
+
+    // Dynamic rendering is core in Vulkan 1.3 and an extension before it; the
+    // same feature struct layout serves both
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(ctx.physicalDevice, &deviceProperties);
+    bool coreDynamicRendering = deviceProperties.apiVersion >= VK_API_VERSION_1_3;
+    VkPhysicalDeviceDynamicRenderingFeatures supportedDynamicRendering = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES};
+    if (ctx.options.dynamicRendering && (coreDynamicRendering || hasDynamicRendering)) {
+        supportedDynamicRendering.pNext = supported.pNext;
+        supported.pNext = &supportedDynamicRendering;
+    }
+    vkGetPhysicalDeviceFeatures2(ctx.physicalDevice, &supported);
+
+    VkPhysicalDeviceVulkan12Features enabled12 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+    enabled12.drawIndirectCount = supported12.drawIndirectCount;
+    enabled12.timelineSemaphore = VK_TRUE; // Upload completion tracking; core in Vulkan 1.2
+    VkPhysicalDeviceFeatures2 enabled = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+    enabled.pNext = &enabled12;
+    enabled.features.multiDrawIndirect = supported.features.multiDrawIndirect;
+    enabled.features.drawIndirectFirstInstance = supported.features.drawIndirectFirstInstance;
+    enabled.features.pipelineStatisticsQuery = supported.features.pipelineStatisticsQuery; // Profiler counters
 
-    const char* deviceExtensions[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+    VkPhysicalDevicePresentIdFeaturesKHR enabledPresentId = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR};
+    VkPhysicalDevicePresentWaitFeaturesKHR enabledPresentWait = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR};
+    bool presentWait = queryPresentWait && supportedPresentId.presentId && supportedPresentWait.presentWait;
+    if (presentWait) {
+        enabledPresentId.presentId = VK_TRUE;
+        enabledPresentWait.presentWait = VK_TRUE;
+        enabled12.pNext = &enabledPresentId;
+        enabledPresentId.pNext = &enabledPresentWait;
+    }
+
+    VkPhysicalDeviceDynamicRenderingFeatures enabledDynamicRendering = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES};
+    bool dynamicRendering = supportedDynamicRendering.dynamicRendering == VK_TRUE;
+    if (dynamicRendering) {
+        enabledDynamicRendering.dynamicRendering = VK_TRUE;
+        enabledDynamicRendering.pNext = enabled.pNext;
+        enabled.pNext = &enabledDynamicRendering;
+    } else if (ctx.options.dynamicRendering) {
+        SDL_Log("Dynamic rendering not supported, falling back to render passes");
+    }
+
+    ctx.features.multiDrawIndirect = enabled.features.multiDrawIndirect == VK_TRUE;
+    ctx.features.drawIndirectFirstInstance = enabled.features.drawIndirectFirstInstance == VK_TRUE;
+    ctx.features.drawIndirectCount = enabled12.drawIndirectCount == VK_TRUE;
+    ctx.features.pipelineStatisticsQuery = enabled.features.pipelineStatisticsQuery == VK_TRUE;
+    ctx.features.presentWait = presentWait;
+    ctx.features.dynamicRendering = dynamicRendering;
+    SDL_Log("Device features: multiDrawIndirect %d, drawIndirectFirstInstance %d, drawIndirectCount %d, pipelineStatisticsQuery %d, presentWait %d, dynamicRendering %d",
+            ctx.features.multiDrawIndirect, ctx.features.drawIndirectFirstInstance, ctx.features.drawIndirectCount,
+            ctx.features.pipelineStatisticsQuery, ctx.features.presentWait, ctx.features.dynamicRendering);
+
+    const char* deviceExtensions[4];
+    uint32_t deviceExtensionCount = 0;
+    if (!ctx.options.headless) {
+        deviceExtensions[deviceExtensionCount++] = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    }
+    if (presentWait) {
+        deviceExtensions[deviceExtensionCount++] = VK_KHR_PRESENT_ID_EXTENSION_NAME;
+        deviceExtensions[deviceExtensionCount++] = VK_KHR_PRESENT_WAIT_EXTENSION_NAME;
+    }
+    if (dynamicRendering && !coreDynamicRendering) {
+        deviceExtensions[deviceExtensionCount++] = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+    }
     VkDeviceCreateInfo deviceCreateInfo = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
-    deviceCreateInfo.queueCreateInfoCount = 1;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
-    deviceCreateInfo.enabledExtensionCount = 1;
+    deviceCreateInfo.pNext = &enabled; // pEnabledFeatures stays null when chaining Features2
+    deviceCreateInfo.queueCreateInfoCount = queueCreateInfoCount;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
+    deviceCreateInfo.enabledExtensionCount = deviceExtensionCount;
     deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions;
 
     if (vkCreateDevice(ctx.physicalDevice, &deviceCreateInfo, nullptr, &ctx.device) != VK_SUCCESS) {
@@ -100,6 +219,11 @@ bool vsdl_init(VSDL_Context& ctx) {
         return false;
     }
     volkLoadDevice(ctx.device);
+    if (dynamicRendering && !coreDynamicRendering) {
+        // Pre-1.3 devices only expose the KHR entry points; volk left the core ones null
+        vkCmdBeginRendering = vkCmdBeginRenderingKHR;
+        vkCmdEndRendering = vkCmdEndRenderingKHR;
+    }
     SDL_Log("Vulkan device created");
 
     // Initialize VMA with Vulkan functions
@@ -125,5 +249,16 @@ bool vsdl_init(VSDL_Context& ctx) {
     ctx.graphicsFamily = graphicsFamily;
     SDL_Log("Graphics queue retrieved");
 
+    vkGetDeviceQueue(ctx.device, transferFamily, 0, &ctx.transferQueue);
+    ctx.transferFamily = transferFamily;
+
+    if (!upload_manager_create(ctx)) {
+        return false;
+    }
+
+    if (!pipeline_cache_load(ctx)) {
+        return false;
+    }
+
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+// vsdl_linear_alloc.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include <SDL3/SDL_log.h>
+#include "vsdl_linear_alloc.h"
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool linear_alloc_create(VSDL_Context& ctx, LinearAllocator& ring, VkBufferUsageFlags usage,
+                         VkDeviceSize regionSize, uint32_t regionCount, VkDeviceSize alignment) {
+    ring.alignment = alignment > 0 ? alignment : 1;
+    ring.regionSize = alignUp(regionSize, ring.alignment);
+    ring.regionCount = regionCount;
+    ring.region = 0;
+    ring.head = 0;
+
+    VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = ring.regionSize * regionCount;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo info = {};
+    if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, &ring.buffer, &ring.allocation, &info) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create linear allocator buffer");
+        return false;
+    }
+    ring.mapped = static_cast<uint8_t*>(info.pMappedData);
+    SDL_Log("Linear allocator created: %u regions x %llu bytes (alignment %llu)", regionCount,
+            (unsigned long long)ring.regionSize, (unsigned long long)ring.alignment);
+    return true;
+}
+
+void linear_alloc_destroy(VSDL_Context& ctx, LinearAllocator& ring) {
+    if (ring.buffer) {
+        vmaDestroyBuffer(ctx.allocator, ring.buffer, ring.allocation);
+    }
+    ring = LinearAllocator{};
+}
+
+void linear_alloc_begin_frame(LinearAllocator& ring, uint32_t frameIndex) {
+    ring.region = frameIndex % ring.regionCount;
+    ring.head = 0;
+}
+
+void* linear_alloc(LinearAllocator& ring, VkDeviceSize size, VkDeviceSize* outOffset) {
+    VkDeviceSize alignedSize = alignUp(size, ring.alignment);
+    if (ring.head + alignedSize > ring.regionSize) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Linear allocator region exhausted (%llu + %llu > %llu)",
+                     (unsigned long long)ring.head, (unsigned long long)alignedSize, (unsigned long long)ring.regionSize);
+        return nullptr;
+    }
+    VkDeviceSize offset = ring.region * ring.regionSize + ring.head;
+    ring.head += alignedSize;
+    *outOffset = offset;
+    return ring.mapped + offset;
+}
+
+void linear_alloc_flush(VSDL_Context& ctx, LinearAllocator& ring) {
+    if (ring.head > 0) {
+        vmaFlushAllocation(ctx.allocator, ring.allocation, ring.region * ring.regionSize, ring.head);
+    }
+}
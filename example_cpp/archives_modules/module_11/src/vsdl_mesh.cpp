@@ -6,130 +6,113 @@
 #include <SDL3/SDL_log.h>
 #include "vsdl_mesh.h"
 #include "vsdl_types.h"
-
-bool create_triangle_buffer(VSDL_Context& ctx) {
-  static float offsetX = 0.0f;
-  Vertex vertices[] = {
-      {{ 0.0f + offsetX, -0.25f}, {1.0f, 0.0f, 0.0f}}, // Top: Red
-      {{ 0.25f + offsetX, 0.25f}, {0.0f, 1.0f, 0.0f}}, // Bottom right: Green
-      {{-0.25f + offsetX, 0.25f}, {0.0f, 0.0f, 1.0f}}  // Bottom left: Blue
+#include "vsdl_linear_alloc.h"
+#include "vsdl_mesh_arena.h"
+#include "vsdl_command_cache.h"
+
+bool create_mesh_geometry(VSDL_Context& ctx) {
+  Vertex triangleVertices[] = {
+      {{ 0.0f, -0.25f}, {1.0f, 0.0f, 0.0f}}, // Top: Red
+      {{ 0.25f, 0.25f}, {0.0f, 1.0f, 0.0f}}, // Bottom right: Green
+      {{-0.25f, 0.25f}, {0.0f, 0.0f, 1.0f}}  // Bottom left: Blue
   };
-  VkDeviceSize bufferSize = sizeof(vertices);
-
-  VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-  bufferInfo.size = bufferSize;
-  bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  uint32_t triangleIndices[] = {0, 1, 2}; // Indexed so every mesh shares one draw path
 
-  VmaAllocationCreateInfo allocInfo = {};
-  allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-  allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+  Vertex planeVertices[] = {
+      {{-0.25f, -0.25f}, {1.0f, 0.0f, 0.0f}}, // Top-left: Red
+      {{ 0.25f, -0.25f}, {0.0f, 1.0f, 0.0f}}, // Top-right: Green
+      {{ 0.25f,  0.25f}, {0.0f, 0.0f, 1.0f}}, // Bottom-right: Blue
+      {{-0.25f,  0.25f}, {1.0f, 1.0f, 0.0f}}  // Bottom-left: Yellow
+  };
+  uint32_t planeIndices[] = {0, 1, 2, 2, 3, 0}; // Two triangles
 
-  Mesh mesh;
-  mesh.type = MeshType::TRIANGLE;
-  if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, &mesh.vertexBuffer, &mesh.vertexAllocation, nullptr) != VK_SUCCESS) {
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create triangle vertex buffer");
+  Mesh& triangle = ctx.meshGeometry[(int)MeshType::TRIANGLE];
+  triangle.type = MeshType::TRIANGLE;
+  if (!mesh_arena_upload(ctx, triangle, triangleVertices, 3, triangleIndices, 3)) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create triangle mesh");
       return false;
   }
 
-  void* data;
-  vmaMapMemory(ctx.allocator, mesh.vertexAllocation, &data);
-  memcpy(data, vertices, bufferSize);
-  vmaUnmapMemory(ctx.allocator, mesh.vertexAllocation);
+  Mesh& plane = ctx.meshGeometry[(int)MeshType::PLANE];
+  plane.type = MeshType::PLANE;
+  if (!mesh_arena_upload(ctx, plane, planeVertices, 4, planeIndices, 6)) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create plane mesh");
+      return false;
+  }
+  SDL_Log("Mesh geometry created in arena");
+  return true;
+}
 
-  ctx.meshes.push_back(mesh);
-  SDL_Log("Triangle buffer created with VMA (total: %zu)", ctx.meshes.size());
-  offsetX += 0.5f;
+bool add_mesh_instance(VSDL_Context& ctx, MeshType type, float x, float y, float scale, float rotation) {
+  if (ctx.meshes.size() >= VSDL_MAX_INSTANCES) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mesh instance limit reached (%d)", VSDL_MAX_INSTANCES);
+      return false;
+  }
+  MeshInstance instance;
+  instance.type = type;
+  instance.data = {{x, y}, scale, rotation};
+  ctx.meshes.push_back(instance);
+  command_cache_invalidate(ctx);
   return true;
 }
 
-bool create_plane_buffer(VSDL_Context& ctx) {
+bool create_triangle_instance(VSDL_Context& ctx) {
   static float offsetX = 0.0f;
-  Vertex vertices[] = {
-      {{-0.25f + offsetX, -0.25f}, {1.0f, 0.0f, 0.0f}}, // Top-left: Red
-      {{ 0.25f + offsetX, -0.25f}, {0.0f, 1.0f, 0.0f}}, // Top-right: Green
-      {{ 0.25f + offsetX,  0.25f}, {0.0f, 0.0f, 1.0f}}, // Bottom-right: Blue
-      {{-0.25f + offsetX,  0.25f}, {1.0f, 1.0f, 0.0f}}  // Bottom-left: Yellow
-  };
-  uint32_t indices[] = {0, 1, 2, 2, 3, 0}; // Two triangles
-  VkDeviceSize vertexSize = sizeof(vertices);
-  VkDeviceSize indexSize = sizeof(indices);
-
-  VkBufferCreateInfo vertexBufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-  vertexBufferInfo.size = vertexSize;
-  vertexBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-  vertexBufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-  VkBufferCreateInfo indexBufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-  indexBufferInfo.size = indexSize;
-  indexBufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-  indexBufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-  VmaAllocationCreateInfo allocInfo = {};
-  allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-  allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-
-  Mesh mesh;
-  mesh.type = MeshType::PLANE;
-  mesh.indexCount = 6;
-
-  if (vmaCreateBuffer(ctx.allocator, &vertexBufferInfo, &allocInfo, &mesh.vertexBuffer, &mesh.vertexAllocation, nullptr) != VK_SUCCESS) {
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create plane vertex buffer");
+  if (!add_mesh_instance(ctx, MeshType::TRIANGLE, offsetX, 0.0f, 1.0f, 0.0f)) {
       return false;
   }
-  if (vmaCreateBuffer(ctx.allocator, &indexBufferInfo, &allocInfo, &mesh.indexBuffer, &mesh.indexAllocation, nullptr) != VK_SUCCESS) {
-      vmaDestroyBuffer(ctx.allocator, mesh.vertexBuffer, mesh.vertexAllocation);
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create plane index buffer");
+  SDL_Log("Triangle instance created (total: %zu)", ctx.meshes.size());
+  offsetX += 0.5f;
+  return true;
+}
+
+bool create_plane_instance(VSDL_Context& ctx) {
+  static float offsetX = 0.0f;
+  if (!add_mesh_instance(ctx, MeshType::PLANE, offsetX, 0.0f, 1.0f, 0.0f)) {
       return false;
   }
-
-  void* data;
-  vmaMapMemory(ctx.allocator, mesh.vertexAllocation, &data);
-  memcpy(data, vertices, vertexSize);
-  vmaUnmapMemory(ctx.allocator, mesh.vertexAllocation);
-
-  vmaMapMemory(ctx.allocator, mesh.indexAllocation, &data);
-  memcpy(data, indices, indexSize);
-  vmaUnmapMemory(ctx.allocator, mesh.indexAllocation);
-
-  ctx.meshes.push_back(mesh);
-  SDL_Log("Plane buffer created with VMA (total: %zu)", ctx.meshes.size());
+  SDL_Log("Plane instance created (total: %zu)", ctx.meshes.size());
   offsetX += 0.5f;
   return true;
 }
 
-bool destroy_mesh(VSDL_Context& ctx) {
+bool destroy_mesh_instance(VSDL_Context& ctx) {
   if (ctx.meshes.empty()) {
       SDL_Log("No meshes to destroy");
       return false;
   }
 
-  Mesh& mesh = ctx.meshes.back();
-  vmaDestroyBuffer(ctx.allocator, mesh.vertexBuffer, mesh.vertexAllocation);
-  if (mesh.indexBuffer) {
-      vmaDestroyBuffer(ctx.allocator, mesh.indexBuffer, mesh.indexAllocation);
-  }
+  // Instance data is rewritten every frame, so nothing on the GPU needs retiring
   ctx.meshes.pop_back();
-  SDL_Log("Mesh destroyed (remaining: %zu)", ctx.meshes.size());
+  command_cache_invalidate(ctx);
+  SDL_Log("Mesh instance destroyed (remaining: %zu)", ctx.meshes.size());
   return true;
 }
 
 bool create_uniform_buffer(VSDL_Context& ctx) {
-  VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-
-  VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-  bufferInfo.size = bufferSize;
-  bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  // One region per frame in flight, addressed through dynamic UBO offsets
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(ctx.physicalDevice, &properties);
+  VkDeviceSize alignment = properties.limits.minUniformBufferOffsetAlignment;
 
-  VmaAllocationCreateInfo allocInfo = {};
-  allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-  allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-
-  if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, &ctx.uniformBuffer, &ctx.uniformBufferAllocation, nullptr) != VK_SUCCESS) {
+  if (!linear_alloc_create(ctx, ctx.uniformRing, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                           VSDL_UNIFORM_RING_REGION_SIZE, ctx.options.framesInFlight, alignment)) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create uniform buffer");
       return false;
   }
-  SDL_Log("Uniform buffer created with VMA");
+  SDL_Log("Uniform ring buffer created with VMA");
+  return true;
+}
+
+bool create_instance_buffer(VSDL_Context& ctx) {
+  // Instance data plus one indirect command per MeshType and the draw count, per frame
+  VkDeviceSize regionSize = (VkDeviceSize)VSDL_MAX_INSTANCES * sizeof(InstanceData) + 1024;
+  if (!linear_alloc_create(ctx, ctx.instanceRing,
+                           VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                           regionSize, ctx.options.framesInFlight, 16)) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create instance buffer");
+      return false;
+  }
+  SDL_Log("Instance ring buffer created with VMA");
   return true;
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+// vsdl_mesh_arena.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include <SDL3/SDL_log.h>
+#include <cstring>
+#include "vsdl_mesh_arena.h"
+#include "vsdl_types.h"
+#include "vsdl_upload.h"
+
+void range_allocator_init(RangeAllocator& ranges, uint32_t capacity) {
+    ranges.capacity = capacity;
+    ranges.freeRanges.clear();
+    ranges.freeRanges.push_back({0, capacity});
+}
+
+bool range_alloc(RangeAllocator& ranges, uint32_t count, uint32_t* outOffset) {
+    for (size_t i = 0; i < ranges.freeRanges.size(); i++) {
+        RangeAllocator::Range& range = ranges.freeRanges[i];
+        if (range.count < count) {
+            continue;
+        }
+        *outOffset = range.offset;
+        range.offset += count;
+        range.count -= count;
+        if (range.count == 0) {
+            ranges.freeRanges.erase(ranges.freeRanges.begin() + i);
+        }
+        return true;
+    }
+    return false;
+}
+
+void range_free(RangeAllocator& ranges, uint32_t offset, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    auto& freeRanges = ranges.freeRanges;
+    size_t i = 0;
+    while (i < freeRanges.size() && freeRanges[i].offset < offset) {
+        i++;
+    }
+    freeRanges.insert(freeRanges.begin() + i, {offset, count});
+
+    // Merge with the following range, then with the preceding one
+    if (i + 1 < freeRanges.size() && freeRanges[i].offset + freeRanges[i].count == freeRanges[i + 1].offset) {
+        freeRanges[i].count += freeRanges[i + 1].count;
+        freeRanges.erase(freeRanges.begin() + i + 1);
+    }
+    if (i > 0 && freeRanges[i - 1].offset + freeRanges[i - 1].count == freeRanges[i].offset) {
+        freeRanges[i - 1].count += freeRanges[i].count;
+        freeRanges.erase(freeRanges.begin() + i);
+    }
+}
+
+static bool createArenaBuffer(VSDL_Context& ctx, VkDeviceSize size, VkBufferUsageFlags usage,
+                              VkBuffer* buffer, VmaAllocation* allocation, void** mapped) {
+    VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    upload_set_sharing(ctx, bufferInfo); // Written by the transfer queue, read by graphics
+
+    // Prefer device-local memory; accept host-visible device-local memory
+    // (ReBAR/UMA) so uploads can skip the staging copy when it is available.
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                      VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+                      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo info = {};
+    if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, buffer, allocation, &info) != VK_SUCCESS) {
+        return false;
+    }
+    VkMemoryPropertyFlags memoryFlags;
+    vmaGetAllocationMemoryProperties(ctx.allocator, *allocation, &memoryFlags);
+    *mapped = (memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? info.pMappedData : nullptr;
+    return true;
+}
+
+bool create_mesh_arena(VSDL_Context& ctx) {
+    MeshArena& arena = ctx.meshArena;
+    if (!createArenaBuffer(ctx, sizeof(Vertex) * (VkDeviceSize)VSDL_MESH_ARENA_VERTICES, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                           &arena.vertexBuffer, &arena.vertexAllocation, &arena.vertexMapped)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create mesh arena vertex buffer");
+        return false;
+    }
+    if (!createArenaBuffer(ctx, sizeof(uint32_t) * (VkDeviceSize)VSDL_MESH_ARENA_INDICES, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                           &arena.indexBuffer, &arena.indexAllocation, &arena.indexMapped)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create mesh arena index buffer");
+        vmaDestroyBuffer(ctx.allocator, arena.vertexBuffer, arena.vertexAllocation);
+        arena.vertexBuffer = VK_NULL_HANDLE;
+        return false;
+    }
+    range_allocator_init(arena.vertexRanges, VSDL_MESH_ARENA_VERTICES);
+    range_allocator_init(arena.indexRanges, VSDL_MESH_ARENA_INDICES);
+    SDL_Log("Mesh arena created: %u vertices, %u indices (%s)", VSDL_MESH_ARENA_VERTICES, VSDL_MESH_ARENA_INDICES,
+            arena.vertexMapped ? "host-visible" : "staged uploads");
+    return true;
+}
+
+void destroy_mesh_arena(VSDL_Context& ctx) {
+    MeshArena& arena = ctx.meshArena;
+    if (arena.vertexBuffer) {
+        vmaDestroyBuffer(ctx.allocator, arena.vertexBuffer, arena.vertexAllocation);
+    }
+    if (arena.indexBuffer) {
+        vmaDestroyBuffer(ctx.allocator, arena.indexBuffer, arena.indexAllocation);
+    }
+    arena = MeshArena{};
+}
+
+static bool writeArena(VSDL_Context& ctx, VkBuffer buffer, VmaAllocation allocation, void* mapped,
+                       VkDeviceSize offset, const void* data, VkDeviceSize size) {
+    if (mapped) {
+        memcpy(static_cast<uint8_t*>(mapped) + offset, data, size);
+        vmaFlushAllocation(ctx.allocator, allocation, offset, size);
+        return true;
+    }
+    // Batched on the transfer queue; the next graphics submit waits on its timeline value
+    return upload_buffer(ctx, buffer, offset, data, size);
+}
+
+bool mesh_arena_upload(VSDL_Context& ctx, Mesh& mesh, const Vertex* vertices, uint32_t vertexCount,
+                       const uint32_t* indices, uint32_t indexCount) {
+    MeshArena& arena = ctx.meshArena;
+
+    if (!range_alloc(arena.vertexRanges, vertexCount, &mesh.vertexOffset)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mesh arena out of vertex space (%u requested)", vertexCount);
+        return false;
+    }
+    if (!range_alloc(arena.indexRanges, indexCount, &mesh.firstIndex)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mesh arena out of index space (%u requested)", indexCount);
+        range_free(arena.vertexRanges, mesh.vertexOffset, vertexCount);
+        return false;
+    }
+    mesh.vertexCount = vertexCount;
+    mesh.indexCount = indexCount;
+
+    // Indices stay mesh-local; vkCmdDrawIndexed adds vertexOffset
+    if (!writeArena(ctx, arena.vertexBuffer, arena.vertexAllocation, arena.vertexMapped,
+                    sizeof(Vertex) * (VkDeviceSize)mesh.vertexOffset, vertices, sizeof(Vertex) * (VkDeviceSize)vertexCount) ||
+        !writeArena(ctx, arena.indexBuffer, arena.indexAllocation, arena.indexMapped,
+                    sizeof(uint32_t) * (VkDeviceSize)mesh.firstIndex, indices, sizeof(uint32_t) * (VkDeviceSize)indexCount)) {
+        range_free(arena.vertexRanges, mesh.vertexOffset, vertexCount);
+        range_free(arena.indexRanges, mesh.firstIndex, indexCount);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
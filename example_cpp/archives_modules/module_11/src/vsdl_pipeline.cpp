@@ -3,12 +3,14 @@
 #include <vulkan/vulkan.h>
 #include <volk.h>
 #include <vk_mem_alloc.h>
-#include <SDL3/SDL_log.h>
+#include <SDL3/SDL.h>
 #include <fstream>
 #include <vector>
 #include "vsdl_pipeline.h"
 #include "vsdl_types.h"
 #include "vsdl_mesh.h"
+#include "vsdl_mesh_arena.h"
+#include "vsdl_command_cache.h"
 
 static std::vector<char> readFile(const char* filename) {
     std::ifstream file(filename, std::ios::ate | std::ios::binary);
@@ -27,44 +29,14 @@ static std::vector<char> readFile(const char* filename) {
 bool create_pipeline(VSDL_Context& ctx) {
     SDL_Log("Creating pipeline");
 
-    VkAttachmentDescription colorAttachment = {};
-    colorAttachment.format = ctx.swapchainImageFormat;
-    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    VkAttachmentReference colorAttachmentRef = {};
-    colorAttachmentRef.attachment = 0;
-    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    VkSubpassDescription subpass = {};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorAttachmentRef;
-
-    VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
-    renderPassInfo.attachmentCount = 1;
-    renderPassInfo.pAttachments = &colorAttachment;
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-
-    if (vkCreateRenderPass(ctx.device, &renderPassInfo, nullptr, &ctx.renderPass) != VK_SUCCESS) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render pass");
-        return false;
-    }
-    SDL_Log("Render pass created");
-
-    if (!create_triangle_buffer(ctx) || !create_uniform_buffer(ctx)) {
+    if (!create_mesh_arena(ctx) || !create_mesh_geometry(ctx) || !create_triangle_instance(ctx) ||
+        !create_uniform_buffer(ctx) || !create_instance_buffer(ctx)) {
         return false;
     }
 
     VkDescriptorSetLayoutBinding uboLayoutBinding = {};
     uboLayoutBinding.binding = 0;
-    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     uboLayoutBinding.descriptorCount = 1;
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
@@ -78,7 +50,7 @@ bool create_pipeline(VSDL_Context& ctx) {
     }
 
     VkDescriptorPoolSize poolSize = {};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSize.descriptorCount = 1;
 
     VkDescriptorPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
@@ -102,15 +74,15 @@ bool create_pipeline(VSDL_Context& ctx) {
     }
 
     VkDescriptorBufferInfo bufferInfo = {};
-    bufferInfo.buffer = ctx.uniformBuffer;
-    bufferInfo.offset = 0;
+    bufferInfo.buffer = ctx.uniformRing.buffer;
+    bufferInfo.offset = 0; // The per-draw offset is supplied as a dynamic offset
     bufferInfo.range = sizeof(UniformBufferObject);
 
     VkWriteDescriptorSet descriptorWrite = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
     descriptorWrite.dstSet = ctx.descriptorSet;
     descriptorWrite.dstBinding = 0;
     descriptorWrite.dstArrayElement = 0;
-    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrite.descriptorCount = 1;
     descriptorWrite.pBufferInfo = &bufferInfo;
 
@@ -145,12 +117,15 @@ bool create_pipeline(VSDL_Context& ctx) {
         {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_FRAGMENT_BIT, fragShaderModule, "main", nullptr}
     };
 
-    VkVertexInputBindingDescription bindingDesc = {};
-    bindingDesc.binding = 0;
-    bindingDesc.stride = sizeof(Vertex);
-    bindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    VkVertexInputBindingDescription bindingDescs[2] = {};
+    bindingDescs[0].binding = 0;
+    bindingDescs[0].stride = sizeof(Vertex);
+    bindingDescs[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    bindingDescs[1].binding = 1;
+    bindingDescs[1].stride = sizeof(InstanceData);
+    bindingDescs[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-    VkVertexInputAttributeDescription attributeDescs[2] = {};
+    VkVertexInputAttributeDescription attributeDescs[3] = {};
     attributeDescs[0].binding = 0;
     attributeDescs[0].location = 0;
     attributeDescs[0].format = VK_FORMAT_R32G32_SFLOAT;
@@ -159,11 +134,15 @@ bool create_pipeline(VSDL_Context& ctx) {
     attributeDescs[1].location = 1;
     attributeDescs[1].format = VK_FORMAT_R32G32B32_SFLOAT;
     attributeDescs[1].offset = offsetof(Vertex, color);
+    attributeDescs[2].binding = 1;
+    attributeDescs[2].location = 2;
+    attributeDescs[2].format = VK_FORMAT_R32G32B32A32_SFLOAT; // offset.xy, scale, rotation
+    attributeDescs[2].offset = 0;
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo = {VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDesc;
-    vertexInputInfo.vertexAttributeDescriptionCount = 2;
+    vertexInputInfo.vertexBindingDescriptionCount = 2;
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescs;
+    vertexInputInfo.vertexAttributeDescriptionCount = 3;
     vertexInputInfo.pVertexAttributeDescriptions = attributeDescs;
 
     VkPipelineInputAssemblyStateCreateInfo inputAssembly = {VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
@@ -222,17 +201,33 @@ bool create_pipeline(VSDL_Context& ctx) {
     pipelineInfo.pColorBlendState = &colorBlending;
     pipelineInfo.pDynamicState = &dynamicState;
     pipelineInfo.layout = ctx.pipelineLayout;
-    pipelineInfo.renderPass = ctx.renderPass;
     pipelineInfo.subpass = 0;
+    // Built for the render graph's scene pass: against its render pass, or with
+    // dynamic rendering against its attachment formats alone
+    const RenderGraphPass& scenePass = ctx.renderGraph.passes[ctx.scenePass];
+    VkPipelineRenderingCreateInfo renderingInfo = {VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO};
+    renderingInfo.colorAttachmentCount = (uint32_t)scenePass.colorFormats.size();
+    renderingInfo.pColorAttachmentFormats = scenePass.colorFormats.data();
+    renderingInfo.depthAttachmentFormat = scenePass.depthFormat;
+    if (ctx.renderGraph.dynamicRendering) {
+        pipelineInfo.pNext = &renderingInfo;
+    } else {
+        pipelineInfo.renderPass = scenePass.renderPass;
+    }
 
-    if (vkCreateGraphicsPipelines(ctx.device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &ctx.graphicsPipeline) != VK_SUCCESS) {
+    Uint64 createStart = SDL_GetPerformanceCounter();
+    if (vkCreateGraphicsPipelines(ctx.device, ctx.pipelineCache, 1, &pipelineInfo, nullptr, &ctx.graphicsPipeline) != VK_SUCCESS) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create graphics pipeline");
         vkDestroyPipelineLayout(ctx.device, ctx.pipelineLayout, nullptr);
         vkDestroyShaderModule(ctx.device, vertShaderModule, nullptr);
         vkDestroyShaderModule(ctx.device, fragShaderModule, nullptr);
         return false;
     }
+    double createMs = (double)(SDL_GetPerformanceCounter() - createStart) * 1000.0 / (double)SDL_GetPerformanceFrequency();
     SDL_Log("Graphics pipeline created");
+    ctx.pipelineCacheUsed = true;
+    SDL_Log("[bench] pipeline cache=%s create=%.3fms", ctx.pipelineCacheWarm ? "warm" : "cold", createMs);
+    command_cache_invalidate(ctx); // Cached render pass contents bind the pipeline
 
     vkDestroyShaderModule(ctx.device, vertShaderModule, nullptr);
     vkDestroyShaderModule(ctx.device, fragShaderModule, nullptr);
@@ -0,0 +1,117 @@
+// vsdl_pipeline_cache.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <SDL3/SDL.h>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "vsdl_pipeline_cache.h"
+#include "vsdl_types.h"
+
+// Drivers reject foreign data themselves, but some crash on it; check the
+// header Vulkan guarantees at the start of every cache blob first.
+static bool validateHeader(VSDL_Context& ctx, const std::vector<char>& data) {
+    VkPipelineCacheHeaderVersionOne header;
+    if (data.size() < sizeof(header)) {
+        SDL_Log("Pipeline cache too small (%zu bytes), ignoring", data.size());
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(ctx.physicalDevice, &properties);
+    if (header.headerSize < sizeof(header) || header.headerSize > data.size() ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        SDL_Log("Pipeline cache header malformed, ignoring");
+        return false;
+    }
+    if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+        memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        SDL_Log("Pipeline cache was written by another device or driver, ignoring");
+        return false;
+    }
+    return true;
+}
+
+bool pipeline_cache_load(VSDL_Context& ctx) {
+    std::vector<char> data;
+    if (ctx.options.pipelineCachePath) {
+        std::ifstream file(ctx.options.pipelineCachePath, std::ios::ate | std::ios::binary);
+        // tellg is -1 for unreadable paths and non-regular files: start cold
+        std::streamoff size = file.is_open() ? (std::streamoff)file.tellg() : -1;
+        if (size > 0) {
+            data.resize((size_t)size);
+            file.seekg(0);
+            file.read(data.data(), data.size());
+            if (!file || !validateHeader(ctx, data)) {
+                data.clear();
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+    if (vkCreatePipelineCache(ctx.device, &cacheInfo, nullptr, &ctx.pipelineCache) != VK_SUCCESS) {
+        // Data the driver still rejects: start over rather than fail startup
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        data.clear();
+        if (vkCreatePipelineCache(ctx.device, &cacheInfo, nullptr, &ctx.pipelineCache) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create pipeline cache");
+            return false;
+        }
+    }
+    ctx.pipelineCacheWarm = !data.empty();
+    ctx.pipelineCacheUsed = false;
+    ctx.pipelineCacheLoadedBytes = data.size();
+    SDL_Log("Pipeline cache created (%s, %zu bytes loaded)", ctx.pipelineCacheWarm ? "warm" : "cold", data.size());
+    return true;
+}
+
+bool pipeline_cache_save(VSDL_Context& ctx) {
+    if (!ctx.pipelineCache || !ctx.options.pipelineCachePath) {
+        return false;
+    }
+    size_t size = 0;
+    if (vkGetPipelineCacheData(ctx.device, ctx.pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0) {
+        return false;
+    }
+    // Nothing new to keep: rewriting would only risk replacing a warm cache
+    // with an emptier one, e.g. when startup failed before the pipelines
+    if (!ctx.pipelineCacheUsed || size <= ctx.pipelineCacheLoadedBytes) {
+        SDL_Log("Pipeline cache unchanged, not saving");
+        return false;
+    }
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(ctx.device, ctx.pipelineCache, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+
+    // A crash mid-write must never leave a truncated cache behind
+    std::string tempPath = std::string(ctx.options.pipelineCachePath) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), size);
+        file.flush();
+        if (!file) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write pipeline cache: %s", tempPath.c_str());
+            return false;
+        }
+    }
+    if (!SDL_RenamePath(tempPath.c_str(), ctx.options.pipelineCachePath)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to replace pipeline cache: %s", SDL_GetError());
+        SDL_RemovePath(tempPath.c_str());
+        return false;
+    }
+    SDL_Log("Pipeline cache saved (%zu bytes) to %s", size, ctx.options.pipelineCachePath);
+    return true;
+}
+
+void pipeline_cache_destroy(VSDL_Context& ctx) {
+    pipeline_cache_save(ctx);
+    vkDestroyPipelineCache(ctx.device, ctx.pipelineCache, nullptr);
+    ctx.pipelineCache = VK_NULL_HANDLE;
+}
\ No newline at end of file
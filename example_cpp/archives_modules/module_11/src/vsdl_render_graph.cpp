@@ -0,0 +1,696 @@
+// vsdl_render_graph.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <vector>
+#include "vsdl_render_graph.h"
+
+// Layout, stages and access of one use; also the state an image is left in
+struct UsageState {
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags stages = 0;
+    VkAccessFlags access = 0;
+};
+
+static const VkAccessFlags WRITE_ACCESS = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                          VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+static bool isAttachment(const RenderGraphUse& use) {
+    return use.usage == RenderGraphUsage::COLOR_ATTACHMENT || use.usage == RenderGraphUsage::DEPTH_ATTACHMENT;
+}
+
+static bool readsImage(const RenderGraphUse& use) {
+    return isAttachment(use) ? use.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD : use.usage != RenderGraphUsage::TRANSFER_DST;
+}
+
+static bool writesImage(const RenderGraphUse& use) {
+    return isAttachment(use) || use.usage == RenderGraphUsage::TRANSFER_DST;
+}
+
+static UsageState usageState(const RenderGraphUse& use) {
+    UsageState state;
+    switch (use.usage) {
+    case RenderGraphUsage::COLOR_ATTACHMENT:
+        state.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        state.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        state.access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        if (use.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD) {
+            state.access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+        }
+        break;
+    case RenderGraphUsage::DEPTH_ATTACHMENT:
+        // The depth test reads even when the pass clears
+        state.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        state.stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        state.access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        break;
+    case RenderGraphUsage::SAMPLED:
+        state.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        state.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT;
+        break;
+    case RenderGraphUsage::TRANSFER_SRC:
+        state.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        state.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        state.access = VK_ACCESS_TRANSFER_READ_BIT;
+        break;
+    case RenderGraphUsage::TRANSFER_DST:
+        state.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        state.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        state.access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        break;
+    }
+    return state;
+}
+
+static VkImageUsageFlags usageFlags(RenderGraphUsage usage) {
+    switch (usage) {
+    case RenderGraphUsage::COLOR_ATTACHMENT: return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    case RenderGraphUsage::DEPTH_ATTACHMENT: return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    case RenderGraphUsage::SAMPLED: return VK_IMAGE_USAGE_SAMPLED_BIT;
+    case RenderGraphUsage::TRANSFER_SRC: return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    case RenderGraphUsage::TRANSFER_DST: return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+    return 0;
+}
+
+static VkImageAspectFlags aspectMask(VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_D16_UNORM:
+    case VK_FORMAT_X8_D24_UNORM_PACK32:
+    case VK_FORMAT_D32_SFLOAT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    default:
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+static VkExtent2D scaledExtent(VkExtent2D extent, float scale) {
+    VkExtent2D scaled;
+    scaled.width = SDL_max((uint32_t)((float)extent.width * scale), 1u);
+    scaled.height = SDL_max((uint32_t)((float)extent.height * scale), 1u);
+    return scaled;
+}
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t render_graph_import_backbuffer(RenderGraph& graph, const char* name, VkFormat format, VkImageLayout finalLayout) {
+    RenderGraphImage image;
+    image.name = name;
+    image.format = format;
+    image.imported = true;
+    image.finalLayout = finalLayout;
+    graph.images.push_back(image);
+    graph.backbuffer = (uint32_t)graph.images.size() - 1;
+    return graph.backbuffer;
+}
+
+uint32_t render_graph_create_image(RenderGraph& graph, const char* name, VkFormat format, float scale) {
+    RenderGraphImage image;
+    image.name = name;
+    image.format = format;
+    image.scale = scale;
+    graph.images.push_back(image);
+    return (uint32_t)graph.images.size() - 1;
+}
+
+uint32_t render_graph_add_pass(RenderGraph& graph, const char* name, RenderGraphRecordFn record) {
+    RenderGraphPass pass;
+    pass.name = name;
+    pass.record = record;
+    graph.passes.push_back(pass);
+    return (uint32_t)graph.passes.size() - 1;
+}
+
+static void addUse(RenderGraph& graph, uint32_t pass, uint32_t image, RenderGraphUsage usage,
+                   VkAttachmentLoadOp loadOp, VkClearValue clearValue) {
+    RenderGraphPass& target = graph.passes[pass];
+    if (target.uses.size() >= VSDL_RENDER_GRAPH_MAX_USES) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render graph pass %s uses more than %d images, ignoring %s",
+                     target.name, VSDL_RENDER_GRAPH_MAX_USES, graph.images[image].name);
+        return;
+    }
+    RenderGraphUse use;
+    use.image = image;
+    use.usage = usage;
+    use.loadOp = loadOp;
+    use.clearValue = clearValue;
+    target.uses.push_back(use);
+    graph.images[image].usage |= usageFlags(usage);
+}
+
+void render_graph_color(RenderGraph& graph, uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearValue clearValue) {
+    addUse(graph, pass, image, RenderGraphUsage::COLOR_ATTACHMENT, loadOp, clearValue);
+}
+
+void render_graph_depth(RenderGraph& graph, uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearValue clearValue) {
+    addUse(graph, pass, image, RenderGraphUsage::DEPTH_ATTACHMENT, loadOp, clearValue);
+}
+
+void render_graph_read(RenderGraph& graph, uint32_t pass, uint32_t image, RenderGraphUsage usage) {
+    addUse(graph, pass, image, usage, VK_ATTACHMENT_LOAD_OP_LOAD, VkClearValue{});
+}
+
+void render_graph_write(RenderGraph& graph, uint32_t pass, uint32_t image, RenderGraphUsage usage) {
+    addUse(graph, pass, image, usage, VK_ATTACHMENT_LOAD_OP_DONT_CARE, VkClearValue{});
+}
+
+// Contents nothing reads later are not stored
+static VkAttachmentStoreOp storeOp(const RenderGraph& graph, const RenderGraphUse& use, uint32_t passIndex) {
+    const RenderGraphImage& image = graph.images[use.image];
+    return image.imported || image.lastPass > passIndex ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+}
+
+static bool createRenderPass(VSDL_Context& ctx, RenderGraph& graph, uint32_t passIndex) {
+    RenderGraphPass& pass = graph.passes[passIndex];
+    VkAttachmentDescription attachments[VSDL_RENDER_GRAPH_MAX_USES] = {};
+    VkAttachmentReference colorRefs[VSDL_RENDER_GRAPH_MAX_USES] = {};
+    VkAttachmentReference depthRef = {};
+    uint32_t attachmentCount = 0;
+    uint32_t colorCount = 0;
+    bool hasDepth = false;
+
+    for (const RenderGraphUse& use : pass.uses) {
+        if (!isAttachment(use)) {
+            continue;
+        }
+        const RenderGraphImage& image = graph.images[use.image];
+        // Barriers do every transition, so the render pass starts and ends in the
+        // attachment layout
+        VkImageLayout layout = usageState(use).layout;
+        VkAttachmentDescription& attachment = attachments[attachmentCount];
+        attachment.format = image.format;
+        attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment.loadOp = use.loadOp;
+        attachment.storeOp = storeOp(graph, use, passIndex);
+        attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment.initialLayout = layout;
+        attachment.finalLayout = layout;
+        if (use.usage == RenderGraphUsage::DEPTH_ATTACHMENT) {
+            depthRef = {attachmentCount, layout};
+            hasDepth = true;
+        } else {
+            colorRefs[colorCount++] = {attachmentCount, layout};
+        }
+        attachmentCount++;
+    }
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = colorCount;
+    subpass.pColorAttachments = colorRefs;
+    subpass.pDepthStencilAttachment = hasDepth ? &depthRef : nullptr;
+
+    VkRenderPassCreateInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+    renderPassInfo.attachmentCount = attachmentCount;
+    renderPassInfo.pAttachments = attachments;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+
+    if (vkCreateRenderPass(ctx.device, &renderPassInfo, nullptr, &pass.renderPass) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render pass for %s", pass.name);
+        return false;
+    }
+    return true;
+}
+
+bool render_graph_compile(VSDL_Context& ctx, RenderGraph& graph) {
+    // Walk back from the backbuffer: a pass survives when it writes something a
+    // later pass reads. What it overwrites without reading is not needed before it.
+    std::vector<bool> needed(graph.images.size(), false);
+    if (graph.backbuffer != UINT32_MAX) {
+        needed[graph.backbuffer] = true;
+    }
+    uint32_t culledCount = 0;
+    for (size_t p = graph.passes.size(); p-- > 0;) {
+        RenderGraphPass& pass = graph.passes[p];
+        pass.culled = true;
+        for (const RenderGraphUse& use : pass.uses) {
+            if (writesImage(use) && needed[use.image]) {
+                pass.culled = false;
+            }
+        }
+        if (pass.culled) {
+            SDL_Log("Render graph culled pass %s", pass.name);
+            culledCount++;
+            continue;
+        }
+        for (const RenderGraphUse& use : pass.uses) {
+            if (writesImage(use) && !readsImage(use)) {
+                needed[use.image] = false;
+            }
+        }
+        for (const RenderGraphUse& use : pass.uses) {
+            if (readsImage(use)) {
+                needed[use.image] = true;
+            }
+        }
+    }
+
+    // Lifetimes, and every stage and write transient images see: memory shared
+    // with an aliased image, or last frame's use of the same image, may still
+    // be in any of them when an image's first pass starts
+    VkPipelineStageFlags transientStages = 0;
+    VkAccessFlags transientWrites = 0;
+    for (RenderGraphImage& image : graph.images) {
+        image.firstPass = UINT32_MAX;
+        image.lastPass = 0;
+    }
+    for (uint32_t p = 0; p < graph.passes.size(); p++) {
+        RenderGraphPass& pass = graph.passes[p];
+        pass.graphics = false;
+        pass.backbufferAttachment = false;
+        pass.colorFormats.clear();
+        pass.depthFormat = VK_FORMAT_UNDEFINED;
+        if (pass.culled) {
+            continue;
+        }
+        for (const RenderGraphUse& use : pass.uses) {
+            RenderGraphImage& image = graph.images[use.image];
+            image.firstPass = SDL_min(image.firstPass, p);
+            image.lastPass = SDL_max(image.lastPass, p);
+            if (isAttachment(use)) {
+                pass.graphics = true;
+                pass.backbufferAttachment = pass.backbufferAttachment || image.imported;
+                if (use.usage == RenderGraphUsage::DEPTH_ATTACHMENT) {
+                    pass.depthFormat = image.format;
+                } else {
+                    pass.colorFormats.push_back(image.format);
+                }
+            }
+            if (!image.imported) {
+                UsageState state = usageState(use);
+                transientStages |= state.stages;
+                transientWrites |= state.access & WRITE_ACCESS;
+            }
+        }
+    }
+
+    // Follow each image's state through the passes. A barrier goes in front of a
+    // use that changes the layout or follows or makes a write; reads in the same
+    // layout only widen the stages the next writer has to wait for.
+    std::vector<UsageState> states(graph.images.size());
+    for (size_t i = 0; i < graph.images.size(); i++) {
+        if (graph.images[i].imported) {
+            // The acquire semaphore is waited on at color attachment output
+            states[i].stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        } else {
+            states[i].stages = transientStages;
+            states[i].access = transientWrites;
+        }
+    }
+    graph.barrierCount = 0;
+    for (RenderGraphPass& pass : graph.passes) {
+        pass.barriers.clear();
+        if (pass.culled) {
+            continue;
+        }
+        for (const RenderGraphUse& use : pass.uses) {
+            UsageState next = usageState(use);
+            UsageState& prev = states[use.image];
+            if (prev.layout == VK_IMAGE_LAYOUT_UNDEFINED && readsImage(use)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render graph pass %s reads %s before any pass writes it",
+                             pass.name, graph.images[use.image].name);
+                return false;
+            }
+            if (prev.layout != next.layout || (prev.access & WRITE_ACCESS) || (next.access & WRITE_ACCESS)) {
+                RenderGraphBarrier barrier;
+                barrier.image = use.image;
+                barrier.oldLayout = prev.layout; // UNDEFINED discards: the first use writes from scratch
+                barrier.newLayout = next.layout;
+                barrier.srcStage = prev.stages;
+                barrier.dstStage = next.stages;
+                barrier.srcAccess = prev.access & WRITE_ACCESS;
+                barrier.dstAccess = next.access;
+                pass.barriers.push_back(barrier);
+                prev = next;
+            } else {
+                prev.stages |= next.stages;
+                prev.access |= next.access;
+            }
+        }
+        graph.barrierCount += (uint32_t)pass.barriers.size();
+    }
+
+    graph.finalBarriers.clear();
+    if (graph.backbuffer != UINT32_MAX) {
+        const RenderGraphImage& image = graph.images[graph.backbuffer];
+        const UsageState& last = states[graph.backbuffer];
+        if (last.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render graph never writes %s", image.name);
+            return false;
+        }
+        RenderGraphBarrier barrier;
+        barrier.image = graph.backbuffer;
+        barrier.oldLayout = last.layout;
+        barrier.newLayout = image.finalLayout;
+        barrier.srcStage = last.stages;
+        barrier.srcAccess = last.access & WRITE_ACCESS;
+        if (image.finalLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+            barrier.dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            barrier.dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
+        } else {
+            // Present waits on the submit's semaphore, which covers everything
+            barrier.dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        }
+        graph.finalBarriers.push_back(barrier);
+        graph.barrierCount++;
+    }
+
+    // Dynamic rendering passes name their attachments when they begin instead
+    for (uint32_t p = 0; p < graph.passes.size() && !graph.dynamicRendering; p++) {
+        if (graph.passes[p].graphics && !graph.passes[p].renderPass && !createRenderPass(ctx, graph, p)) {
+            return false;
+        }
+    }
+
+    SDL_Log("Render graph compiled: %zu passes (%u culled), %zu images, %u barriers per frame, %s",
+            graph.passes.size(), culledCount, graph.images.size(), graph.barrierCount,
+            graph.dynamicRendering ? "dynamic rendering" : "render passes");
+    return true;
+}
+
+bool render_graph_create_targets(VSDL_Context& ctx, RenderGraph& graph) {
+    std::vector<uint32_t> transients;
+    std::vector<VkDeviceSize> alignments(graph.images.size(), 1);
+    VkDeviceSize alignment = 1;
+    uint32_t memoryTypeBits = ~0u;
+    graph.unaliasedBytes = 0;
+
+    for (uint32_t i = 0; i < graph.images.size(); i++) {
+        RenderGraphImage& image = graph.images[i];
+        image.extent = scaledExtent(ctx.swapchainExtent, image.scale);
+        if (image.imported || image.firstPass == UINT32_MAX) {
+            continue; // The backbuffer, or only used by culled passes
+        }
+
+        VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = image.format;
+        imageInfo.extent = {image.extent.width, image.extent.height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = image.usage;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vkCreateImage(ctx.device, &imageInfo, nullptr, &image.image) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render graph image %s", image.name);
+            return false;
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(ctx.device, image.image, &requirements);
+        image.size = requirements.size;
+        alignments[i] = requirements.alignment;
+        alignment = SDL_max(alignment, requirements.alignment);
+        memoryTypeBits &= requirements.memoryTypeBits;
+        graph.unaliasedBytes += requirements.size;
+        transients.push_back(i);
+    }
+
+    // Largest first, each at the lowest offset that overlaps no image placed
+    // before it whose lifetime overlaps its own
+    std::sort(transients.begin(), transients.end(), [&graph](uint32_t a, uint32_t b) {
+        return graph.images[a].size > graph.images[b].size;
+    });
+    std::vector<uint32_t> placed;
+    VkDeviceSize totalBytes = 0;
+    for (uint32_t i : transients) {
+        RenderGraphImage& image = graph.images[i];
+        VkDeviceSize offset = 0;
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            for (uint32_t j : placed) {
+                const RenderGraphImage& other = graph.images[j];
+                bool liveTogether = image.firstPass <= other.lastPass && other.firstPass <= image.lastPass;
+                bool overlap = offset < other.offset + other.size && other.offset < offset + image.size;
+                if (liveTogether && overlap) {
+                    offset = alignUp(other.offset + other.size, alignments[i]);
+                    moved = true;
+                }
+            }
+        }
+        image.offset = offset;
+        placed.push_back(i);
+        totalBytes = SDL_max(totalBytes, offset + image.size);
+    }
+
+    if (!transients.empty()) {
+        if (memoryTypeBits == 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render graph transient images share no memory type");
+            return false;
+        }
+        VkMemoryRequirements requirements = {totalBytes, alignment, memoryTypeBits};
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        if (vmaAllocateMemory(ctx.allocator, &requirements, &allocInfo, &graph.memory, nullptr) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate %llu bytes for render graph images",
+                         (unsigned long long)totalBytes);
+            return false;
+        }
+    }
+    graph.memoryBytes = totalBytes;
+
+    for (uint32_t i : transients) {
+        RenderGraphImage& image = graph.images[i];
+        if (vmaBindImageMemory2(ctx.allocator, graph.memory, image.offset, image.image, nullptr) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to bind memory of render graph image %s", image.name);
+            return false;
+        }
+        VkImageViewCreateInfo viewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        viewInfo.image = image.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = image.format;
+        viewInfo.subresourceRange = {aspectMask(image.format), 0, 1, 0, 1};
+        if (vkCreateImageView(ctx.device, &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create view of render graph image %s", image.name);
+            return false;
+        }
+    }
+
+    for (RenderGraphPass& pass : graph.passes) {
+        if (pass.culled || pass.uses.empty()) {
+            continue;
+        }
+        pass.extent = graph.images[pass.uses[0].image].extent;
+        if (!pass.graphics) {
+            continue;
+        }
+
+        for (const RenderGraphUse& use : pass.uses) {
+            const RenderGraphImage& image = graph.images[use.image];
+            if (isAttachment(use) && (image.extent.width != pass.extent.width || image.extent.height != pass.extent.height)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render graph pass %s has attachments of different sizes", pass.name);
+                return false;
+            }
+        }
+        if (graph.dynamicRendering) {
+            continue; // Views are picked when the pass begins; resizes build no framebuffers
+        }
+
+        uint32_t framebufferCount = pass.backbufferAttachment ? (uint32_t)ctx.swapchainImageViews.size() : 1;
+        pass.framebuffers.assign(framebufferCount, VK_NULL_HANDLE);
+        for (uint32_t f = 0; f < framebufferCount; f++) {
+            VkImageView views[VSDL_RENDER_GRAPH_MAX_USES];
+            uint32_t attachmentCount = 0;
+            for (const RenderGraphUse& use : pass.uses) {
+                if (isAttachment(use)) {
+                    const RenderGraphImage& image = graph.images[use.image];
+                    views[attachmentCount++] = image.imported ? ctx.swapchainImageViews[f] : image.view;
+                }
+            }
+            VkFramebufferCreateInfo framebufferInfo = {VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+            framebufferInfo.renderPass = pass.renderPass;
+            framebufferInfo.attachmentCount = attachmentCount;
+            framebufferInfo.pAttachments = views;
+            framebufferInfo.width = pass.extent.width;
+            framebufferInfo.height = pass.extent.height;
+            framebufferInfo.layers = 1;
+            if (vkCreateFramebuffer(ctx.device, &framebufferInfo, nullptr, &pass.framebuffers[f]) != VK_SUCCESS) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create framebuffer %u of %s", f, pass.name);
+                return false;
+            }
+        }
+    }
+
+    SDL_Log("Render graph targets created: %zu transient images in %llu KiB (%llu KiB without aliasing)",
+            transients.size(), (unsigned long long)(graph.memoryBytes / 1024), (unsigned long long)(graph.unaliasedBytes / 1024));
+    return true;
+}
+
+void render_graph_retire_targets(RenderGraph& graph, RetiredSwapchain& retired) {
+    for (RenderGraphPass& pass : graph.passes) {
+        retired.framebuffers.insert(retired.framebuffers.end(), pass.framebuffers.begin(), pass.framebuffers.end());
+        pass.framebuffers.clear();
+    }
+    for (RenderGraphImage& image : graph.images) {
+        if (image.view) {
+            retired.imageViews.push_back(image.view);
+            image.view = VK_NULL_HANDLE;
+        }
+        if (image.image) {
+            retired.images.push_back(image.image);
+            image.image = VK_NULL_HANDLE;
+        }
+    }
+    retired.imageMemory = graph.memory;
+    graph.memory = VK_NULL_HANDLE;
+}
+
+void render_graph_destroy(VSDL_Context& ctx, RenderGraph& graph) {
+    for (RenderGraphPass& pass : graph.passes) {
+        for (VkFramebuffer framebuffer : pass.framebuffers) {
+            if (framebuffer) {
+                vkDestroyFramebuffer(ctx.device, framebuffer, nullptr);
+            }
+        }
+        if (pass.renderPass) {
+            vkDestroyRenderPass(ctx.device, pass.renderPass, nullptr);
+        }
+    }
+    for (RenderGraphImage& image : graph.images) {
+        if (image.view) {
+            vkDestroyImageView(ctx.device, image.view, nullptr);
+        }
+        if (image.image) {
+            vkDestroyImage(ctx.device, image.image, nullptr);
+        }
+    }
+    if (graph.memory) {
+        vmaFreeMemory(ctx.allocator, graph.memory);
+    }
+    graph = RenderGraph{};
+}
+
+VkFramebuffer render_graph_framebuffer(const RenderGraph& graph, uint32_t pass, uint32_t imageIndex) {
+    const std::vector<VkFramebuffer>& framebuffers = graph.passes[pass].framebuffers;
+    if (framebuffers.empty()) {
+        return VK_NULL_HANDLE;
+    }
+    return graph.passes[pass].backbufferAttachment ? framebuffers[imageIndex] : framebuffers[0];
+}
+
+VkImage render_graph_image(const VSDL_Context& ctx, const RenderGraph& graph, uint32_t image) {
+    return graph.images[image].imported ? ctx.swapchainImages[graph.imageIndex] : graph.images[image].image;
+}
+
+static void recordBarriers(const VSDL_Context& ctx, const RenderGraph& graph, VkCommandBuffer commandBuffer,
+                           const std::vector<RenderGraphBarrier>& barriers) {
+    if (barriers.empty()) {
+        return;
+    }
+    VkImageMemoryBarrier imageBarriers[VSDL_RENDER_GRAPH_MAX_USES];
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+    uint32_t count = 0;
+    for (const RenderGraphBarrier& barrier : barriers) {
+        VkImageMemoryBarrier& imageBarrier = imageBarriers[count++];
+        imageBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        imageBarrier.srcAccessMask = barrier.srcAccess;
+        imageBarrier.dstAccessMask = barrier.dstAccess;
+        imageBarrier.oldLayout = barrier.oldLayout;
+        imageBarrier.newLayout = barrier.newLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = render_graph_image(ctx, graph, barrier.image);
+        imageBarrier.subresourceRange = {aspectMask(graph.images[barrier.image].format), 0, 1, 0, 1};
+        srcStages |= barrier.srcStage;
+        dstStages |= barrier.dstStage;
+    }
+    vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr, 0, nullptr, count, imageBarriers);
+}
+
+// Same attachments, operations and layouts as the pass's render pass would have
+static void beginRendering(const VSDL_Context& ctx, const RenderGraph& graph, uint32_t passIndex, VkCommandBuffer commandBuffer) {
+    const RenderGraphPass& pass = graph.passes[passIndex];
+    VkRenderingAttachmentInfo colorAttachments[VSDL_RENDER_GRAPH_MAX_USES];
+    VkRenderingAttachmentInfo depthAttachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
+    uint32_t colorCount = 0;
+    bool hasDepth = false;
+    for (const RenderGraphUse& use : pass.uses) {
+        if (!isAttachment(use)) {
+            continue;
+        }
+        const RenderGraphImage& image = graph.images[use.image];
+        VkRenderingAttachmentInfo attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
+        attachment.imageView = image.imported ? ctx.swapchainImageViews[graph.imageIndex] : image.view;
+        attachment.imageLayout = usageState(use).layout;
+        attachment.loadOp = use.loadOp;
+        attachment.storeOp = storeOp(graph, use, passIndex);
+        attachment.clearValue = use.clearValue;
+        if (use.usage == RenderGraphUsage::DEPTH_ATTACHMENT) {
+            depthAttachment = attachment;
+            hasDepth = true;
+        } else {
+            colorAttachments[colorCount++] = attachment;
+        }
+    }
+
+    VkRenderingInfo renderingInfo = {VK_STRUCTURE_TYPE_RENDERING_INFO};
+    if (pass.contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS) {
+        renderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+    }
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = pass.extent;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = colorCount;
+    renderingInfo.pColorAttachments = colorAttachments;
+    renderingInfo.pDepthAttachment = hasDepth ? &depthAttachment : nullptr;
+    vkCmdBeginRendering(commandBuffer, &renderingInfo);
+}
+
+void render_graph_execute(VSDL_Context& ctx, RenderGraph& graph, VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+    graph.imageIndex = imageIndex;
+    for (uint32_t p = 0; p < graph.passes.size(); p++) {
+        const RenderGraphPass& pass = graph.passes[p];
+        if (pass.culled) {
+            continue;
+        }
+        recordBarriers(ctx, graph, commandBuffer, pass.barriers);
+        uint32_t scope = profiler_begin_scope(ctx.profiler, commandBuffer, pass.name);
+        if (pass.graphics && graph.dynamicRendering) {
+            beginRendering(ctx, graph, p, commandBuffer);
+            if (pass.record) {
+                pass.record(ctx, pass, commandBuffer);
+            }
+            vkCmdEndRendering(commandBuffer);
+        } else if (pass.graphics) {
+            VkClearValue clearValues[VSDL_RENDER_GRAPH_MAX_USES];
+            uint32_t clearCount = 0;
+            for (const RenderGraphUse& use : pass.uses) {
+                if (isAttachment(use)) {
+                    clearValues[clearCount++] = use.clearValue;
+                }
+            }
+            VkRenderPassBeginInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+            renderPassInfo.renderPass = pass.renderPass;
+            renderPassInfo.framebuffer = render_graph_framebuffer(graph, p, imageIndex);
+            renderPassInfo.renderArea.offset = {0, 0};
+            renderPassInfo.renderArea.extent = pass.extent;
+            renderPassInfo.clearValueCount = clearCount;
+            renderPassInfo.pClearValues = clearValues;
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, pass.contents);
+            if (pass.record) {
+                pass.record(ctx, pass, commandBuffer);
+            }
+            vkCmdEndRenderPass(commandBuffer);
+        } else if (pass.record) {
+            pass.record(ctx, pass, commandBuffer);
+        }
+        profiler_end_scope(ctx.profiler, commandBuffer, scope);
+    }
+    recordBarriers(ctx, graph, commandBuffer, graph.finalBarriers);
+}
\ No newline at end of file
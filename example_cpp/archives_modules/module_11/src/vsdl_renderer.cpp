@@ -9,6 +9,16 @@
 #include "vsdl_pipeline.h"
 #include "vsdl_types.h"
 #include "vsdl_mesh.h"
+#include "vsdl_bench.h"
+#include "vsdl_linear_alloc.h"
+#include "vsdl_mesh_arena.h"
+#include "vsdl_batch.h"
+#include "vsdl_upload.h"
+#include "vsdl_headless.h"
+#include "vsdl_zone.h"
+#include "vsdl_frame_pacer.h"
+#include "vsdl_command_cache.h"
+#include "vsdl_render_graph.h"
 
 static VkSurfaceFormatKHR chooseSwapSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
     uint32_t formatCount;
@@ -24,20 +34,6 @@ static VkSurfaceFormatKHR chooseSwapSurfaceFormat(VkPhysicalDevice physicalDevic
     return formats[0];
 }
 
-static VkPresentModeKHR chooseSwapPresentMode(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
-    uint32_t presentModeCount;
-    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr);
-    std::vector<VkPresentModeKHR> presentModes(presentModeCount);
-    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, presentModes.data());
-
-    for (const auto& mode : presentModes) {
-        if (mode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            return mode;
-        }
-    }
-    return VK_PRESENT_MODE_FIFO_KHR;
-}
-
 static VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, SDL_Window* window) {
     if (capabilities.currentExtent.width != UINT32_MAX) {
         return capabilities.currentExtent;
@@ -50,53 +46,206 @@ static VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities,
     return extent;
 }
 
-static void updateUniformBuffer(VSDL_Context& ctx, float posX, float posY, float rotZ) {
-    UniformBufferObject ubo = {};
+// Writes this frame's transform into the uniform ring and returns its dynamic offset
+static bool updateUniformBuffer(VSDL_Context& ctx, float posX, float posY, float rotZ, uint32_t* dynamicOffset) {
+    VSDL_ZONE("update uniforms");
+    VkDeviceSize offset;
+    UniformBufferObject* ubo = static_cast<UniformBufferObject*>(linear_alloc(ctx.uniformRing, sizeof(UniformBufferObject), &offset));
+    if (!ubo) {
+        return false;
+    }
     float cosZ = cosf(rotZ), sinZ = sinf(rotZ);
 
-    ubo.transform[0] = cosZ;   // m00
-    ubo.transform[1] = sinZ;   // m01
-    ubo.transform[2] = 0.0f;   // m02
-    ubo.transform[3] = 0.0f;   // m03
-    ubo.transform[4] = -sinZ;  // m10
-    ubo.transform[5] = cosZ;   // m11
-    ubo.transform[6] = 0.0f;   // m12
-    ubo.transform[7] = 0.0f;   // m13
-    ubo.transform[8] = 0.0f;   // m20
-    ubo.transform[9] = 0.0f;   // m21
-    ubo.transform[10] = 1.0f;  // m22
-    ubo.transform[11] = 0.0f;  // m23
-    ubo.transform[12] = posX;  // m30 (translation X)
-    ubo.transform[13] = posY;  // m31 (translation Y)
-    ubo.transform[14] = 0.0f;  // m32
-    ubo.transform[15] = 1.0f;  // m33
-
-    void* data;
-    vmaMapMemory(ctx.allocator, ctx.uniformBufferAllocation, &data);
-    memcpy(data, &ubo, sizeof(ubo));
-    vmaUnmapMemory(ctx.allocator, ctx.uniformBufferAllocation);
+    ubo->transform[0] = cosZ;   // m00
+    ubo->transform[1] = sinZ;   // m01
+    ubo->transform[2] = 0.0f;   // m02
+    ubo->transform[3] = 0.0f;   // m03
+    ubo->transform[4] = -sinZ;  // m10
+    ubo->transform[5] = cosZ;   // m11
+    ubo->transform[6] = 0.0f;   // m12
+    ubo->transform[7] = 0.0f;   // m13
+    ubo->transform[8] = 0.0f;   // m20
+    ubo->transform[9] = 0.0f;   // m21
+    ubo->transform[10] = 1.0f;  // m22
+    ubo->transform[11] = 0.0f;  // m23
+    ubo->transform[12] = posX;  // m30 (translation X)
+    ubo->transform[13] = posY;  // m31 (translation Y)
+    ubo->transform[14] = 0.0f;  // m32
+    ubo->transform[15] = 1.0f;  // m33
+
+    *dynamicOffset = static_cast<uint32_t>(offset);
+    return true;
 }
 
-static bool recreateSwapchain(VSDL_Context& ctx) {
-    vkDeviceWaitIdle(ctx.device);
+// Render graph targets for the current swapchain images and extent
+static bool createRenderTargets(VSDL_Context& ctx) {
+    if (!render_graph_create_targets(ctx, ctx.renderGraph)) {
+        return false;
+    }
+    // New handles may reuse old values, so compare generations rather than handles
+    command_cache_invalidate(ctx);
+    return true;
+}
+
+// Per-frame inputs of the scene pass
+struct ScenePassFrame {
+    uint32_t uboOffset = 0;
+    const DrawBatches* batches = nullptr;
+    const CachedCommands* cached = nullptr; // --command-cache: executed instead of recording
+    uint32_t drawCalls = 0;
+};
+
+// Pipeline, descriptor set and dynamic state of the scene pass, inline or cached
+static void bindSceneState(VSDL_Context& ctx, VkCommandBuffer commandBuffer, uint32_t uboOffset, VkExtent2D extent) {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx.graphicsPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx.pipelineLayout, 0, 1, &ctx.descriptorSet, 1, &uboOffset);
+
+    VkViewport viewport = {0.0f, 0.0f, (float)extent.width, (float)extent.height, 0.0f, 1.0f};
+    VkRect2D scissor = {{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+static void recordScenePass(VSDL_Context& ctx, const RenderGraphPass& pass, VkCommandBuffer commandBuffer) {
+    ScenePassFrame& scene = *static_cast<ScenePassFrame*>(pass.userData);
+    if (scene.cached) {
+        // Queries cannot be written into a buffer that is executed again, so
+        // the cached path has no "draw batches" scope
+        vkCmdExecuteCommands(commandBuffer, 1, &scene.cached->commandBuffer);
+        scene.drawCalls = scene.cached->drawCalls;
+        return;
+    }
+    bindSceneState(ctx, commandBuffer, scene.uboOffset, pass.extent);
+    uint32_t drawScope = profiler_begin_scope(ctx.profiler, commandBuffer, "draw batches");
+    scene.drawCalls = record_draw_batches(ctx, commandBuffer, *scene.batches);
+    profiler_end_scope(ctx.profiler, commandBuffer, drawScope);
+}
+
+// Stretches the scene image over the backbuffer (--render-scale)
+static void recordUpscalePass(VSDL_Context& ctx, const RenderGraphPass& pass, VkCommandBuffer commandBuffer) {
+    const RenderGraph& graph = ctx.renderGraph;
+    const RenderGraphImage& src = graph.images[pass.uses[0].image];
+    const RenderGraphImage& dst = graph.images[pass.uses[1].image];
+    VkImageBlit region = {};
+    region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.srcOffsets[1] = {(int32_t)src.extent.width, (int32_t)src.extent.height, 1};
+    region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.dstOffsets[1] = {(int32_t)dst.extent.width, (int32_t)dst.extent.height, 1};
+    vkCmdBlitImage(commandBuffer, render_graph_image(ctx, graph, pass.uses[0].image), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   render_graph_image(ctx, graph, pass.uses[1].image), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region,
+                   ctx.features.linearBlit ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+}
 
-    for (auto& fb : ctx.framebuffers) {
+// Declares the frame's passes and compiles the graph. Needs only the backbuffer
+// format, and has to run before create_pipeline, which uses the scene pass's
+// render pass or attachment formats.
+static bool buildRenderGraph(VSDL_Context& ctx, uint32_t* scenePass) {
+    RenderGraph& graph = ctx.renderGraph;
+    graph.dynamicRendering = ctx.features.dynamicRendering;
+    // Headless images are copied out for readback instead of presented
+    uint32_t backbuffer = render_graph_import_backbuffer(graph, "backbuffer", ctx.swapchainImageFormat,
+                                                         ctx.options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+    *scenePass = render_graph_add_pass(graph, "main pass", recordScenePass);
+
+    if (ctx.options.renderScale < 1.0f) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(ctx.physicalDevice, ctx.swapchainImageFormat, &properties);
+        VkFormatFeatureFlags blit = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+        if ((properties.optimalTilingFeatures & blit) != blit) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Backbuffer format %d cannot be blitted, --render-scale needs it",
+                         ctx.swapchainImageFormat);
+            return false;
+        }
+        ctx.features.linearBlit = (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+
+        uint32_t sceneColor = render_graph_create_image(graph, "scene color", ctx.swapchainImageFormat, ctx.options.renderScale);
+        render_graph_color(graph, *scenePass, sceneColor, VK_ATTACHMENT_LOAD_OP_CLEAR, clearColor);
+        uint32_t upscale = render_graph_add_pass(graph, "upscale", recordUpscalePass);
+        render_graph_read(graph, upscale, sceneColor, RenderGraphUsage::TRANSFER_SRC);
+        render_graph_write(graph, upscale, backbuffer, RenderGraphUsage::TRANSFER_DST);
+    } else {
+        render_graph_color(graph, *scenePass, backbuffer, VK_ATTACHMENT_LOAD_OP_CLEAR, clearColor);
+    }
+
+    if (!render_graph_compile(ctx, graph)) {
+        return false;
+    }
+    ctx.scenePass = *scenePass;
+    return true;
+}
+
+static void destroyRetiredSwapchain(VSDL_Context& ctx, RetiredSwapchain& retired) {
+    for (auto& fb : retired.framebuffers) {
         vkDestroyFramebuffer(ctx.device, fb, nullptr);
     }
-    ctx.framebuffers.clear();
-    for (auto& view : ctx.swapchainImageViews) {
+    for (auto& view : retired.imageViews) {
         vkDestroyImageView(ctx.device, view, nullptr);
     }
-    ctx.swapchainImageViews.clear();
-    vkDestroySwapchainKHR(ctx.device, ctx.swapchain, nullptr);
+    for (auto& image : retired.images) {
+        vkDestroyImage(ctx.device, image, nullptr);
+    }
+    if (retired.imageMemory) {
+        vmaFreeMemory(ctx.allocator, retired.imageMemory);
+    }
+    for (auto& semaphore : retired.renderFinishedSemaphores) {
+        vkDestroySemaphore(ctx.device, semaphore, nullptr);
+    }
+    if (retired.swapchain) {
+        vkDestroySwapchainKHR(ctx.device, retired.swapchain, nullptr);
+    }
+}
+
+// Frees swapchains whose last frame has completed; all = true after vkDeviceWaitIdle.
+// Without VK_EXT_swapchain_maintenance1 there is no present fence, so the fence
+// of the last frame submitted against the old swapchain stands in for it.
+static void collectRetiredSwapchains(VSDL_Context& ctx, bool all) {
+    size_t kept = 0;
+    for (size_t i = 0; i < ctx.retiredSwapchains.size(); i++) {
+        RetiredSwapchain& retired = ctx.retiredSwapchains[i];
+        if (all || retired.retireFrame <= ctx.completedFrameNumber) {
+            destroyRetiredSwapchain(ctx, retired);
+        } else {
+            if (kept != i) {
+                ctx.retiredSwapchains[kept] = std::move(retired);
+            }
+            kept++;
+        }
+    }
+    ctx.retiredSwapchains.resize(kept);
+}
+
+static bool recreateSwapchain(VSDL_Context& ctx) {
+    VSDL_ZONE("recreate swapchain");
+    // No device wait: the old swapchain is handed to the driver through
+    // oldSwapchain, and everything that frames in flight may still touch is
+    // retired until those frames' fences have signaled.
+    VkSwapchainKHR oldSwapchain = ctx.swapchain;
+    if (oldSwapchain) {
+        RetiredSwapchain retired;
+        retired.swapchain = oldSwapchain;
+        retired.imageViews.swap(ctx.swapchainImageViews);
+        render_graph_retire_targets(ctx.renderGraph, retired);
+        retired.renderFinishedSemaphores.swap(ctx.renderFinishedSemaphores);
+        retired.retireFrame = ctx.frameNumber;
+        ctx.retiredSwapchains.push_back(std::move(retired));
+        ctx.swapchain = VK_NULL_HANDLE;
+    }
 
     VkSurfaceCapabilitiesKHR capabilities;
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(ctx.physicalDevice, ctx.surface, &capabilities);
 
     VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(ctx.physicalDevice, ctx.surface);
-    VkPresentModeKHR presentMode = chooseSwapPresentMode(ctx.physicalDevice, ctx.surface);
+    VkPresentModeKHR presentMode = frame_pacer_choose_present_mode(ctx.pacer, ctx.physicalDevice, ctx.surface);
     VkExtent2D extent = chooseSwapExtent(capabilities, ctx.window);
 
+    // Whatever the render graph does to the backbuffer: attachment, blit target
+    VkImageUsageFlags imageUsage = ctx.renderGraph.images[ctx.renderGraph.backbuffer].usage;
+    if ((capabilities.supportedUsageFlags & imageUsage) != imageUsage) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Swapchain images do not support usage 0x%x", imageUsage);
+        return false;
+    }
+
     uint32_t imageCount = capabilities.minImageCount + 1;
     if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
         imageCount = capabilities.maxImageCount;
@@ -109,13 +258,13 @@ static bool recreateSwapchain(VSDL_Context& ctx) {
     swapchainInfo.imageColorSpace = surfaceFormat.colorSpace;
     swapchainInfo.imageExtent = extent;
     swapchainInfo.imageArrayLayers = 1;
-    swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    swapchainInfo.imageUsage = imageUsage;
     swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     swapchainInfo.preTransform = capabilities.currentTransform;
     swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     swapchainInfo.presentMode = presentMode;
     swapchainInfo.clipped = VK_TRUE;
-    swapchainInfo.oldSwapchain = VK_NULL_HANDLE;
+    swapchainInfo.oldSwapchain = oldSwapchain;
 
     if (vkCreateSwapchainKHR(ctx.device, &swapchainInfo, nullptr, &ctx.swapchain) != VK_SUCCESS) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate swapchain");
@@ -153,31 +302,100 @@ static bool recreateSwapchain(VSDL_Context& ctx) {
     }
     SDL_Log("Swapchain image views recreated (count: %u)", swapchainImageCount);
 
-    ctx.framebuffers.resize(swapchainImageCount);
+    if (!createRenderTargets(ctx)) {
+        return false;
+    }
+
+    // Render-finished semaphores are indexed by swapchain image: presentation
+    // holds them until the image is re-acquired, not until a frame slot recycles.
+    // The old set may still be waited on by pending presents, so it was retired.
+    ctx.renderFinishedSemaphores.assign(swapchainImageCount, VK_NULL_HANDLE);
+    VkSemaphoreCreateInfo semaphoreInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
     for (size_t i = 0; i < swapchainImageCount; i++) {
-        VkImageView attachments[] = {ctx.swapchainImageViews[i]};
-        VkFramebufferCreateInfo framebufferInfo = {VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
-        framebufferInfo.renderPass = ctx.renderPass;
-        framebufferInfo.attachmentCount = 1;
-        framebufferInfo.pAttachments = attachments;
-        framebufferInfo.width = ctx.swapchainExtent.width;
-        framebufferInfo.height = ctx.swapchainExtent.height;
-        framebufferInfo.layers = 1;
-
-        if (vkCreateFramebuffer(ctx.device, &framebufferInfo, nullptr, &ctx.framebuffers[i]) != VK_SUCCESS) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate framebuffer %zu", i);
+        if (vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &ctx.renderFinishedSemaphores[i]) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render finished semaphore %zu", i);
             return false;
         }
     }
-    SDL_Log("Framebuffers recreated (count: %zu)", ctx.framebuffers.size());
 
     return true;
 }
 
+static bool createFrameResources(VSDL_Context& ctx) {
+    VkSemaphoreCreateInfo semaphoreInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (uint32_t i = 0; i < ctx.options.framesInFlight; i++) {
+        FrameData& frame = ctx.frames[i];
+
+        VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        poolInfo.queueFamilyIndex = ctx.graphicsFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        if (vkCreateCommandPool(ctx.device, &poolInfo, nullptr, &frame.commandPool) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create command pool for frame %u", i);
+            return false;
+        }
+
+        VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocInfo.commandPool = frame.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(ctx.device, &allocInfo, &frame.commandBuffer) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate command buffer for frame %u", i);
+            return false;
+        }
+
+        if (vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &frame.imageAvailableSemaphore) != VK_SUCCESS ||
+            vkCreateFence(ctx.device, &fenceInfo, nullptr, &frame.inFlightFence) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create synchronization objects for frame %u", i);
+            return false;
+        }
+    }
+    SDL_Log("Frame resources created (frames in flight: %u)", ctx.options.framesInFlight);
+    return true;
+}
+
+static void destroyFrameResources(VSDL_Context& ctx) {
+    for (uint32_t i = 0; i < VSDL_MAX_FRAMES_IN_FLIGHT; i++) {
+        FrameData& frame = ctx.frames[i];
+        if (frame.inFlightFence) {
+            vkDestroyFence(ctx.device, frame.inFlightFence, nullptr);
+        }
+        if (frame.imageAvailableSemaphore) {
+            vkDestroySemaphore(ctx.device, frame.imageAvailableSemaphore, nullptr);
+        }
+        if (frame.commandPool) {
+            vkDestroyCommandPool(ctx.device, frame.commandPool, nullptr); // Frees frame.commandBuffer
+        }
+        frame = FrameData{};
+    }
+    for (auto& semaphore : ctx.renderFinishedSemaphores) {
+        vkDestroySemaphore(ctx.device, semaphore, nullptr);
+    }
+    ctx.renderFinishedSemaphores.clear();
+    SDL_Log("Frame resources destroyed");
+}
+
+// Runs on every exit of vsdl_render_loop, the early error returns included:
+// waits for the GPU, then frees retired swapchains, what the loop created
+// for its frames and the command cache
+struct RenderLoopCleanup {
+    VSDL_Context& ctx;
+    ~RenderLoopCleanup() {
+        vkDeviceWaitIdle(ctx.device);
+        collectRetiredSwapchains(ctx, true);
+        destroyFrameResources(ctx);
+        command_cache_destroy(ctx);
+    }
+};
+
 bool vsdl_render_loop(VSDL_Context& ctx) {
   SDL_Log("Starting render loop");
+  RenderLoopCleanup cleanup{ctx};
 
-  if (!SDL_Vulkan_CreateSurface(ctx.window, ctx.instance, nullptr, &ctx.surface)) {
+  if (!ctx.options.headless &&
+      !SDL_Vulkan_CreateSurface(ctx.window, ctx.instance, nullptr, &ctx.surface)) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create Vulkan surface: %s", SDL_GetError());
       return false;
   }
@@ -188,280 +406,451 @@ bool vsdl_render_loop(VSDL_Context& ctx) {
 
   if (vkCreateCommandPool(ctx.device, &poolInfo, nullptr, &ctx.commandPool) != VK_SUCCESS) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create command pool");
-      vkDestroySurfaceKHR(ctx.instance, ctx.surface, nullptr);
       return false;
   }
   SDL_Log("Command pool created");
 
-  VkSurfaceCapabilitiesKHR capabilities;
-  vkGetPhysicalDeviceSurfaceCapabilitiesKHR(ctx.physicalDevice, ctx.surface, &capabilities);
-  VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(ctx.physicalDevice, ctx.surface);
-  VkPresentModeKHR presentMode = chooseSwapPresentMode(ctx.physicalDevice, ctx.surface);
-  VkExtent2D extent = chooseSwapExtent(capabilities, ctx.window);
+  // Before the first swapchain: the pacing mode decides its present mode
+  frame_pacer_init(ctx.pacer, ctx.options.pacing, ctx.options.fpsCap, ctx.options.allowTearing,
+                   ctx.features.presentWait, ctx.window);
 
-  uint32_t imageCount = capabilities.minImageCount + 1;
-  if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
-      imageCount = capabilities.maxImageCount;
+  // The render graph only needs the color format; the swapchain itself is
+  // built once the pipeline exists, by the same path that handles resizes.
+  if (ctx.options.headless) {
+      if (!headless_create(ctx)) {
+          return false;
+      }
+  } else {
+      ctx.swapchainImageFormat = chooseSwapSurfaceFormat(ctx.physicalDevice, ctx.surface).format;
   }
 
-  VkSwapchainCreateInfoKHR swapchainInfo = {VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR};
-  swapchainInfo.surface = ctx.surface;
-  swapchainInfo.minImageCount = imageCount;
-  swapchainInfo.imageFormat = surfaceFormat.format;
-  swapchainInfo.imageColorSpace = surfaceFormat.colorSpace;
-  swapchainInfo.imageExtent = extent;
-  swapchainInfo.imageArrayLayers = 1;
-  swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-  swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-  swapchainInfo.preTransform = capabilities.currentTransform;
-  swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-  swapchainInfo.presentMode = presentMode;
-  swapchainInfo.clipped = VK_TRUE;
-  swapchainInfo.oldSwapchain = VK_NULL_HANDLE;
-
-  if (vkCreateSwapchainKHR(ctx.device, &swapchainInfo, nullptr, &ctx.swapchain) != VK_SUCCESS) {
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create swapchain");
-      vkDestroyCommandPool(ctx.device, ctx.commandPool, nullptr);
-      vkDestroySurfaceKHR(ctx.instance, ctx.surface, nullptr);
+  uint32_t scenePass = 0;
+  if (!buildRenderGraph(ctx, &scenePass)) {
       return false;
   }
-  SDL_Log("Swapchain created");
-
-  uint32_t swapchainImageCount;
-  vkGetSwapchainImagesKHR(ctx.device, ctx.swapchain, &swapchainImageCount, nullptr);
-  ctx.swapchainImages.resize(swapchainImageCount);
-  vkGetSwapchainImagesKHR(ctx.device, ctx.swapchain, &swapchainImageCount, ctx.swapchainImages.data());
-  ctx.swapchainImageFormat = surfaceFormat.format;
-  ctx.swapchainExtent = extent;
-
-  ctx.swapchainImageViews.resize(swapchainImageCount);
-  for (size_t i = 0; i < swapchainImageCount; i++) {
-      VkImageViewCreateInfo viewInfo = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
-      viewInfo.image = ctx.swapchainImages[i];
-      viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-      viewInfo.format = ctx.swapchainImageFormat;
-      viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-      viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-      viewInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-      viewInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-      viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-      viewInfo.subresourceRange.baseMipLevel = 0;
-      viewInfo.subresourceRange.levelCount = 1;
-      viewInfo.subresourceRange.baseArrayLayer = 0;
-      viewInfo.subresourceRange.layerCount = 1;
-
-      if (vkCreateImageView(ctx.device, &viewInfo, nullptr, &ctx.swapchainImageViews[i]) != VK_SUCCESS) {
-          SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create image view %zu", i);
-          return false;
-      }
-  }
-  SDL_Log("Swapchain image views created (count: %u)", swapchainImageCount);
 
   if (!create_pipeline(ctx)) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create pipeline");
     return false;
   }
 
-  if (!recreateSwapchain(ctx)) {
+  if (ctx.options.headless) {
+      if (!createRenderTargets(ctx)) {
+          return false;
+      }
+  } else if (!recreateSwapchain(ctx)) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create initial swapchain and framebuffers");
       return false;
   }
 
-  VkSemaphoreCreateInfo semaphoreInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
-  VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-  fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-  if (vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &ctx.imageAvailableSemaphore) != VK_SUCCESS ||
-      vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &ctx.renderFinishedSemaphore) != VK_SUCCESS ||
-      vkCreateFence(ctx.device, &fenceInfo, nullptr, &ctx.frameFence) != VK_SUCCESS) {
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create synchronization objects");
+  if (!createFrameResources(ctx)) {
       return false;
   }
-  SDL_Log("Synchronization objects created");
 
-  VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
-  allocInfo.commandPool = ctx.commandPool;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandBufferCount = 1;
+  if (ctx.options.commandCache && !command_cache_create(ctx)) {
+      return false;
+  }
 
-  VkCommandBuffer commandBuffer;
-  if (vkAllocateCommandBuffers(ctx.device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
-      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate command buffer");
+  if (!profiler_create(ctx.profiler, ctx.physicalDevice, ctx.device, ctx.graphicsFamily,
+                       ctx.features.pipelineStatisticsQuery)) {
       return false;
   }
+  ctx.profiler.tracing = ctx.options.profileTracePath != nullptr;
+
+  // Benchmark instances fill a grid over the viewport, alternating triangles and planes
+  if (ctx.options.benchMeshes > 0) {
+      uint32_t side = (uint32_t)SDL_ceil(SDL_sqrt((double)ctx.options.benchMeshes));
+      float cell = 2.0f / (float)side;
+      for (uint32_t i = 0; i < ctx.options.benchMeshes; i++) {
+          MeshType type = (i % 2 == 0) ? MeshType::TRIANGLE : MeshType::PLANE;
+          float x = -1.0f + cell * ((float)(i % side) + 0.5f);
+          float y = -1.0f + cell * ((float)(i / side) + 0.5f);
+          if (!add_mesh_instance(ctx, type, x, y, cell, (float)i * 0.1f)) {
+              break;
+          }
+      }
+      SDL_Log("Spawned %zu benchmark instances", ctx.meshes.size());
+  }
 
-  SDL_ShowWindow(ctx.window);
+  if (ctx.window) {
+      SDL_ShowWindow(ctx.window);
+  }
 
   float posX = 0.0f, posY = 0.0f;
   float rotZ = 0.0f;
   const float moveSpeed = 0.01f;
   const float rotSpeed = 0.02f;
   bool swapchainNeedsRecreate = false;
+  uint32_t resizeEvents = 0; // Resize events coalesced into the next rebuild
+
+  // Benchmark bookkeeping: CPU time between consecutive presents, and how much
+  // of it was spent blocked on the frame slot's fence.
+  std::vector<double> frameTimesMs;
+  std::vector<double> fenceWaitMs;
+  std::vector<double> recordMs; // Batch building plus command recording
+  std::vector<double> rebuildMs; // recreateSwapchain calls during the measured frames
+  std::vector<double> gpuFrameMs; // Resolved from timestamps a few frames after submission
+  uint32_t benchResizeCount = 0;
+  uint32_t benchResizeEvents = 0;
+  uint32_t drawCalls = 0;
+  if (ctx.options.benchFrames > 0) {
+      frameTimesMs.reserve(ctx.options.benchFrames);
+      fenceWaitMs.reserve(ctx.options.benchFrames);
+      recordMs.reserve(ctx.options.benchFrames);
+  }
+  const double ticksToMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+  Uint64 lastPresentTicks = SDL_GetPerformanceCounter();
+  uint32_t warmupFrames = ctx.options.benchFrames > 0 ? ctx.options.framesInFlight + 2 : 0;
+  uint32_t lastImageIndex = UINT32_MAX; // Headless readback source
+  ScenePassFrame sceneFrame;
+  ctx.renderGraph.passes[scenePass].userData = &sceneFrame;
 
   bool running = true;
   SDL_Event event;
   SDL_Log("Entering render loop");
   while (running) {
-      SDL_Log("Polling events");
-      while (SDL_PollEvent(&event)) {
-          if (event.type == SDL_EVENT_QUIT) {
-              SDL_Log("Quit event received");
-              running = false;
+      VSDL_ZONE("frame");
+      // Resize storm: a burst of window size changes every measured frame,
+      // delivered as events that the rebuild below has to coalesce
+      if (ctx.window && ctx.options.benchResizeBurst > 0 && ctx.options.benchFrames > 0 && warmupFrames == 0) {
+          for (uint32_t i = 0; i < ctx.options.benchResizeBurst; i++) {
+              benchResizeCount++;
+              int step = (int)(benchResizeCount % 16);
+              SDL_SetWindowSize(ctx.window, 640 + step * 20, 480 + step * 15);
           }
-          if (event.type == SDL_EVENT_WINDOW_RESIZED || event.type == SDL_EVENT_WINDOW_MAXIMIZED || event.type == SDL_EVENT_WINDOW_RESTORED) {
-              SDL_Log("Window resize event: %dx%d", event.window.data1, event.window.data2);
-              swapchainNeedsRecreate = true;
-          }
-          if (event.type == SDL_EVENT_KEY_DOWN) {
-              switch (event.key.key) {
-                  case SDLK_W: posY += moveSpeed; break;
-                  case SDLK_S: posY -= moveSpeed; break;
-                  case SDLK_A: posX -= moveSpeed; break;
-                  case SDLK_D: posX += moveSpeed; break;
-                  case SDLK_5: rotZ += rotSpeed; break;
-                  case SDLK_6: rotZ -= rotSpeed; break;
-                  case SDLK_1: create_triangle_buffer(ctx); break;
-                  case SDLK_2: destroy_mesh(ctx); break;
-                  case SDLK_3: create_plane_buffer(ctx); break;
-                  case SDLK_4: destroy_mesh(ctx); break;
+      }
+
+      // Wait here rather than after present, so the input polled below is as
+      // fresh as possible when the frame reaches the screen
+      Uint64 inputTicks;
+      {
+          VSDL_ZONE("pace");
+          ctx.pacer.recording = ctx.options.benchFrames > 0 && warmupFrames == 0;
+          inputTicks = frame_pacer_begin_frame(ctx.pacer, ctx.device, ctx.swapchain);
+      }
+
+      {
+          VSDL_ZONE("poll events");
+          while (SDL_PollEvent(&event)) {
+              if (event.type == SDL_EVENT_QUIT) {
+                  SDL_Log("Quit event received");
+                  running = false;
+              }
+              if (event.type == SDL_EVENT_WINDOW_RESIZED || event.type == SDL_EVENT_WINDOW_MAXIMIZED || event.type == SDL_EVENT_WINDOW_RESTORED) {
+                  resizeEvents++;
+                  swapchainNeedsRecreate = true;
+              }
+              if (event.type == SDL_EVENT_KEY_DOWN) {
+                  switch (event.key.key) {
+                      case SDLK_W: posY += moveSpeed; break;
+                      case SDLK_S: posY -= moveSpeed; break;
+                      case SDLK_A: posX -= moveSpeed; break;
+                      case SDLK_D: posX += moveSpeed; break;
+                      case SDLK_5: rotZ += rotSpeed; break;
+                      case SDLK_6: rotZ -= rotSpeed; break;
+                      case SDLK_1: create_triangle_instance(ctx); break;
+                      case SDLK_2: destroy_mesh_instance(ctx); break;
+                      case SDLK_3: create_plane_instance(ctx); break;
+                      case SDLK_4: destroy_mesh_instance(ctx); break;
+                  }
               }
           }
       }
 
-      int width, height;
-      SDL_GetWindowSize(ctx.window, &width, &height);
-      if (width == 0 || height == 0) {
+      int width = 0, height = 0;
+      if (ctx.window) {
+          SDL_GetWindowSize(ctx.window, &width, &height);
+      }
+      if (ctx.window && (width == 0 || height == 0)) {
           SDL_Log("Window minimized, skipping frame");
           SDL_Delay(100);
           continue;
       }
 
+      // However many resize events arrived, rebuild at most once per frame
       if (swapchainNeedsRecreate) {
-          SDL_Log("Recreating swapchain");
+          if (ctx.options.benchResizeBurst == 0) {
+              SDL_Log("Recreating swapchain (%u resize events coalesced)", resizeEvents);
+          }
+          Uint64 rebuildStart = SDL_GetPerformanceCounter();
           if (!recreateSwapchain(ctx)) {
               SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Swapchain recreation failed");
               running = false;
               continue;
           }
+          if (ctx.options.benchFrames > 0 && warmupFrames == 0) {
+              rebuildMs.push_back((SDL_GetPerformanceCounter() - rebuildStart) * ticksToMs);
+              benchResizeEvents += resizeEvents;
+          }
           swapchainNeedsRecreate = false;
+          resizeEvents = 0;
       }
 
-      updateUniformBuffer(ctx, posX, posY, rotZ);
+      FrameData& frame = ctx.frames[ctx.currentFrame];
 
-      SDL_Log("Acquiring next image");
-      vkWaitForFences(ctx.device, 1, &ctx.frameFence, VK_TRUE, UINT64_MAX);
-      vkResetFences(ctx.device, 1, &ctx.frameFence);
+      // Only block until this slot's previous submission is done; the other
+      // slots keep the GPU busy while we record.
+      Uint64 fenceWaitStart = SDL_GetPerformanceCounter();
+      {
+          VSDL_ZONE("fence wait");
+          vkWaitForFences(ctx.device, 1, &frame.inFlightFence, VK_TRUE, UINT64_MAX);
+      }
+      Uint64 fenceWaitEnd = SDL_GetPerformanceCounter();
+      profiler_cpu_event(ctx.profiler, "fence wait", fenceWaitStart, fenceWaitEnd);
+      // Submissions retire in order, so everything up to this slot's frame is done
+      if (frame.submittedFrameNumber > ctx.completedFrameNumber) {
+          ctx.completedFrameNumber = frame.submittedFrameNumber;
+      }
+      collectRetiredSwapchains(ctx, false);
 
       uint32_t imageIndex;
-      VkResult result = vkAcquireNextImageKHR(ctx.device, ctx.swapchain, UINT64_MAX, ctx.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
-      if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-          SDL_Log("Swapchain out of date or suboptimal");
+      VkResult result = VK_SUCCESS;
+      {
+          VSDL_ZONE("acquire");
+          if (ctx.options.headless) {
+              imageIndex = headless_acquire(ctx);
+          } else {
+              result = vkAcquireNextImageKHR(ctx.device, ctx.swapchain, UINT64_MAX, frame.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+          }
+      }
+      if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+          SDL_Log("Swapchain out of date");
           swapchainNeedsRecreate = true;
           continue;
       }
-      if (result != VK_SUCCESS) {
+      if (result == VK_SUBOPTIMAL_KHR) {
+          // The semaphore is signaled, so render this frame and rebuild afterwards
+          swapchainNeedsRecreate = true;
+      } else if (result != VK_SUCCESS) {
           SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire swapchain image: %d", result);
           running = false;
           continue;
-    }
+      }
 
-    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+      // Reset only once we know work will be submitted with this fence
+      vkResetFences(ctx.device, 1, &frame.inFlightFence);
 
-    VkRenderPassBeginInfo renderPassInfo = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-    renderPassInfo.renderPass = ctx.renderPass;
-    renderPassInfo.framebuffer = ctx.framebuffers[imageIndex];
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = ctx.swapchainExtent;
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-    renderPassInfo.clearValueCount = 1;
-    renderPassInfo.pClearValues = &clearColor;
+      // The fence above guarantees the GPU is done with this slot's ring regions
+      linear_alloc_begin_frame(ctx.uniformRing, ctx.currentFrame);
+      linear_alloc_begin_frame(ctx.instanceRing, ctx.currentFrame);
+      uint32_t uboOffset = 0;
+      if (!updateUniformBuffer(ctx, posX, posY, rotZ, &uboOffset)) {
+          running = false;
+          continue;
+      }
+      linear_alloc_flush(ctx, ctx.uniformRing);
+
+      Uint64 recordStart = SDL_GetPerformanceCounter();
+      // The uniform block is the first allocation of the slot's region, so its
+      // offset, and every batch offset behind it, repeats while the scene holds
+      VkFramebuffer sceneFramebuffer = render_graph_framebuffer(ctx.renderGraph, scenePass, imageIndex);
+      CachedCommands* cached = nullptr;
+      if (ctx.commandCache.pool) {
+          cached = &command_cache_entry(ctx, ctx.currentFrame, imageIndex);
+          if (!cached->commandBuffer) {
+              running = false;
+              continue;
+          }
+      }
+      bool reuseCached = cached && command_cache_valid(ctx, *cached, uboOffset, sceneFramebuffer);
+      DrawBatches batches;
+      if (!reuseCached) {
+          if (!build_draw_batches(ctx, batches)) {
+              running = false;
+              continue;
+          }
+          linear_alloc_flush(ctx, ctx.instanceRing);
+      }
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx.graphicsPipeline);
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx.pipelineLayout, 0, 1, &ctx.descriptorSet, 0, nullptr);
+      if (reuseCached) {
+          ctx.commandCache.reuses++;
+      } else if (cached) {
+          VSDL_ZONE("record cached");
+          if (!command_cache_begin(ctx, *cached, uboOffset, sceneFramebuffer)) {
+              running = false;
+              continue;
+          }
+          bindSceneState(ctx, cached->commandBuffer, uboOffset, ctx.renderGraph.passes[scenePass].extent);
+          uint32_t cachedDrawCalls = record_draw_batches(ctx, cached->commandBuffer, batches);
+          if (!command_cache_end(ctx, *cached, cachedDrawCalls)) {
+              running = false;
+              continue;
+          }
+      }
 
-    VkViewport viewport = {0.0f, 0.0f, (float)ctx.swapchainExtent.width, (float)ctx.swapchainExtent.height, 0.0f, 1.0f};
-    VkRect2D scissor = {{0, 0}, ctx.swapchainExtent};
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+      vkResetCommandPool(ctx.device, frame.commandPool, 0);
+      VkCommandBuffer commandBuffer = frame.commandBuffer;
 
-    VkDeviceSize offsets[] = {0};
-    for (const auto& mesh : ctx.meshes) {
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mesh.vertexBuffer, offsets);
-        if (mesh.indexCount > 0) {
-            vkCmdBindIndexBuffer(commandBuffer, mesh.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-            vkCmdDrawIndexed(commandBuffer, mesh.indexCount, 1, 0, 0, 0);
-        } else {
-            vkCmdDraw(commandBuffer, 3, 1, 0, 0);
-        }
-    }
+      VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(commandBuffer, &beginInfo);
+      profiler_begin_frame(ctx.profiler, commandBuffer);
+      if (ctx.profiler.resolved && ctx.options.benchFrames > 0 && warmupFrames == 0) {
+          gpuFrameMs.push_back(ctx.profiler.lastGpuMs);
+      }
+      if (!cached) {
+          profiler_begin_stats(ctx.profiler, commandBuffer); // Would need inherited queries with secondaries
+      }
 
-    vkCmdEndRenderPass(commandBuffer);
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = &ctx.imageAvailableSemaphore;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = &ctx.renderFinishedSemaphore;
-
-    if (vkQueueSubmit(ctx.graphicsQueue, 1, &submitInfo, ctx.frameFence) != VK_SUCCESS) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit draw command buffer");
-        running = false;
-        continue;
-    }
+      // Barriers, layout transitions and the render passes all come from the graph
+      sceneFrame.uboOffset = uboOffset;
+      sceneFrame.batches = &batches;
+      sceneFrame.cached = cached;
+      ctx.renderGraph.passes[scenePass].contents = cached ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+      render_graph_execute(ctx, ctx.renderGraph, commandBuffer, imageIndex);
+      drawCalls = sceneFrame.drawCalls;
 
-    VkPresentInfoKHR presentInfo = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = &ctx.renderFinishedSemaphore;
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = &ctx.swapchain;
-    presentInfo.pImageIndices = &imageIndex;
-
-    result = vkQueuePresentKHR(ctx.graphicsQueue, &presentInfo);
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-        SDL_Log("Swapchain out of date after present");
-        swapchainNeedsRecreate = true;
-    } else if (result != VK_SUCCESS) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to present queue: %d", result);
-        running = false;
-    }
-    SDL_Log("Frame rendered");
+      if (!cached) {
+          profiler_end_stats(ctx.profiler, commandBuffer);
+      }
+      vkEndCommandBuffer(commandBuffer);
+      Uint64 recordEnd = SDL_GetPerformanceCounter();
+      profiler_cpu_event(ctx.profiler, "record", recordStart, recordEnd);
+
+      // Submit uploads queued since the last frame as one transfer batch. The
+      // draw waits on the upload timeline instead of the transfer queue idling.
+      uint64_t uploadValue = 0;
+      if (!upload_flush(ctx, &uploadValue)) {
+          running = false;
+          continue;
+      }
+      VkSemaphore waitSemaphores[] = {frame.imageAvailableSemaphore, ctx.upload.timeline};
+      VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                           VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT};
+      uint64_t waitValues[] = {0, uploadValue}; // Binary semaphores ignore their value
+      uint32_t waitCount = uploadValue > ctx.upload.graphicsWaitValue ? 2 : 1;
+      ctx.upload.graphicsWaitValue = uploadValue;
+      // Headless frames acquire nothing and present nothing, so they skip the
+      // binary semaphores and keep only the upload timeline wait
+      uint32_t firstWait = ctx.options.headless ? 1 : 0;
+
+      VkTimelineSemaphoreSubmitInfo timelineInfo = {VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+      timelineInfo.waitSemaphoreValueCount = waitCount - firstWait;
+      timelineInfo.pWaitSemaphoreValues = waitValues + firstWait;
+
+      VkSemaphore renderFinished = ctx.options.headless ? VK_NULL_HANDLE : ctx.renderFinishedSemaphores[imageIndex];
+      VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+      submitInfo.pNext = &timelineInfo;
+      submitInfo.waitSemaphoreCount = waitCount - firstWait;
+      submitInfo.pWaitSemaphores = waitSemaphores + firstWait;
+      submitInfo.pWaitDstStageMask = waitStages + firstWait;
+      submitInfo.commandBufferCount = 1;
+      submitInfo.pCommandBuffers = &commandBuffer;
+      submitInfo.signalSemaphoreCount = ctx.options.headless ? 0 : 1;
+      submitInfo.pSignalSemaphores = &renderFinished;
+
+      VkResult submitResult;
+      {
+          VSDL_ZONE("submit");
+          submitResult = vkQueueSubmit(ctx.graphicsQueue, 1, &submitInfo, frame.inFlightFence);
+      }
+      if (submitResult != VK_SUCCESS) {
+          SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit draw command buffer");
+          running = false;
+          continue;
+      }
+      frame.submittedFrameNumber = ++ctx.frameNumber;
+      lastImageIndex = imageIndex;
+
+      if (!ctx.options.headless) {
+          VSDL_ZONE("present");
+          VkPresentInfoKHR presentInfo = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
+          presentInfo.waitSemaphoreCount = 1;
+          presentInfo.pWaitSemaphores = &renderFinished;
+          presentInfo.swapchainCount = 1;
+          presentInfo.pSwapchains = &ctx.swapchain;
+          presentInfo.pImageIndices = &imageIndex;
+          VkPresentIdKHR presentIdInfo;
+          presentInfo.pNext = frame_pacer_present_id(ctx.pacer, ctx.swapchain, inputTicks, presentIdInfo);
+
+          result = vkQueuePresentKHR(ctx.graphicsQueue, &presentInfo);
+          if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+              SDL_Log("Swapchain out of date after present");
+              swapchainNeedsRecreate = true;
+          } else if (result != VK_SUCCESS) {
+              SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to present queue: %d", result);
+              running = false;
+          }
+      }
+
+      profiler_end_frame(ctx.profiler);
+      frame_pacer_end_frame(ctx.pacer, inputTicks, ctx.profiler.resolved ? ctx.profiler.lastGpuMs : 0.0);
+      ctx.currentFrame = (ctx.currentFrame + 1) % ctx.options.framesInFlight;
+
+      if (ctx.options.benchFrames > 0) {
+          Uint64 presentTicks = SDL_GetPerformanceCounter();
+          if (warmupFrames > 0) {
+              warmupFrames--;
+          } else {
+              frameTimesMs.push_back((presentTicks - lastPresentTicks) * ticksToMs);
+              fenceWaitMs.push_back((fenceWaitEnd - fenceWaitStart) * ticksToMs);
+              recordMs.push_back((recordEnd - recordStart) * ticksToMs);
+              if (frameTimesMs.size() >= ctx.options.benchFrames) {
+                  running = false;
+              }
+          }
+          lastPresentTicks = presentTicks;
+      } else if (ctx.options.headless && ctx.frameNumber >= ctx.options.headlessFrames) {
+          running = false; // No window to close, so a plain headless run stops on its own
+      }
   }
 
   SDL_Log("Render loop ended");
-  vkQueueWaitIdle(ctx.graphicsQueue);
+  vkDeviceWaitIdle(ctx.device);
 
-  for (auto& mesh : ctx.meshes) {
-      vmaDestroyBuffer(ctx.allocator, mesh.vertexBuffer, mesh.vertexAllocation);
-      if (mesh.indexBuffer) {
-          vmaDestroyBuffer(ctx.allocator, mesh.indexBuffer, mesh.indexAllocation);
-      }
+  bool readbackOk = true;
+  if (ctx.options.headless && lastImageIndex != UINT32_MAX) {
+      readbackOk = headless_readback(ctx, lastImageIndex);
   }
-  ctx.meshes.clear();
 
-  vkFreeCommandBuffers(ctx.device, ctx.commandPool, 1, &commandBuffer);
-  if (ctx.frameFence) {
-      SDL_Log("Destroying frame fence");
-      vkDestroyFence(ctx.device, ctx.frameFence, nullptr);
-      ctx.frameFence = VK_NULL_HANDLE;
+  if (ctx.options.benchFrames > 0) {
+      char label[64];
+      SDL_snprintf(label, sizeof(label), "frames-in-flight=%u frame time", ctx.options.framesInFlight);
+      log_frame_time_stats(label, compute_frame_time_stats(frameTimesMs));
+      SDL_snprintf(label, sizeof(label), "frames-in-flight=%u fence wait", ctx.options.framesInFlight);
+      log_frame_time_stats(label, compute_frame_time_stats(fenceWaitMs));
+      SDL_snprintf(label, sizeof(label), "frames-in-flight=%u record", ctx.options.framesInFlight);
+      log_frame_time_stats(label, compute_frame_time_stats(recordMs));
+      if (!gpuFrameMs.empty()) {
+          SDL_snprintf(label, sizeof(label), "frames-in-flight=%u gpu frame", ctx.options.framesInFlight);
+          log_frame_time_stats(label, compute_frame_time_stats(gpuFrameMs));
+      }
+      frame_pacer_log_stats(ctx.pacer, frameTimesMs);
+      if (ctx.profiler.statsPool) {
+          const ProfilerPipelineStats& stats = ctx.profiler.lastStats;
+          SDL_Log("[bench] pipeline stats: ia vertices=%llu vs invocations=%llu clipping primitives=%llu fs invocations=%llu",
+                  (unsigned long long)stats.inputAssemblyVertices, (unsigned long long)stats.vertexShaderInvocations,
+                  (unsigned long long)stats.clippingPrimitives, (unsigned long long)stats.fragmentShaderInvocations);
+      }
+      if (ctx.profiler.droppedFrames > 0) {
+          SDL_Log("[bench] profiler dropped %u frames with unavailable queries", ctx.profiler.droppedFrames);
+      }
+      SDL_Log("[bench] draw mode=%s instances=%zu draw calls/frame=%u (multiDrawIndirect=%d, drawIndirectCount=%d)",
+              ctx.options.indirectDraw ? "indirect" : "direct", ctx.meshes.size(), drawCalls,
+              ctx.features.multiDrawIndirect, ctx.features.drawIndirectCount);
+      SDL_Log("[bench] render graph: %zu passes, %s, %u barriers/frame, transient memory %llu KiB (%llu KiB unaliased)",
+              ctx.renderGraph.passes.size(), ctx.renderGraph.dynamicRendering ? "dynamic rendering" : "render passes",
+              ctx.renderGraph.barrierCount,
+              (unsigned long long)(ctx.renderGraph.memoryBytes / 1024), (unsigned long long)(ctx.renderGraph.unaliasedBytes / 1024));
+      if (ctx.commandCache.pool) {
+          SDL_Log("[bench] command cache: re-recorded=%u reused=%u", ctx.commandCache.records, ctx.commandCache.reuses);
+      }
+      if (ctx.options.benchResizeBurst > 0) {
+          SDL_Log("[bench] resize storm: %u window resizes, %u resize events, %zu swapchain rebuilds",
+                  benchResizeCount, benchResizeEvents, rebuildMs.size());
+          log_frame_time_stats("resize storm rebuild", compute_frame_time_stats(rebuildMs));
+      }
   }
-  if (ctx.renderFinishedSemaphore) {
-      SDL_Log("Destroying render finished semaphore");
-      vkDestroySemaphore(ctx.device, ctx.renderFinishedSemaphore, nullptr);
-      ctx.renderFinishedSemaphore = VK_NULL_HANDLE;
+
+  if (ctx.options.profileTracePath && !profiler_write_trace(ctx.profiler, ctx.options.profileTracePath)) {
+      readbackOk = false;
   }
-  if (ctx.imageAvailableSemaphore) {
-      SDL_Log("Destroying image available semaphore");
-      vkDestroySemaphore(ctx.device, ctx.imageAvailableSemaphore, nullptr);
-      ctx.imageAvailableSemaphore = VK_NULL_HANDLE;
+  if (ctx.options.zoneTracePath && !zone_write_trace(ctx.options.zoneTracePath)) {
+      readbackOk = false;
   }
 
-  return true;
+  ctx.meshes.clear();
+  destroy_mesh_arena(ctx);
+
+  return readbackOk;
 }
\ No newline at end of file
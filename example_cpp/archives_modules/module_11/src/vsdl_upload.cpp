@@ -0,0 +1,242 @@
+// vsdl_upload.cpp
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cstring>
+#include "vsdl_upload.h"
+#include "vsdl_types.h"
+#include "vsdl_zone.h"
+
+// Keeps every staging copy aligned for vertex, index and uniform data
+#define VSDL_STAGING_ALIGNMENT 16
+
+bool upload_manager_create(VSDL_Context& ctx) {
+    UploadManager& up = ctx.upload;
+    up.queueFamilies[0] = ctx.graphicsFamily;
+    up.queueFamilies[1] = ctx.transferFamily;
+
+    VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = VSDL_STAGING_RING_SIZE;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo info = {};
+    if (vmaCreateBuffer(ctx.allocator, &bufferInfo, &allocInfo, &up.stagingBuffer, &up.stagingAllocation, &info) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create staging ring buffer");
+        return false;
+    }
+    up.stagingMapped = static_cast<uint8_t*>(info.pMappedData);
+
+    VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.queueFamilyIndex = ctx.transferFamily;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    if (vkCreateCommandPool(ctx.device, &poolInfo, nullptr, &up.commandPool) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create upload command pool");
+        return false;
+    }
+
+    VkCommandBuffer commandBuffers[VSDL_UPLOAD_BATCHES];
+    VkCommandBufferAllocateInfo cmdInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    cmdInfo.commandPool = up.commandPool;
+    cmdInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdInfo.commandBufferCount = VSDL_UPLOAD_BATCHES;
+    if (vkAllocateCommandBuffers(ctx.device, &cmdInfo, commandBuffers) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate upload command buffers");
+        return false;
+    }
+    for (uint32_t i = 0; i < VSDL_UPLOAD_BATCHES; i++) {
+        up.batches[i].commandBuffer = commandBuffers[i];
+    }
+
+    VkSemaphoreTypeCreateInfo typeInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+    VkSemaphoreCreateInfo semaphoreInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    semaphoreInfo.pNext = &typeInfo;
+    if (vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &up.timeline) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create upload timeline semaphore");
+        return false;
+    }
+
+    SDL_Log("Upload manager created: %u KiB staging ring on queue family %u%s", VSDL_STAGING_RING_SIZE / 1024,
+            ctx.transferFamily, ctx.transferFamily != ctx.graphicsFamily ? " (dedicated transfer)" : "");
+    return true;
+}
+
+void upload_manager_destroy(VSDL_Context& ctx) {
+    UploadManager& up = ctx.upload;
+    if (up.timeline) {
+        vkDestroySemaphore(ctx.device, up.timeline, nullptr);
+    }
+    if (up.commandPool) {
+        vkDestroyCommandPool(ctx.device, up.commandPool, nullptr); // Frees the batch command buffers
+    }
+    if (up.stagingBuffer) {
+        vmaDestroyBuffer(ctx.allocator, up.stagingBuffer, up.stagingAllocation);
+    }
+    up = UploadManager{};
+}
+
+void upload_set_sharing(const VSDL_Context& ctx, VkBufferCreateInfo& info) {
+    if (ctx.transferFamily == ctx.graphicsFamily) {
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        return;
+    }
+    // Concurrent sharing avoids queue family ownership transfers for every upload
+    info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    info.queueFamilyIndexCount = 2;
+    info.pQueueFamilyIndices = ctx.upload.queueFamilies;
+}
+
+uint64_t upload_poll(VSDL_Context& ctx) {
+    UploadManager& up = ctx.upload;
+    vkGetSemaphoreCounterValue(ctx.device, up.timeline, &up.completedValue);
+    for (const auto& batch : up.batches) {
+        if (batch.timelineValue != 0 && batch.timelineValue <= up.completedValue && batch.stagingEnd > up.stagingTail) {
+            up.stagingTail = batch.stagingEnd;
+        }
+    }
+    return up.completedValue;
+}
+
+bool upload_wait(VSDL_Context& ctx, uint64_t value) {
+    UploadManager& up = ctx.upload;
+    if (value <= up.completedValue) {
+        return true;
+    }
+    VkSemaphoreWaitInfo waitInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &up.timeline;
+    waitInfo.pValues = &value;
+    if (vkWaitSemaphores(ctx.device, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to wait for upload timeline value %llu", (unsigned long long)value);
+        return false;
+    }
+    upload_poll(ctx);
+    return true;
+}
+
+// Reserves size bytes of the staging ring, submitting and waiting on older
+// batches when it is full. Allocations never straddle the end of the ring.
+static bool stagingAlloc(VSDL_Context& ctx, VkDeviceSize size, VkDeviceSize* outOffset) {
+    UploadManager& up = ctx.upload;
+    const uint64_t capacity = VSDL_STAGING_RING_SIZE;
+    size = (size + VSDL_STAGING_ALIGNMENT - 1) / VSDL_STAGING_ALIGNMENT * VSDL_STAGING_ALIGNMENT;
+    if (size > capacity) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Upload of %llu bytes exceeds the staging ring (%u bytes)",
+                     (unsigned long long)size, VSDL_STAGING_RING_SIZE);
+        return false;
+    }
+
+    upload_poll(ctx);
+    for (;;) {
+        uint64_t ringOffset = up.stagingHead % capacity;
+        uint64_t padding = ringOffset + size > capacity ? capacity - ringOffset : 0;
+        if (up.stagingHead + padding + size - up.stagingTail <= capacity) {
+            up.stagingHead += padding;
+            *outOffset = up.stagingHead % capacity;
+            up.stagingHead += size;
+            return true;
+        }
+
+        // Ring full: submit what is pending and wait for the oldest batch in flight
+        if (!upload_flush(ctx, nullptr)) {
+            return false;
+        }
+        uint64_t oldest = 0;
+        for (const auto& batch : up.batches) {
+            if (batch.timelineValue > up.completedValue && (oldest == 0 || batch.timelineValue < oldest)) {
+                oldest = batch.timelineValue;
+            }
+        }
+        if (oldest == 0 || !upload_wait(ctx, oldest)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Staging ring exhausted");
+            return false;
+        }
+    }
+}
+
+bool upload_buffer(VSDL_Context& ctx, VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size) {
+    VkDeviceSize stagingOffset;
+    if (!stagingAlloc(ctx, size, &stagingOffset)) {
+        return false;
+    }
+    memcpy(ctx.upload.stagingMapped + stagingOffset, data, size);
+    ctx.upload.pendingBuffers.push_back({dst, {stagingOffset, dstOffset, size}});
+    return true;
+}
+
+bool upload_flush(VSDL_Context& ctx, uint64_t* outValue) {
+    VSDL_ZONE("upload flush");
+    UploadManager& up = ctx.upload;
+    if (up.pendingBuffers.empty()) {
+        if (outValue) {
+            *outValue = up.submittedValue;
+        }
+        return true;
+    }
+
+    // Batches are reused round-robin; the oldest one has usually long finished
+    UploadBatch& batch = up.batches[up.nextBatch];
+    if (!upload_wait(ctx, batch.timelineValue)) {
+        return false;
+    }
+    // No-op on HOST_COHERENT memory
+    vmaFlushAllocation(ctx.allocator, up.stagingAllocation, 0, VK_WHOLE_SIZE);
+
+    VkCommandBuffer cmd = batch.commandBuffer;
+    vkResetCommandBuffer(cmd, 0);
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cmd, &beginInfo);
+
+    // One vkCmdCopyBuffer per destination buffer, carrying all of its regions
+    auto& buffers = up.pendingBuffers;
+    std::stable_sort(buffers.begin(), buffers.end(),
+                     [](const PendingBufferCopy& a, const PendingBufferCopy& b) { return a.dst < b.dst; });
+    std::vector<VkBufferCopy> regions;
+    for (size_t i = 0; i < buffers.size();) {
+        regions.clear();
+        VkBuffer dst = buffers[i].dst;
+        for (; i < buffers.size() && buffers[i].dst == dst; i++) {
+            regions.push_back(buffers[i].region);
+        }
+        vkCmdCopyBuffer(cmd, up.stagingBuffer, dst, (uint32_t)regions.size(), regions.data());
+    }
+
+    vkEndCommandBuffer(cmd);
+
+    uint64_t signalValue = up.submittedValue + 1;
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmd;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &up.timeline;
+    if (vkQueueSubmit(ctx.transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit upload batch");
+        return false;
+    }
+
+    SDL_Log("Upload batch %llu submitted: %zu buffer copies", (unsigned long long)signalValue, buffers.size());
+    up.submittedValue = signalValue;
+    batch.timelineValue = signalValue;
+    batch.stagingEnd = up.stagingHead;
+    up.nextBatch = (up.nextBatch + 1) % VSDL_UPLOAD_BATCHES;
+    buffers.clear();
+    if (outValue) {
+        *outValue = signalValue;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// vsdl_zone.cpp
+#include <SDL3/SDL.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "vsdl_zone.h"
+
+#ifdef VSDL_ENABLE_ZONES
+
+struct ZoneEvent {
+    const char* name;
+    Uint64 startTicks;
+    Uint64 endTicks;
+};
+
+// Written only by its owning thread. Rings outlive their threads so zones
+// from short-lived workers still reach the trace.
+struct ZoneRing {
+    ZoneEvent events[VSDL_ZONE_RING_SIZE];
+    uint64_t head = 0; // Zones recorded so far
+    SDL_ThreadID threadId = 0;
+};
+
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<ZoneRing>> rings;
+static thread_local ZoneRing* threadRing = nullptr;
+
+static ZoneRing* registerThreadRing() {
+    std::unique_ptr<ZoneRing> ring = std::make_unique<ZoneRing>();
+    ring->threadId = SDL_GetCurrentThreadID();
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    rings.push_back(std::move(ring));
+    return rings.back().get();
+}
+
+void zone_record(const char* name, Uint64 startTicks, Uint64 endTicks) {
+    ZoneRing* ring = threadRing;
+    if (!ring) {
+        ring = threadRing = registerThreadRing();
+    }
+    ring->events[ring->head % VSDL_ZONE_RING_SIZE] = {name, startTicks, endTicks};
+    ring->head++;
+}
+
+bool zone_write_trace(const char* path) {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+
+    // Timestamps start at the earliest zone still in any ring
+    Uint64 firstTicks = UINT64_MAX;
+    size_t eventCount = 0;
+    for (const std::unique_ptr<ZoneRing>& ring : rings) {
+        uint64_t count = SDL_min(ring->head, (uint64_t)VSDL_ZONE_RING_SIZE);
+        for (uint64_t i = ring->head - count; i < ring->head; i++) {
+            firstTicks = SDL_min(firstTicks, ring->events[i % VSDL_ZONE_RING_SIZE].startTicks);
+        }
+        eventCount += count;
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", path);
+        return false;
+    }
+    const double ticksToUs = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    char line[256];
+    bool first = true;
+    file << "{\"traceEvents\":[";
+    for (const std::unique_ptr<ZoneRing>& ring : rings) {
+        unsigned long long tid = (unsigned long long)ring->threadId;
+        SDL_snprintf(line, sizeof(line), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,\"args\":{\"name\":\"thread %llu\"}}",
+                     first ? "" : ",", tid, tid);
+        file << line;
+        first = false;
+
+        uint64_t count = SDL_min(ring->head, (uint64_t)VSDL_ZONE_RING_SIZE);
+        for (uint64_t i = ring->head - count; i < ring->head; i++) {
+            const ZoneEvent& event = ring->events[i % VSDL_ZONE_RING_SIZE];
+            // Zone names are string literals, so no JSON escaping
+            SDL_snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.name, tid, (double)(event.startTicks - firstTicks) * ticksToUs,
+                         (double)(event.endTicks - event.startTicks) * ticksToUs);
+            file << line;
+        }
+    }
+    file << "\n]}\n";
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write %s", path);
+        return false;
+    }
+    SDL_Log("Zone trace written to %s (%zu zones from %zu threads)", path, eventCount, rings.size());
+    return true;
+}
+
+#endif
\ No newline at end of file
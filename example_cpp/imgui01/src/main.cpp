@@ -5,9 +5,13 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_vulkan.h"
 #include <stdio.h>
+#include <string.h>
 #include <vector>
 #include <stdexcept>
 
+#define HEADLESS_FRAMES 240              // Frames a headless run renders when --frames is not given
+#define GOLDEN_MAX_DIFF_FRACTION 0.001   // Share of pixels allowed past the tolerance
+
 // Vulkan function loader for ImGui
 static PFN_vkVoidFunction ImGui_ImplVulkan_Loader(const char* function_name, void* user_data) {
     VkInstance instance = static_cast<VkInstance>(user_data);
@@ -18,6 +22,17 @@ static PFN_vkVoidFunction ImGui_ImplVulkan_Loader(const char* function_name, voi
     return func;
 }
 
+// Command line options. --headless runs under SDL's offscreen video driver: it
+// still supplies the window the ImGui SDL3 backend needs and a Vulkan surface
+// through VK_EXT_headless_surface, so no display is required.
+struct Options {
+    bool headless = false;
+    uint32_t frames = 0;                // Non-zero: exit after this many frames (--frames)
+    const char* readbackPath = nullptr; // Write the last frame as a PPM (--readback)
+    const char* goldenPath = nullptr;   // Compare the last frame against this PPM (--golden)
+    uint32_t goldenTolerance = 2;       // Per-channel difference still counted as a match
+};
+
 struct VulkanContext {
     VkInstance instance = VK_NULL_HANDLE;
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
@@ -37,6 +52,9 @@ struct VulkanContext {
     uint32_t graphicsFamily = UINT32_MAX;
     VkFormat swapchainImageFormat;
     VkExtent2D swapchainExtent;
+    VkBuffer readbackBuffer = VK_NULL_HANDLE; // Host-visible copy of the last frame, only with --readback/--golden
+    VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+    uint8_t* readbackMapped = nullptr;
 };
 
 void cleanupVulkan(VulkanContext& ctx, SDL_Window* window) {
@@ -47,6 +65,8 @@ void cleanupVulkan(VulkanContext& ctx, SDL_Window* window) {
     if (ctx.imageAvailableSemaphore) vkDestroySemaphore(ctx.device, ctx.imageAvailableSemaphore, nullptr);
     if (ctx.inFlightFence) vkDestroyFence(ctx.device, ctx.inFlightFence, nullptr);
     if (ctx.commandPool) vkDestroyCommandPool(ctx.device, ctx.commandPool, nullptr);
+    if (ctx.readbackBuffer) vkDestroyBuffer(ctx.device, ctx.readbackBuffer, nullptr);
+    if (ctx.readbackMemory) vkFreeMemory(ctx.device, ctx.readbackMemory, nullptr); // Unmaps implicitly
     
     for (auto framebuffer : ctx.framebuffers) {
         if (framebuffer) vkDestroyFramebuffer(ctx.device, framebuffer, nullptr);
@@ -66,7 +86,18 @@ void cleanupVulkan(VulkanContext& ctx, SDL_Window* window) {
     printf("Vulkan cleanup completed.\n");
 }
 
-void initVulkan(SDL_Window* window, VulkanContext& ctx) {
+static uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    throw std::runtime_error("No suitable memory type");
+}
+
+void initVulkan(SDL_Window* window, VulkanContext& ctx, bool readback) {
     printf("Initializing Vulkan...\n");
 
     // Create Instance
@@ -193,6 +224,17 @@ void initVulkan(SDL_Window* window, VulkanContext& ctx) {
 
     ctx.swapchainImageFormat = surfaceFormat.format;
     ctx.swapchainExtent = capabilities.currentExtent;
+    if (capabilities.currentExtent.width == UINT32_MAX) {
+        // The surface lets the swapchain pick its size, as headless surfaces do
+        int width = 0, height = 0;
+        SDL_GetWindowSizeInPixels(window, &width, &height);
+        ctx.swapchainExtent.width = SDL_clamp((uint32_t)width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        ctx.swapchainExtent.height = SDL_clamp((uint32_t)height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+    if (readback && !(capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)) {
+        printf("Error: Swapchain images cannot be copied for readback\n");
+        throw std::runtime_error("Swapchain does not support readback");
+    }
 
     VkSwapchainCreateInfoKHR swapchainCreateInfo = {};
     swapchainCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -200,9 +242,9 @@ void initVulkan(SDL_Window* window, VulkanContext& ctx) {
     swapchainCreateInfo.minImageCount = capabilities.minImageCount;
     swapchainCreateInfo.imageFormat = surfaceFormat.format;
     swapchainCreateInfo.imageColorSpace = surfaceFormat.colorSpace;
-    swapchainCreateInfo.imageExtent = capabilities.currentExtent;
+    swapchainCreateInfo.imageExtent = ctx.swapchainExtent;
     swapchainCreateInfo.imageArrayLayers = 1;
-    swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (readback ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0);
     swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     swapchainCreateInfo.preTransform = capabilities.currentTransform;
     swapchainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
@@ -343,11 +385,190 @@ void initVulkan(SDL_Window* window, VulkanContext& ctx) {
         throw std::runtime_error("Failed to create synchronization objects");
     }
     printf("Synchronization objects created successfully\n");
+
+    if (readback) {
+        printf("Creating readback buffer...\n");
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = (VkDeviceSize)ctx.swapchainExtent.width * ctx.swapchainExtent.height * 4;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(ctx.device, &bufferInfo, nullptr, &ctx.readbackBuffer) != VK_SUCCESS) {
+            printf("Error: Failed to create readback buffer\n");
+            throw std::runtime_error("Failed to create readback buffer");
+        }
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(ctx.device, ctx.readbackBuffer, &memRequirements);
+        VkMemoryAllocateInfo memInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        memInfo.allocationSize = memRequirements.size;
+        // Coherent so the mapped pointer needs no invalidate after the fence
+        memInfo.memoryTypeIndex = findMemoryType(ctx.physicalDevice, memRequirements.memoryTypeBits,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        void* mapped = nullptr;
+        if (vkAllocateMemory(ctx.device, &memInfo, nullptr, &ctx.readbackMemory) != VK_SUCCESS ||
+            vkBindBufferMemory(ctx.device, ctx.readbackBuffer, ctx.readbackMemory, 0) != VK_SUCCESS ||
+            vkMapMemory(ctx.device, ctx.readbackMemory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+            printf("Error: Failed to allocate readback memory\n");
+            throw std::runtime_error("Failed to allocate readback memory");
+        }
+        ctx.readbackMapped = static_cast<uint8_t*>(mapped);
+        printf("Readback buffer created successfully\n");
+    }
+}
+
+// Copies the frame just rendered into the readback buffer. Recorded into the
+// last frame's command buffer, so the image is read before it is presented.
+static void recordReadback(VulkanContext& ctx, VkImage image) {
+    VkImageMemoryBarrier imageBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = image;
+    imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(ctx.commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {ctx.swapchainExtent.width, ctx.swapchainExtent.height, 1};
+    vkCmdCopyImageToBuffer(ctx.commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, ctx.readbackBuffer, 1, &region);
+
+    // Back to the layout the present expects; the buffer write becomes host-visible at the fence
+    imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.dstAccessMask = 0;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    VkBufferMemoryBarrier bufferBarrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = ctx.readbackBuffer;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(ctx.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &bufferBarrier, 1, &imageBarrier);
+}
+
+// Binary PPM (P6): trivial to write and read back, and viewable everywhere
+static bool writePpm(const char* path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("Error: Failed to open %s for writing\n", path);
+        return false;
+    }
+    fprintf(file, "P6\n%u %u\n255\n", width, height);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    return fclose(file) == 0 && ok;
+}
+
+static bool readPpm(const char* path, std::vector<uint8_t>& rgb, uint32_t& width, uint32_t& height) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[3] = {0};
+    uint32_t maxValue = 0;
+    bool ok = fscanf(file, "%2s %u %u %u", magic, &width, &height, &maxValue) == 4 && strcmp(magic, "P6") == 0 &&
+              maxValue == 255;
+    if (ok) {
+        rgb.resize((size_t)width * height * 3);
+        // Single whitespace byte before the pixel data
+        ok = fgetc(file) != EOF && fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    }
+    fclose(file);
+    return ok;
 }
 
-int main(int, char**) {
+// Converts the read back frame to RGB, writes it and compares it with the golden image
+static bool finishReadback(const VulkanContext& ctx, const Options& options) {
+    uint32_t width = ctx.swapchainExtent.width, height = ctx.swapchainExtent.height;
+    bool bgra = ctx.swapchainImageFormat == VK_FORMAT_B8G8R8A8_SRGB || ctx.swapchainImageFormat == VK_FORMAT_B8G8R8A8_UNORM;
+    bool rgba = ctx.swapchainImageFormat == VK_FORMAT_R8G8B8A8_SRGB || ctx.swapchainImageFormat == VK_FORMAT_R8G8B8A8_UNORM;
+    if (!bgra && !rgba) {
+        printf("Error: Cannot read back swapchain format %d\n", ctx.swapchainImageFormat);
+        return false;
+    }
+    size_t pixelCount = (size_t)width * height;
+    std::vector<uint8_t> rgb(pixelCount * 3);
+    for (size_t i = 0; i < pixelCount; i++) {
+        rgb[i * 3 + 0] = ctx.readbackMapped[i * 4 + (bgra ? 2 : 0)];
+        rgb[i * 3 + 1] = ctx.readbackMapped[i * 4 + 1];
+        rgb[i * 3 + 2] = ctx.readbackMapped[i * 4 + (bgra ? 0 : 2)];
+    }
+
+    bool ok = true;
+    if (options.readbackPath) {
+        if (writePpm(options.readbackPath, rgb, width, height)) {
+            printf("Last frame written to %s\n", options.readbackPath);
+        } else {
+            ok = false;
+        }
+    }
+    if (options.goldenPath) {
+        std::vector<uint8_t> golden;
+        uint32_t goldenWidth = 0, goldenHeight = 0;
+        if (!readPpm(options.goldenPath, golden, goldenWidth, goldenHeight)) {
+            printf("Error: Failed to read golden image %s\n", options.goldenPath);
+            return false;
+        }
+        if (goldenWidth != width || goldenHeight != height) {
+            printf("Error: Golden image is %ux%u, frame is %ux%u\n", goldenWidth, goldenHeight, width, height);
+            return false;
+        }
+        size_t differing = 0;
+        int maxDelta = 0;
+        for (size_t i = 0; i < pixelCount; i++) {
+            int pixelDelta = 0;
+            for (size_t c = 0; c < 3; c++) {
+                pixelDelta = SDL_max(pixelDelta, SDL_abs((int)rgb[i * 3 + c] - (int)golden[i * 3 + c]));
+            }
+            maxDelta = SDL_max(maxDelta, pixelDelta);
+            if (pixelDelta > (int)options.goldenTolerance) {
+                differing++;
+            }
+        }
+        bool match = differing <= (size_t)(pixelCount * GOLDEN_MAX_DIFF_FRACTION);
+        printf("Golden %s: %zu of %zu pixels differ by more than %u (max delta %d)\n",
+               match ? "match" : "MISMATCH", differing, pixelCount, options.goldenTolerance, maxDelta);
+        ok = match && ok;
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
     printf("Starting ImGuiSDL3Vulkan...\n");
 
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (strcmp(argv[i], "--readback") == 0 && hasValue) {
+            options.readbackPath = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && hasValue) {
+            options.goldenPath = argv[++i];
+        } else if (strcmp(argv[i], "--golden-tolerance") == 0 && hasValue) {
+            options.goldenTolerance = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else {
+            printf("Warning: Unknown option %s\n", argv[i]);
+        }
+    }
+    if (options.headless) {
+        // Must be set before SDL_Init picks a video driver
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        if (options.frames == 0) {
+            options.frames = HEADLESS_FRAMES; // Nothing can close the window
+        }
+        printf("Headless: %u frames, readback %s, golden %s\n", options.frames,
+               options.readbackPath ? options.readbackPath : "off", options.goldenPath ? options.goldenPath : "off");
+    }
+    bool readback = options.readbackPath || options.goldenPath;
+
     // SDL Initialization
     printf("Initializing SDL...\n");
     if (!SDL_Init(SDL_INIT_VIDEO)) {
@@ -371,7 +592,7 @@ int main(int, char**) {
     // Vulkan Initialization
     VulkanContext vkCtx;
     try {
-        initVulkan(window, vkCtx);
+        initVulkan(window, vkCtx, readback);
     } catch (const std::runtime_error& e) {
         printf("Vulkan Error: %s\n", e.what());
         cleanupVulkan(vkCtx, window);
@@ -519,6 +740,8 @@ int main(int, char**) {
     // Main loop
     printf("Entering main loop...\n");
     bool done = false;
+    uint32_t frameCount = 0;
+    bool readbackRecorded = false;
     while (!done) {
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -582,14 +805,22 @@ int main(int, char**) {
         vkCmdBeginRenderPass(vkCtx.commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), vkCtx.commandBuffer);
         vkCmdEndRenderPass(vkCtx.commandBuffer);
+        frameCount++;
+        bool lastFrame = options.frames > 0 && frameCount >= options.frames;
+        if (lastFrame && readback) {
+            recordReadback(vkCtx, vkCtx.swapchainImages[imageIndex]);
+            readbackRecorded = true;
+        }
         if (vkEndCommandBuffer(vkCtx.commandBuffer) != VK_SUCCESS) {
             printf("Error: Failed to end command buffer for rendering\n");
             break;
         }
 
         VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         submitInfo.waitSemaphoreCount = 1;
         submitInfo.pWaitSemaphores = &vkCtx.imageAvailableSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &vkCtx.commandBuffer;
         submitInfo.signalSemaphoreCount = 1;
@@ -610,11 +841,19 @@ int main(int, char**) {
             printf("Error: Failed to present - VkResult: %d\n", presentResult);
             break;
         }
+        if (lastFrame) {
+            printf("Rendered %u frames\n", frameCount);
+            done = true;
+        }
     }
 
     // Cleanup
     printf("Shutting down...\n");
     vkDeviceWaitIdle(vkCtx.device);
+    if (readback && !readbackRecorded) {
+        printf("Error: Stopped before the readback frame; --readback and --golden need --frames or --headless\n");
+    }
+    bool readbackOk = readbackRecorded && finishReadback(vkCtx, options);
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
@@ -622,5 +861,5 @@ int main(int, char**) {
     cleanupVulkan(vkCtx, window);
 
     printf("Program exited\n");
-    return 0;
+    return readback && !readbackOk ? 1 : 0;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+// vsdl_headless.h
+#ifndef VSDL_HEADLESS_H
+#define VSDL_HEADLESS_H
+
+#include "vsdl_types.h"
+
+#define VSDL_HEADLESS_FRAMES 240            // Frames a headless run renders when --frames is not given
+#define VSDL_GOLDEN_MAX_DIFF_FRACTION 0.001 // Pixels allowed past goldenTolerance
+
+// Creates the host-visible buffer the last frame is copied into. Needs the
+// swapchain, which must have been created with TRANSFER_SRC usage.
+bool headless_create_readback(VSDL_Context& ctx);
+// Destroys the readback buffer
+void headless_destroy(VSDL_Context& ctx);
+// Records the copy of swapchain image imageIndex into the readback buffer.
+// Call after the render pass of the last frame, before it is presented.
+void headless_record_readback(VSDL_Context& ctx, VkCommandBuffer commandBuffer, uint32_t imageIndex);
+// Writes options.readbackPath and/or compares with options.goldenPath.
+// Call once the device is idle.
+bool headless_finish_readback(VSDL_Context& ctx);
+
+#endif
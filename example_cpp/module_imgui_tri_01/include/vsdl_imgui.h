@@ -10,6 +10,9 @@ namespace vsdl {
     // Process ImGui events and prepare a new frame
     void imgui_new_frame(VSDL_Context& ctx, SDL_Event& event);
 
+    // Profiler window: CPU/GPU frame graphs, GPU scopes, pipeline statistics, trace export
+    void imgui_profiler_window(VSDL_Context& ctx);
+
     // Render ImGui draw data
     void imgui_render(VSDL_Context& ctx, VkCommandBuffer commandBuffer);
 
@@ -0,0 +1,98 @@
+#ifndef VSDL_PROFILER_H
+#define VSDL_PROFILER_H
+
+#include <SDL3/SDL.h>
+#include <vulkan/vulkan.h>
+#include <vector>
+
+#define VSDL_PROFILER_FRAMES 4          // Query sets in the ring; must exceed the frames in flight
+#define VSDL_PROFILER_MAX_SCOPES 32     // Timestamp scopes per frame
+#define VSDL_PROFILER_HISTORY 240       // Frames of CPU/GPU time kept for graphs
+#define VSDL_PROFILER_TRACE_EVENTS 262144 // Chrome trace events kept before recording stops
+
+// Counters of the one VK_QUERY_TYPE_PIPELINE_STATISTICS query per frame
+struct ProfilerPipelineStats {
+    uint64_t inputAssemblyVertices = 0;
+    uint64_t vertexShaderInvocations = 0;
+    uint64_t clippingPrimitives = 0;
+    uint64_t fragmentShaderInvocations = 0;
+};
+
+struct ProfilerScopeResult {
+    const char* name = nullptr; // String literal passed to profiler_begin_scope
+    uint32_t depth = 0;         // Nesting level, 0 for outermost scopes
+    double startMs = 0.0;       // Relative to the frame's first timestamp
+    double durationMs = 0.0;
+};
+
+// Queries written by one frame, read back VSDL_PROFILER_FRAMES frames later
+struct ProfilerFrameSlot {
+    const char* names[VSDL_PROFILER_MAX_SCOPES] = {};
+    uint32_t depths[VSDL_PROFILER_MAX_SCOPES] = {};
+    uint32_t scopeCount = 0;
+    bool pending = false;      // Queries submitted and not yet read back
+    bool statsWritten = false;
+    double cpuStartUs = 0.0;   // CPU time the frame began, anchors GPU events in the trace
+};
+
+struct ProfilerTraceEvent {
+    const char* name;
+    double startUs;
+    double durationUs;
+    uint32_t track; // 0 = CPU, 1 = GPU
+};
+
+// GPU timestamps around passes and draw batches plus a pipeline statistics
+// query per frame, resolved without waiting once the ring wraps back to a slot.
+struct Profiler {
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueryPool timestampPool = VK_NULL_HANDLE; // 2 queries per scope per slot
+    VkQueryPool statsPool = VK_NULL_HANDLE;     // 1 query per slot, null when unsupported
+    double timestampPeriodNs = 1.0;
+    uint64_t timestampMask = ~0ull;             // Valid bits of the graphics queue's timestamps
+    ProfilerFrameSlot slots[VSDL_PROFILER_FRAMES];
+    uint32_t slot = 0;
+    uint32_t depth = 0;
+    Uint64 frameStartTicks = 0;
+    Uint64 firstTicks = 0;
+
+    // Latest resolved frame
+    bool resolved = false; // Set by profiler_begin_frame when it read back a frame
+    double lastGpuMs = 0.0;
+    std::vector<ProfilerScopeResult> lastScopes;
+    ProfilerPipelineStats lastStats;
+    uint32_t droppedFrames = 0; // Slots whose queries were not ready when reused
+
+    // Rolling history for graphs, oldest first starting at historyHead
+    float cpuHistoryMs[VSDL_PROFILER_HISTORY] = {};
+    float gpuHistoryMs[VSDL_PROFILER_HISTORY] = {};
+    uint32_t historyHead = 0;
+    uint32_t gpuHistoryHead = 0;
+
+    bool tracing = false;
+    std::vector<ProfilerTraceEvent> trace;
+};
+
+// Creates the query pools. Pipeline statistics need the pipelineStatisticsQuery
+// device feature; without timestamp support on queueFamily the profiler only
+// tracks CPU time.
+bool profiler_create(Profiler& profiler, VkPhysicalDevice physicalDevice, VkDevice device,
+                                          uint32_t queueFamily, bool pipelineStatistics);
+void profiler_destroy(Profiler& profiler);
+// Call right after vkBeginCommandBuffer: reads back the slot about to be reused
+// (never waits) and resets its queries in commandBuffer.
+void profiler_begin_frame(Profiler& profiler, VkCommandBuffer commandBuffer);
+// Call after the frame is submitted: records CPU frame time and advances the ring.
+void profiler_end_frame(Profiler& profiler);
+// name must outlive the profiler (string literals). Returns the scope to end.
+uint32_t profiler_begin_scope(Profiler& profiler, VkCommandBuffer commandBuffer, const char* name);
+void profiler_end_scope(Profiler& profiler, VkCommandBuffer commandBuffer, uint32_t scope);
+// One pipeline statistics query per frame; begin and end outside or in the same subpass
+void profiler_begin_stats(Profiler& profiler, VkCommandBuffer commandBuffer);
+void profiler_end_stats(Profiler& profiler, VkCommandBuffer commandBuffer);
+// CPU span for the trace, in SDL_GetPerformanceCounter ticks
+void profiler_cpu_event(Profiler& profiler, const char* name, Uint64 startTicks, Uint64 endTicks);
+// Writes the recorded events as Chrome trace JSON (chrome://tracing, Perfetto)
+bool profiler_write_trace(const Profiler& profiler, const char* path);
+
+#endif // VSDL_PROFILER_H
\ No newline at end of file
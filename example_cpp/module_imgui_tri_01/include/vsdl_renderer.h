@@ -3,6 +3,7 @@
 
 #include "vsdl_types.h"
 
-void vsdl_render_loop(VSDL_Context& ctx);
+// Returns false when the last frame's readback or golden compare failed
+bool vsdl_render_loop(VSDL_Context& ctx);
 
 #endif
\ No newline at end of file
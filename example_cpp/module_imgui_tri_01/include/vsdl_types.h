@@ -5,6 +5,7 @@
 #include <SDL3/SDL_vulkan.h>
 #include <vulkan/vulkan.h>
 #include <vector>
+#include "vsdl_profiler.h"
 
 // Define VSDL_ENABLE_VALIDATION_LAYERS based on _DEBUG unless overridden
 #ifndef VSDL_ENABLE_VALIDATION_LAYERS
@@ -15,7 +16,17 @@
 #endif
 #endif
 
+// Runtime options, filled from the command line in main.cpp
+struct VSDL_Options {
+    bool headless = false;              // SDL offscreen video driver, no display needed (--headless)
+    uint32_t frames = 0;                // Non-zero: exit after this many frames (--frames)
+    const char* readbackPath = nullptr; // Write the last frame as a PPM (--readback)
+    const char* goldenPath = nullptr;   // Compare the last frame against this PPM (--golden)
+    uint32_t goldenTolerance = 2;       // Per-channel difference still counted as a match
+};
+
 struct VSDL_Context {
+    VSDL_Options options;
     SDL_Window* window = nullptr;
     VkInstance instance = VK_NULL_HANDLE;
     VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
@@ -40,6 +51,11 @@ struct VSDL_Context {
     VkFence inFlightFence = VK_NULL_HANDLE;
     VkDescriptorPool imguiDescriptorPool = VK_NULL_HANDLE;
     uint32_t graphicsQueueFamilyIndex = 0;
+    bool pipelineStatisticsQuery = false; // Enabled when the device supports it
+    VkBuffer readbackBuffer = VK_NULL_HANDLE; // Host-visible copy of the last frame (--readback, --golden)
+    VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+    uint8_t* readbackMapped = nullptr;
+    Profiler profiler;
 };
 
 #endif // VSDL_TYPES_H
\ No newline at end of file
@@ -2,10 +2,34 @@
 #include "vsdl_pipeline.h"
 #include "vsdl_renderer.h"
 #include "vsdl_cleanup.h"
+#include "vsdl_headless.h"
 #include <SDL3/SDL_log.h>
 
+static void parse_options(int argc, char* argv[], VSDL_Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (SDL_strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (SDL_strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else if (SDL_strcmp(argv[i], "--readback") == 0 && hasValue) {
+            options.readbackPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--golden") == 0 && hasValue) {
+            options.goldenPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--golden-tolerance") == 0 && hasValue) {
+            options.goldenTolerance = (uint32_t)SDL_max(SDL_atoi(argv[++i]), 0);
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unknown option %s", argv[i]);
+        }
+    }
+    if (options.headless && options.frames == 0) {
+        options.frames = VSDL_HEADLESS_FRAMES; // Nothing can close the offscreen window
+    }
+}
+
 int main(int argc, char* argv[]) {
     VSDL_Context ctx = {};
+    parse_options(argc, argv, ctx.options);
 
     // Initialize Vulkan and SDL
     if (!vsdl_init(ctx)) {
@@ -24,8 +48,9 @@ int main(int argc, char* argv[]) {
     }
 
     // Run the render loop
+    bool readbackOk = true;
     try {
-        vsdl_render_loop(ctx);
+        readbackOk = vsdl_render_loop(ctx);
     } catch (const std::exception& e) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render loop failed: %s", e.what());
         vsdl_cleanup(ctx);
@@ -34,5 +59,5 @@ int main(int argc, char* argv[]) {
 
     // Cleanup
     vsdl_cleanup(ctx);
-    return 0;
+    return readbackOk ? 0 : 1;
 }
\ No newline at end of file
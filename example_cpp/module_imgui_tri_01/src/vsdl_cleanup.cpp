@@ -1,5 +1,6 @@
 #include "vsdl_cleanup.h"
 #include "vsdl_imgui.h"
+#include "vsdl_headless.h"
 #include <SDL3/SDL_log.h>
 
 void vsdl_cleanup(VSDL_Context& ctx) {
@@ -7,6 +8,8 @@ void vsdl_cleanup(VSDL_Context& ctx) {
         vkDeviceWaitIdle(ctx.device);
 
         vsdl::shutdown_imgui(ctx);
+        profiler_destroy(ctx.profiler);
+        headless_destroy(ctx);
 
         if (ctx.inFlightFence) vkDestroyFence(ctx.device, ctx.inFlightFence, nullptr);
         if (ctx.renderFinishedSemaphore) vkDestroySemaphore(ctx.device, ctx.renderFinishedSemaphore, nullptr);
@@ -0,0 +1,193 @@
+#include "vsdl_headless.h"
+#include <SDL3/SDL_log.h>
+#include <stdio.h>
+#include <string.h>
+
+static bool find_memory_type(VkPhysicalDevice physicalDevice, uint32_t typeBits, VkMemoryPropertyFlags properties,
+                             uint32_t& typeIndex) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            typeIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool headless_create_readback(VSDL_Context& ctx) {
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = (VkDeviceSize)ctx.swapchainExtent.width * ctx.swapchainExtent.height * 4;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(ctx.device, &bufferInfo, nullptr, &ctx.readbackBuffer) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create readback buffer");
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(ctx.device, ctx.readbackBuffer, &memRequirements);
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    // Coherent so the mapped pointer needs no invalidate once the device is idle
+    if (!find_memory_type(ctx.physicalDevice, memRequirements.memoryTypeBits,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          allocInfo.memoryTypeIndex)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No host-visible memory for the readback buffer");
+        return false;
+    }
+    void* mapped = nullptr;
+    if (vkAllocateMemory(ctx.device, &allocInfo, nullptr, &ctx.readbackMemory) != VK_SUCCESS ||
+        vkBindBufferMemory(ctx.device, ctx.readbackBuffer, ctx.readbackMemory, 0) != VK_SUCCESS ||
+        vkMapMemory(ctx.device, ctx.readbackMemory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate readback memory");
+        return false;
+    }
+    ctx.readbackMapped = static_cast<uint8_t*>(mapped);
+    SDL_Log("Readback buffer created: %ux%u", ctx.swapchainExtent.width, ctx.swapchainExtent.height);
+    return true;
+}
+
+void headless_destroy(VSDL_Context& ctx) {
+    if (ctx.readbackBuffer) vkDestroyBuffer(ctx.device, ctx.readbackBuffer, nullptr);
+    if (ctx.readbackMemory) vkFreeMemory(ctx.device, ctx.readbackMemory, nullptr); // Unmaps implicitly
+    ctx.readbackBuffer = VK_NULL_HANDLE;
+    ctx.readbackMemory = VK_NULL_HANDLE;
+    ctx.readbackMapped = nullptr;
+}
+
+void headless_record_readback(VSDL_Context& ctx, VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+    VkImage image = ctx.swapchainImages[imageIndex];
+    VkImageMemoryBarrier imageBarrier = {};
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; // The render pass's final layout
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = image;
+    imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {ctx.swapchainExtent.width, ctx.swapchainExtent.height, 1};
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, ctx.readbackBuffer, 1, &region);
+
+    // Back to the layout the present expects; the buffer write is made host-visible
+    imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.dstAccessMask = 0;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    VkBufferMemoryBarrier bufferBarrier = {};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = ctx.readbackBuffer;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &bufferBarrier, 1, &imageBarrier);
+}
+
+// Binary PPM (P6): trivial to write and read back, and viewable everywhere
+static bool write_ppm(const char* path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", path);
+        return false;
+    }
+    fprintf(file, "P6\n%u %u\n255\n", width, height);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    return fclose(file) == 0 && ok;
+}
+
+// Reads a P6 PPM with 8-bit channels
+static bool read_ppm(const char* path, std::vector<uint8_t>& rgb, uint32_t& width, uint32_t& height) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[3] = {0};
+    uint32_t maxValue = 0;
+    bool ok = fscanf(file, "%2s %u %u %u", magic, &width, &height, &maxValue) == 4 && strcmp(magic, "P6") == 0 &&
+              maxValue == 255;
+    if (ok) {
+        rgb.resize((size_t)width * height * 3);
+        // Single whitespace byte before the pixel data
+        ok = fgetc(file) != EOF && fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+static bool compare_golden(const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height, const char* goldenPath,
+                           uint32_t tolerance) {
+    std::vector<uint8_t> golden;
+    uint32_t goldenWidth = 0, goldenHeight = 0;
+    if (!read_ppm(goldenPath, golden, goldenWidth, goldenHeight)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to read golden image %s", goldenPath);
+        return false;
+    }
+    if (goldenWidth != width || goldenHeight != height) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Golden image is %ux%u, frame is %ux%u", goldenWidth, goldenHeight,
+                     width, height);
+        return false;
+    }
+
+    size_t pixelCount = (size_t)width * height;
+    size_t differing = 0;
+    int maxDelta = 0;
+    for (size_t i = 0; i < pixelCount; i++) {
+        int pixelDelta = 0;
+        for (size_t c = 0; c < 3; c++) {
+            pixelDelta = SDL_max(pixelDelta, SDL_abs((int)rgb[i * 3 + c] - (int)golden[i * 3 + c]));
+        }
+        maxDelta = SDL_max(maxDelta, pixelDelta);
+        if (pixelDelta > (int)tolerance) {
+            differing++;
+        }
+    }
+    bool match = differing <= (size_t)(pixelCount * VSDL_GOLDEN_MAX_DIFF_FRACTION);
+    SDL_Log("Golden %s: %zu of %zu pixels differ by more than %u (max delta %d)", match ? "match" : "MISMATCH",
+            differing, pixelCount, tolerance, maxDelta);
+    return match;
+}
+
+bool headless_finish_readback(VSDL_Context& ctx) {
+    uint32_t width = ctx.swapchainExtent.width, height = ctx.swapchainExtent.height;
+    // The surface picks the swapchain format, so swizzle for either byte order
+    bool bgra = ctx.swapchainImageFormat == VK_FORMAT_B8G8R8A8_SRGB || ctx.swapchainImageFormat == VK_FORMAT_B8G8R8A8_UNORM;
+    bool rgba = ctx.swapchainImageFormat == VK_FORMAT_R8G8B8A8_SRGB || ctx.swapchainImageFormat == VK_FORMAT_R8G8B8A8_UNORM;
+    if (!bgra && !rgba) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot read back swapchain format %d", ctx.swapchainImageFormat);
+        return false;
+    }
+    size_t pixelCount = (size_t)width * height;
+    std::vector<uint8_t> rgb(pixelCount * 3);
+    for (size_t i = 0; i < pixelCount; i++) {
+        rgb[i * 3 + 0] = ctx.readbackMapped[i * 4 + (bgra ? 2 : 0)];
+        rgb[i * 3 + 1] = ctx.readbackMapped[i * 4 + 1];
+        rgb[i * 3 + 2] = ctx.readbackMapped[i * 4 + (bgra ? 0 : 2)];
+    }
+
+    bool ok = true;
+    if (ctx.options.readbackPath) {
+        if (write_ppm(ctx.options.readbackPath, rgb, width, height)) {
+            SDL_Log("Last frame written to %s", ctx.options.readbackPath);
+        } else {
+            ok = false;
+        }
+    }
+    if (ctx.options.goldenPath) {
+        ok = compare_golden(rgb, width, height, ctx.options.goldenPath, ctx.options.goldenTolerance) && ok;
+    }
+    return ok;
+}
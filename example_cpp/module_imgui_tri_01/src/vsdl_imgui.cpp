@@ -109,6 +109,66 @@ namespace vsdl {
         ImGui_ImplSDL3_ProcessEvent(&event); // Only process events here
     }
 
+    void imgui_profiler_window(VSDL_Context& ctx) {
+        Profiler& profiler = ctx.profiler;
+        ImGui::Begin("Profiler");
+
+        // Histories are rings; plot them oldest first
+        float cpuMs = profiler.cpuHistoryMs[(profiler.historyHead + VSDL_PROFILER_HISTORY - 1) % VSDL_PROFILER_HISTORY];
+        char overlay[32];
+        SDL_snprintf(overlay, sizeof(overlay), "%.2f ms", cpuMs);
+        ImGui::PlotLines("CPU frame", profiler.cpuHistoryMs, VSDL_PROFILER_HISTORY, (int)profiler.historyHead,
+                         overlay, 0.0f, 33.3f, ImVec2(0, 60));
+        SDL_snprintf(overlay, sizeof(overlay), "%.2f ms", profiler.lastGpuMs);
+        ImGui::PlotLines("GPU frame", profiler.gpuHistoryMs, VSDL_PROFILER_HISTORY, (int)profiler.gpuHistoryHead,
+                         overlay, 0.0f, 33.3f, ImVec2(0, 60));
+
+        if (!profiler.timestampPool) {
+            ImGui::Text("GPU timestamps unsupported on this queue");
+        } else if (ImGui::BeginTable("scopes", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("Start ms");
+            ImGui::TableSetupColumn("GPU ms");
+            ImGui::TableHeadersRow();
+            for (const ProfilerScopeResult& scope : profiler.lastScopes) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%*s%s", (int)scope.depth * 2, "", scope.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", scope.startMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", scope.durationMs);
+            }
+            ImGui::EndTable();
+        }
+
+        if (profiler.statsPool) {
+            const ProfilerPipelineStats& stats = profiler.lastStats;
+            ImGui::Text("IA vertices:          %llu", (unsigned long long)stats.inputAssemblyVertices);
+            ImGui::Text("VS invocations:       %llu", (unsigned long long)stats.vertexShaderInvocations);
+            ImGui::Text("Clipping primitives:  %llu", (unsigned long long)stats.clippingPrimitives);
+            ImGui::Text("FS invocations:       %llu", (unsigned long long)stats.fragmentShaderInvocations);
+        } else {
+            ImGui::Text("Pipeline statistics unsupported");
+        }
+        if (profiler.droppedFrames > 0) {
+            ImGui::Text("Dropped frames: %u", profiler.droppedFrames);
+        }
+
+        ImGui::Separator();
+        ImGui::Checkbox("Record trace", &profiler.tracing);
+        ImGui::SameLine();
+        ImGui::Text("%zu events", profiler.trace.size());
+        if (ImGui::Button("Export Chrome trace")) {
+            profiler_write_trace(profiler, "profile_trace.json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+            profiler.trace.clear();
+        }
+        ImGui::End();
+    }
+
     void imgui_render(VSDL_Context& ctx, VkCommandBuffer commandBuffer) {
         ImGui::Render();
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
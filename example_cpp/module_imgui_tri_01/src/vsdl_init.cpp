@@ -1,4 +1,5 @@
 #include "vsdl_init.h"
+#include "vsdl_headless.h"
 #include <SDL3/SDL_log.h>
 #include <stdexcept>
 
@@ -15,6 +16,11 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
 #endif
 
 bool vsdl_init(VSDL_Context& ctx) {
+    if (ctx.options.headless) {
+        // The offscreen driver still creates the window the ImGui SDL3 backend
+        // needs and backs it with VK_EXT_headless_surface. Must precede SDL_Init.
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    }
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init failed: %s", SDL_GetError());
         return false;
@@ -174,7 +180,12 @@ bool vsdl_init(VSDL_Context& ctx) {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    // Pipeline statistics feed the profiler window; optional
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(ctx.physicalDevice, &supportedFeatures);
     VkPhysicalDeviceFeatures deviceFeatures = {};
+    deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+    ctx.pipelineStatisticsQuery = deviceFeatures.pipelineStatisticsQuery == VK_TRUE;
     VkDeviceCreateInfo deviceCreateInfo = {};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
@@ -201,15 +212,29 @@ bool vsdl_init(VSDL_Context& ctx) {
     vkGetPhysicalDeviceSurfaceFormatsKHR(ctx.physicalDevice, ctx.surface, &formatCount, formats.data());
     ctx.swapchainImageFormat = formats[0].format;
 
+    ctx.swapchainExtent = capabilities.currentExtent;
+    if (capabilities.currentExtent.width == UINT32_MAX) {
+        // The surface lets the swapchain pick its size, as headless surfaces do
+        int width = 0, height = 0;
+        SDL_GetWindowSizeInPixels(ctx.window, &width, &height);
+        ctx.swapchainExtent.width = SDL_clamp((uint32_t)width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        ctx.swapchainExtent.height = SDL_clamp((uint32_t)height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+    bool readback = ctx.options.readbackPath || ctx.options.goldenPath;
+    if (readback && !(capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Swapchain images cannot be copied for readback");
+        return false;
+    }
+
     VkSwapchainCreateInfoKHR swapchainInfo = {};
     swapchainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
     swapchainInfo.surface = ctx.surface;
     swapchainInfo.minImageCount = 2;
     swapchainInfo.imageFormat = ctx.swapchainImageFormat;
     swapchainInfo.imageColorSpace = formats[0].colorSpace;
-    swapchainInfo.imageExtent = capabilities.currentExtent;
+    swapchainInfo.imageExtent = ctx.swapchainExtent;
     swapchainInfo.imageArrayLayers = 1;
-    swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (readback ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0);
     swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     swapchainInfo.preTransform = capabilities.currentTransform;
     swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
@@ -221,7 +246,6 @@ bool vsdl_init(VSDL_Context& ctx) {
         return false;
     }
 
-    ctx.swapchainExtent = capabilities.currentExtent;
     uint32_t imageCount;
     vkGetSwapchainImagesKHR(ctx.device, ctx.swapchain, &imageCount, nullptr);
     ctx.swapchainImages.resize(imageCount);
@@ -250,5 +274,9 @@ bool vsdl_init(VSDL_Context& ctx) {
         }
     }
 
+    if (readback && !headless_create_readback(ctx)) {
+        return false;
+    }
+
     return true;
 }
\ No newline at end of file
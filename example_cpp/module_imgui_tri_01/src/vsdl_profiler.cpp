@@ -0,0 +1,232 @@
+#include "vsdl_profiler.h"
+#include <SDL3/SDL_log.h>
+#include <fstream>
+
+static double ticksToMs(Uint64 ticks) {
+    return (double)ticks * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static uint32_t timestampQuery(uint32_t slot, uint32_t scope) {
+    return (slot * VSDL_PROFILER_MAX_SCOPES + scope) * 2;
+}
+
+static void addTraceEvent(Profiler& profiler, const char* name, double startUs, double durationUs, uint32_t track) {
+    if (!profiler.tracing) {
+        return;
+    }
+    if (profiler.trace.size() >= VSDL_PROFILER_TRACE_EVENTS) {
+        SDL_Log("Profiler trace full (%d events), recording stopped", VSDL_PROFILER_TRACE_EVENTS);
+        profiler.tracing = false;
+        return;
+    }
+    profiler.trace.push_back({name, startUs, durationUs, track});
+}
+
+bool profiler_create(Profiler& profiler, VkPhysicalDevice physicalDevice, VkDevice device,
+                     uint32_t queueFamily, bool pipelineStatistics) {
+    profiler.device = device;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    profiler.timestampPeriodNs = properties.limits.timestampPeriod;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+    uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+
+    if (validBits > 0) {
+        profiler.timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+        VkQueryPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = VSDL_PROFILER_FRAMES * VSDL_PROFILER_MAX_SCOPES * 2;
+        if (vkCreateQueryPool(device, &poolInfo, nullptr, &profiler.timestampPool) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create timestamp query pool");
+            return false;
+        }
+    } else {
+        SDL_Log("Queue family %u has no timestamp support, profiling CPU time only", queueFamily);
+    }
+
+    if (pipelineStatistics) {
+        VkQueryPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        poolInfo.queryCount = VSDL_PROFILER_FRAMES;
+        // Results come back in bit order, matching ProfilerPipelineStats
+        poolInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+                                      VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                                      VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                                      VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+        if (vkCreateQueryPool(device, &poolInfo, nullptr, &profiler.statsPool) != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create pipeline statistics query pool");
+            return false;
+        }
+    }
+
+    profiler.firstTicks = SDL_GetPerformanceCounter();
+    profiler.frameStartTicks = profiler.firstTicks;
+    SDL_Log("Profiler created (timestamps %s, period %.3fns, pipeline statistics %s)",
+            profiler.timestampPool ? "on" : "off", profiler.timestampPeriodNs, profiler.statsPool ? "on" : "off");
+    return true;
+}
+
+void profiler_destroy(Profiler& profiler) {
+    if (profiler.timestampPool) {
+        vkDestroyQueryPool(profiler.device, profiler.timestampPool, nullptr);
+    }
+    if (profiler.statsPool) {
+        vkDestroyQueryPool(profiler.device, profiler.statsPool, nullptr);
+    }
+    profiler.timestampPool = VK_NULL_HANDLE;
+    profiler.statsPool = VK_NULL_HANDLE;
+    profiler.trace.clear();
+}
+
+// Reads a slot written VSDL_PROFILER_FRAMES frames ago. Its fence has long
+// signaled, so results are normally available; if not, the frame is dropped
+// rather than waited for.
+static void resolveSlot(Profiler& profiler, uint32_t slotIndex) {
+    ProfilerFrameSlot& slot = profiler.slots[slotIndex];
+
+    if (profiler.timestampPool && slot.scopeCount > 0) {
+        uint64_t results[VSDL_PROFILER_MAX_SCOPES * 2][2]; // Value, availability
+        vkGetQueryPoolResults(profiler.device, profiler.timestampPool, timestampQuery(slotIndex, 0), slot.scopeCount * 2,
+                              sizeof(results), results, sizeof(results[0]),
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        for (uint32_t i = 0; i < slot.scopeCount * 2; i++) {
+            if (results[i][1] == 0) {
+                profiler.droppedFrames++;
+                return;
+            }
+        }
+
+        const double ticksToMsGpu = profiler.timestampPeriodNs / 1000000.0;
+        uint64_t first = results[0][0];
+        profiler.lastScopes.resize(slot.scopeCount);
+        double frameEndMs = 0.0;
+        for (uint32_t i = 0; i < slot.scopeCount; i++) {
+            ProfilerScopeResult& scope = profiler.lastScopes[i];
+            scope.name = slot.names[i];
+            scope.depth = slot.depths[i];
+            scope.startMs = (double)((results[i * 2][0] - first) & profiler.timestampMask) * ticksToMsGpu;
+            scope.durationMs = (double)((results[i * 2 + 1][0] - results[i * 2][0]) & profiler.timestampMask) * ticksToMsGpu;
+            frameEndMs = SDL_max(frameEndMs, scope.startMs + scope.durationMs);
+            // GPU clock is not calibrated against the CPU's; anchor each frame at its CPU start
+            addTraceEvent(profiler, scope.name, slot.cpuStartUs + scope.startMs * 1000.0, scope.durationMs * 1000.0, 1);
+        }
+        profiler.lastGpuMs = frameEndMs;
+        profiler.gpuHistoryMs[profiler.gpuHistoryHead] = (float)frameEndMs;
+        profiler.gpuHistoryHead = (profiler.gpuHistoryHead + 1) % VSDL_PROFILER_HISTORY;
+        profiler.resolved = true;
+    }
+
+    if (profiler.statsPool && slot.statsWritten) {
+        uint64_t stats[5]; // Four counters, then availability
+        vkGetQueryPoolResults(profiler.device, profiler.statsPool, slotIndex, 1, sizeof(stats), stats, sizeof(stats),
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (stats[4] != 0) {
+            profiler.lastStats.inputAssemblyVertices = stats[0];
+            profiler.lastStats.vertexShaderInvocations = stats[1];
+            profiler.lastStats.clippingPrimitives = stats[2];
+            profiler.lastStats.fragmentShaderInvocations = stats[3];
+        }
+    }
+}
+
+void profiler_begin_frame(Profiler& profiler, VkCommandBuffer commandBuffer) {
+    profiler.resolved = false;
+    ProfilerFrameSlot& slot = profiler.slots[profiler.slot];
+    if (slot.pending) {
+        resolveSlot(profiler, profiler.slot);
+    }
+    slot.scopeCount = 0;
+    slot.statsWritten = false;
+    slot.pending = false;
+    slot.cpuStartUs = ticksToMs(SDL_GetPerformanceCounter() - profiler.firstTicks) * 1000.0;
+    profiler.depth = 0;
+
+    // Queries must be reset outside a render pass before they are written again
+    if (profiler.timestampPool) {
+        vkCmdResetQueryPool(commandBuffer, profiler.timestampPool, timestampQuery(profiler.slot, 0), VSDL_PROFILER_MAX_SCOPES * 2);
+    }
+    if (profiler.statsPool) {
+        vkCmdResetQueryPool(commandBuffer, profiler.statsPool, profiler.slot, 1);
+    }
+}
+
+void profiler_end_frame(Profiler& profiler) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    ProfilerFrameSlot& slot = profiler.slots[profiler.slot];
+    slot.pending = slot.scopeCount > 0 || slot.statsWritten;
+
+    double cpuMs = ticksToMs(now - profiler.frameStartTicks);
+    profiler.cpuHistoryMs[profiler.historyHead] = (float)cpuMs;
+    profiler.historyHead = (profiler.historyHead + 1) % VSDL_PROFILER_HISTORY;
+    addTraceEvent(profiler, "frame", ticksToMs(profiler.frameStartTicks - profiler.firstTicks) * 1000.0, cpuMs * 1000.0, 0);
+
+    profiler.frameStartTicks = now;
+    profiler.slot = (profiler.slot + 1) % VSDL_PROFILER_FRAMES;
+}
+
+uint32_t profiler_begin_scope(Profiler& profiler, VkCommandBuffer commandBuffer, const char* name) {
+    ProfilerFrameSlot& slot = profiler.slots[profiler.slot];
+    if (!profiler.timestampPool || slot.scopeCount == VSDL_PROFILER_MAX_SCOPES) {
+        return UINT32_MAX;
+    }
+    uint32_t scope = slot.scopeCount++;
+    slot.names[scope] = name;
+    slot.depths[scope] = profiler.depth++;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, profiler.timestampPool, timestampQuery(profiler.slot, scope));
+    return scope;
+}
+
+void profiler_end_scope(Profiler& profiler, VkCommandBuffer commandBuffer, uint32_t scope) {
+    if (scope == UINT32_MAX) {
+        return;
+    }
+    profiler.depth--;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, profiler.timestampPool, timestampQuery(profiler.slot, scope) + 1);
+}
+
+void profiler_begin_stats(Profiler& profiler, VkCommandBuffer commandBuffer) {
+    if (profiler.statsPool) {
+        vkCmdBeginQuery(commandBuffer, profiler.statsPool, profiler.slot, 0);
+    }
+}
+
+void profiler_end_stats(Profiler& profiler, VkCommandBuffer commandBuffer) {
+    if (profiler.statsPool) {
+        vkCmdEndQuery(commandBuffer, profiler.statsPool, profiler.slot);
+        profiler.slots[profiler.slot].statsWritten = true;
+    }
+}
+
+void profiler_cpu_event(Profiler& profiler, const char* name, Uint64 startTicks, Uint64 endTicks) {
+    addTraceEvent(profiler, name, ticksToMs(startTicks - profiler.firstTicks) * 1000.0, ticksToMs(endTicks - startTicks) * 1000.0, 0);
+}
+
+bool profiler_write_trace(const Profiler& profiler, const char* path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", path);
+        return false;
+    }
+    // Scope names are string literals from the renderer, so no JSON escaping
+    file << "{\"traceEvents\":[\n"
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n"
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+    char line[256];
+    for (const ProfilerTraceEvent& event : profiler.trace) {
+        SDL_snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     event.name, event.track, event.startUs, event.durationUs);
+        file << line;
+    }
+    file << "\n]}\n";
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write %s", path);
+        return false;
+    }
+    SDL_Log("Profiler trace written to %s (%zu events)", path, profiler.trace.size());
+    return true;
+}
\ No newline at end of file
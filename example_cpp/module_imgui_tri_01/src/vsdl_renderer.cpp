@@ -1,12 +1,13 @@
 #include "vsdl_renderer.h"
 #include "vsdl_imgui.h"
+#include "vsdl_headless.h"
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_vulkan.h"
 #include <SDL3/SDL_log.h>
 #include <stdexcept>
 
-void vsdl_render_loop(VSDL_Context& ctx) {
+bool vsdl_render_loop(VSDL_Context& ctx) {
     VkCommandPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     poolInfo.queueFamilyIndex = ctx.graphicsQueueFamilyIndex; // Use the stored index
@@ -42,6 +43,14 @@ void vsdl_render_loop(VSDL_Context& ctx) {
         throw std::runtime_error("Fence creation failed");
     }
 
+    if (!profiler_create(ctx.profiler, ctx.physicalDevice, ctx.device, ctx.graphicsQueueFamilyIndex,
+                         ctx.pipelineStatisticsQuery)) {
+        throw std::runtime_error("Profiler creation failed");
+    }
+
+    bool readback = ctx.readbackBuffer != VK_NULL_HANDLE;
+    bool readbackRecorded = false;
+    uint32_t frameCount = 0;
     bool running = true;
     SDL_Event event;
     while (running) {
@@ -60,9 +69,12 @@ void vsdl_render_loop(VSDL_Context& ctx) {
         ImGui::Begin("Test Window");
         ImGui::Text("Hello, ImGui with Vulkan!");
         ImGui::End();
+        vsdl::imgui_profiler_window(ctx);
 
         // Vulkan rendering
+        Uint64 fenceWaitStart = SDL_GetPerformanceCounter();
         vkWaitForFences(ctx.device, 1, &ctx.inFlightFence, VK_TRUE, UINT64_MAX);
+        profiler_cpu_event(ctx.profiler, "fence wait", fenceWaitStart, SDL_GetPerformanceCounter());
         vkResetFences(ctx.device, 1, &ctx.inFlightFence);
 
         uint32_t imageIndex;
@@ -79,6 +91,9 @@ void vsdl_render_loop(VSDL_Context& ctx) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin command buffer");
             throw std::runtime_error("Command buffer begin failed");
         }
+        profiler_begin_frame(ctx.profiler, ctx.commandBuffer);
+        uint32_t mainPassScope = profiler_begin_scope(ctx.profiler, ctx.commandBuffer, "main pass");
+        profiler_begin_stats(ctx.profiler, ctx.commandBuffer);
 
         VkRenderPassBeginInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -92,9 +107,21 @@ void vsdl_render_loop(VSDL_Context& ctx) {
 
         vkCmdBeginRenderPass(ctx.commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
         vkCmdBindPipeline(ctx.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx.graphicsPipeline);
+        uint32_t triangleScope = profiler_begin_scope(ctx.profiler, ctx.commandBuffer, "triangle");
         vkCmdDraw(ctx.commandBuffer, 3, 1, 0, 0); // Draw triangle
+        profiler_end_scope(ctx.profiler, ctx.commandBuffer, triangleScope);
+        uint32_t imguiScope = profiler_begin_scope(ctx.profiler, ctx.commandBuffer, "imgui");
         vsdl::imgui_render(ctx, ctx.commandBuffer); // Render ImGui
+        profiler_end_scope(ctx.profiler, ctx.commandBuffer, imguiScope);
         vkCmdEndRenderPass(ctx.commandBuffer);
+        profiler_end_stats(ctx.profiler, ctx.commandBuffer);
+        profiler_end_scope(ctx.profiler, ctx.commandBuffer, mainPassScope);
+        frameCount++;
+        bool lastFrame = ctx.options.frames > 0 && frameCount >= ctx.options.frames;
+        if (lastFrame && readback) {
+            headless_record_readback(ctx, ctx.commandBuffer, imageIndex);
+            readbackRecorded = true;
+        }
 
         if (vkEndCommandBuffer(ctx.commandBuffer) != VK_SUCCESS) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to end command buffer");
@@ -128,5 +155,20 @@ void vsdl_render_loop(VSDL_Context& ctx) {
         presentInfo.pImageIndices = &imageIndex;
 
         vkQueuePresentKHR(ctx.presentQueue, &presentInfo);
+        profiler_end_frame(ctx.profiler);
+        if (lastFrame) {
+            SDL_Log("Rendered %u frames", frameCount);
+            running = false;
+        }
+    }
+
+    if (!readback) {
+        return true;
+    }
+    if (!readbackRecorded) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Stopped before the readback frame; --readback and --golden need --frames or --headless");
+        return false;
     }
+    vkDeviceWaitIdle(ctx.device);
+    return headless_finish_readback(ctx);
 }
\ No newline at end of file